@@ -9,11 +9,12 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <cerrno>
+#include <cstring>
 #include <sys/resource.h>  // For setpriority
 #include <unistd.h>         // For access()
 
-#include <nlohmann/json.hpp>
-
 // WebView support (only if GTK headers are available)
 #ifdef WEBVIEW_GTK
 #include "webview/webview.h"
@@ -27,11 +28,12 @@
 #include "gemcore-http-server.h"
 #include "gemcore-asset-loader.h"
 #include "gemcore-cache-buster.h"
+#include "gemcore-config-record.h"          // Binary launcher config
+#include "gemcore-task-graph.h"             // Startup dependency graph
+#include "gemcore-trace.h"                  // GEMCORE_TRACE startup tracing
 #include "gemcore-window-helper.h"          // Cross-platform window management
 #include "gemcore-steamworks-bindings.h"    //  Steamworks integration (cross-platform)
 
-using json = nlohmann::json;
-
 struct GemcoreConfig {
     struct {
         std::string title;
@@ -49,17 +51,21 @@ struct GemcoreConfig {
     struct {
         bool enabled = false;
         uint32_t appId = 0;
+        uint32_t storeStatsDelayMs = 1000;  // StoreStats coalescing window
+        uint32_t leaderboardCacheMs = 10000;  // Downloaded leaderboard pages reused this long
     } steamworks;
     std::string entrypoint;
     std::string appName;  // Used for deterministic port (localStorage persistence)
 };
 
 std::atomic<bool> g_running{true};
-//  OPTIMIZATION: Atomic flag for server ready state
-std::atomic<bool> g_serverReady{false};
+//  OPTIMIZATION: Blocking readiness handshake (no busy wait during startup)
+gemcore::http::ServerReadiness g_serverReady;
 
 // Multi-threaded request handler
 void worker(int server_fd, gemcore::http::HTTPServer* server) {
+    gemcore::trace::setThreadName("http-worker");
+    
     while (g_running) {
         int client = accept(server_fd, nullptr, nullptr);
         if (client >= 0) {
@@ -74,7 +80,13 @@ void worker(int server_fd, gemcore::http::HTTPServer* server) {
 
 // Multi-threaded HTTP server
 void runServer(gemcore::http::HTTPServer* server) {
+    gemcore::trace::Span listenSpan("http.listen");
+    
     int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        g_serverReady.fail(std::string("socket: ") + std::strerror(errno));
+        return;
+    }
     
     // MAXIMUM PERFORMANCE socket options
     int opt = 1;
@@ -94,8 +106,16 @@ void runServer(gemcore::http::HTTPServer* server) {
     addr.sin_addr.s_addr = inet_addr("127.0.0.1");
     addr.sin_port = htons(server->getPort());
     
-    bind(fd, (struct sockaddr*)&addr, sizeof(addr));
-    listen(fd, 512);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        g_serverReady.fail("bind 127.0.0.1:" + std::to_string(server->getPort()) + ": " + std::strerror(errno));
+        close(fd);
+        return;
+    }
+    if (listen(fd, 512) < 0) {
+        g_serverReady.fail(std::string("listen: ") + std::strerror(errno));
+        close(fd);
+        return;
+    }
     
     // Launch worker threads
     int threads = std::thread::hardware_concurrency();
@@ -106,8 +126,11 @@ void runServer(gemcore::http::HTTPServer* server) {
               << server->getPort() << std::endl;
     #endif
     
-    //  OPTIMIZATION: Signal that server is ready BEFORE launching workers
-    g_serverReady = true;
+    listenSpan.end();
+    
+    //  OPTIMIZATION: Signal ready BEFORE launching workers (the socket listens,
+    // early connections wait in the backlog)
+    g_serverReady.ready();
     
     std::vector<std::thread> workers;
     for (int i = 0; i < threads; i++) {
@@ -119,204 +142,58 @@ void runServer(gemcore::http::HTTPServer* server) {
     close(fd);
 }
 
-int main(int argc, char* argv[]) {
-    auto appStart = std::chrono::high_resolution_clock::now();
-    
-    //  OPTIMIZATION: Disable console output in production for faster startup
-    #ifdef NDEBUG
-    std::ios::sync_with_stdio(false);
-    #else
-    std::cout << " Gemcore Launcher (Linux WebKitGTK)" << std::endl;
-    std::cout << "" << std::endl;
-    std::cout << std::endl;
-    #endif
-    
-    // OPTIMIZATION 1: Process Priority (Linux)
-    setpriority(PRIO_PROCESS, 0, -10);
-    #ifndef NDEBUG
-    std::cout << " Process priority: HIGH" << std::endl;
-    #endif
-    
-    // OPTIMIZATION 2: Parallel Asset Loading
-    gemcore::assets::SharedAssetLoader assetLoader;
-    std::atomic<bool> assetsLoaded{false};
-    
-    std::thread assetLoadThread([&assetLoader, &assetsLoaded]() {
-        assetsLoaded = assetLoader.load();
-    });
-    
-    // OPTIMIZATION 3: Prepare default config
-    GemcoreConfig config;
-    config.window.title = "Gemcore App";
-    config.window.width = 1280;
-    config.window.height = 720;
-    config.entrypoint = "index.html";
-    config.appName = "gemcore-app";  // Default app name
-    
-    // Wait for assets to load
-    assetLoadThread.join();
+/**
+ * Load config from encrypted assets (not accessible to user!)
+ *  OPTIMIZATION: Binary config record compiled at build time - no JSON parsing
+ * False if the container has no record (built by an older gemcore): the app
+ * must not start with a default entrypoint and Steam silently disabled
+ */
+static bool loadConfig(const gemcore::assets::SharedAssetLoader& assetLoader, GemcoreConfig& config) {
+    namespace cfg = gemcore::config;
     
-    if (!assetsLoaded) {
-        std::cerr << " Failed to load assets!" << std::endl;
-        return 1;
+    cfg::Record record;
+    if (!assetLoader.getConfigRecord(record)) {
+        std::cerr << " No config record in gemcore-assets - rebuild the assets with this gemcore version" << std::endl;
+        return false;
     }
     
-    //  Load config from encrypted assets (not accessible to user!)
-    auto configAsset = assetLoader.getAsset(".gemcore-config.json");
-    if (configAsset.data && configAsset.size > 0) {
-        try {
-            std::string configStr(reinterpret_cast<const char*>(configAsset.data), configAsset.size);
-            json j = json::parse(configStr);
-            
-            // Load window config
-            if (j.contains("window")) {
-                if (j["window"].contains("title")) {
-                    config.window.title = j["window"]["title"].get<std::string>();
-                }
-                if (j["window"].contains("width")) {
-                    config.window.width = j["window"]["width"].get<int>();
-                }
-                if (j["window"].contains("height")) {
-                    config.window.height = j["window"]["height"].get<int>();
-                }
-            }
-            
-            // Load app config
-            if (j.contains("app")) {
-                if (j["app"].contains("name")) {
-                    config.appName = j["app"]["name"].get<std::string>();
-                    config.app.name = config.appName;
-                    if (config.window.title == "Gemcore App") {
-                        config.window.title = config.appName;
-                    }
-                }
-                if (j["app"].contains("version")) {
-                    config.app.version = j["app"]["version"].get<std::string>();
-                }
-                if (j["app"].contains("entrypoint")) {
-                    config.entrypoint = j["app"]["entrypoint"].get<std::string>();
-                }
-                if (j["app"].contains("debug")) {
-                    config.app.debug = j["app"]["debug"].get<bool>();
-                }
-                if (j["app"].contains("splash")) {
-                    config.app.splash = j["app"]["splash"].get<bool>();
-                }
-                if (j["app"].contains("iconPng")) {
-                    config.app.iconPng = j["app"]["iconPng"].get<std::string>();
-                }
-            }
-            if (j.contains("entrypoint")) {
-                config.entrypoint = j["entrypoint"].get<std::string>();
-            }
-            
-            // Load Steamworks config
-            if (j.contains("steamworks")) {
-                if (j["steamworks"].contains("enabled")) {
-                    config.steamworks.enabled = j["steamworks"]["enabled"].get<bool>();
-                }
-                if (j["steamworks"].contains("appId")) {
-                    config.steamworks.appId = j["steamworks"]["appId"].get<uint32_t>();
-                }
-            }
-            
-            #ifndef NDEBUG
-            std::cout << " Config loaded from encrypted assets" << std::endl;
-            #endif
-        } catch (const std::exception& e) {
-            #ifndef NDEBUG
-            std::cerr << " Failed to parse config: " << e.what() << std::endl;
-            #endif
+    for (cfg::Field field; record.next(field);) {
+        switch (field.id) {
+            case cfg::WINDOW_TITLE:      config.window.title.assign(field.str()); break;
+            case cfg::WINDOW_WIDTH:      config.window.width = field.i32(); break;
+            case cfg::WINDOW_HEIGHT:     config.window.height = field.i32(); break;
+            case cfg::WINDOW_FULLSCREEN: config.window.fullscreen = field.flag(); break;
+            case cfg::APP_NAME:          config.appName.assign(field.str()); config.app.name = config.appName; break;
+            case cfg::APP_VERSION:       config.app.version.assign(field.str()); break;
+            case cfg::APP_ENTRYPOINT:    config.entrypoint.assign(field.str()); break;
+            case cfg::APP_ICON_PNG:      config.app.iconPng.assign(field.str()); break;
+            case cfg::APP_DEBUG:         config.app.debug = field.flag(); break;
+            case cfg::APP_SPLASH:        config.app.splash = field.flag(); break;
+            case cfg::STEAM_ENABLED:     config.steamworks.enabled = field.flag(); break;
+            case cfg::STEAM_APP_ID:      config.steamworks.appId = field.u32(); break;
+            case cfg::STEAM_STORE_STATS_DELAY_MS: config.steamworks.storeStatsDelayMs = field.u32(); break;
+            case cfg::STEAM_LEADERBOARD_CACHE_MS: config.steamworks.leaderboardCacheMs = field.u32(); break;
+            default: break;  // Used by other platforms (or a newer build)
         }
     }
     
-    #ifndef NDEBUG
-    std::cout << " " << config.window.title << std::endl;
-    std::cout << " Entrypoint: " << config.entrypoint << std::endl;
-    std::cout << std::endl;
-    #endif
-    
-    // OPTIMIZATION 4: Parallel Cache Building
-    //  Use deterministic port based on app.name (NOT window.title!)
-    std::hash<std::string> hasher;
-    size_t hash = hasher(config.appName);
-    int port = 8765 + (hash % 1000);  // Port range: 8765-9765
-    
-    #ifndef NDEBUG
-    std::cout << " Port: " << port << " (based on app.name: " << config.appName << ")" << std::endl;
-    #endif
-    gemcore::http::HTTPServer server(port);
-    server.setEntrypoint(config.entrypoint);
-    server.setAssetProvider([&assetLoader](const std::string& path) {
-        return assetLoader.getAsset(path);
-    });
-    
-    std::atomic<bool> cacheReady{false};
-    std::thread cacheThread([&server, &assetLoader, &cacheReady]() {
-        #ifndef NDEBUG
-        auto cacheStart = std::chrono::high_resolution_clock::now();
-        #endif
-        
-        server.buildCache(assetLoader.getAllPaths());
-        
-        #ifndef NDEBUG
-        auto cacheEnd = std::chrono::high_resolution_clock::now();
-        auto cacheDuration = std::chrono::duration_cast<std::chrono::microseconds>(cacheEnd - cacheStart);
-        std::cout << " Pre-cached " << server.getCacheSize() << " responses in " 
-                  << cacheDuration.count() << "s" << std::endl;
-        #endif
-        
-        cacheReady = true;
-    });
-    
-    cacheThread.join();
-    
-    //  Initialize Steamworks (cross-platform helper)
-    #ifdef ENABLE_STEAMWORKS
-    bool steamEnabled = gemcore::steamworks::initSteamworks(config);
-    #else
-    bool steamEnabled = false;
-    #endif
-    
-    //  HIGH-PERFORMANCE MODE: Set high process priority
-    #ifndef NDEBUG
-    std::cout << " Enabling High-Performance Mode..." << std::endl;
-    #endif
-    
-    // Set high priority for better scheduling
-    #ifdef __linux__
-    setpriority(PRIO_PROCESS, 0, -10);  // Higher priority (requires root or CAP_SYS_NICE)
-    #endif
-    
-    // Start HTTP server (runs in background)
-    std::thread serverThread(runServer, &server);
-    serverThread.detach();
-    
-    //  OPTIMIZATION: Wait for server ready flag instead of sleep (faster!)
-    while (!g_serverReady) {
-        std::this_thread::yield();  // Cooperative wait, ~1-5ms instead of 50ms
+    // The app name doubles as the window title
+    if (!config.app.name.empty() && config.window.title == "Gemcore App") {
+        config.window.title = config.appName;
     }
     
-    auto startupEnd = std::chrono::high_resolution_clock::now();
-    auto startupDuration = std::chrono::duration_cast<std::chrono::milliseconds>(startupEnd - appStart);
-    
-    #ifndef NDEBUG
-    std::cout << " STARTUP TIME: " << startupDuration.count() << "ms (all optimizations active)" << std::endl;
-    #endif
-    
-    //  CACHE BUSTER: Use timestamp to force reload on every build
-    std::string cacheBuster = gemcore::getCacheBuster();
-    std::string url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.entrypoint + "?t=" + cacheBuster;
-    
-    #if USE_WEBVIEW
-    // WebView mode (requires WebKitGTK)
     #ifndef NDEBUG
-    std::cout << " Launching WebView..." << std::endl;
-    std::cout << std::endl;
+    std::cout << " Config loaded from encrypted assets" << std::endl;
     #endif
     
-    //  Extract icon from embedded assets BEFORE creating window
-    #ifdef WEBVIEW_GTK
+    return true;
+}
+
+#ifdef WEBVIEW_GTK
+/**
+ * Extract icon from embedded assets (the window icon is set from a file)
+ */
+static std::string extractIcon(const gemcore::assets::SharedAssetLoader& assetLoader, const GemcoreConfig& config) {
     std::string iconPathForWindow;
     auto iconAsset = assetLoader.getAsset("icon.png");
     if (iconAsset.data && iconAsset.size > 0) {
@@ -337,49 +214,16 @@ int main(int argc, char* argv[]) {
             iconPathForWindow = config.app.iconPng;
         }
     }
-    #endif
-    
-    // Create WebView with debug mode from config
-    webview::webview w(config.app.debug, nullptr);
-    w.set_title(config.window.title.c_str());
-    
-    //  Set window icon immediately after window creation (Linux/GTK)
-    #ifdef WEBVIEW_GTK
-    if (!iconPathForWindow.empty()) {
-        auto window_result = w.window();
-        if (window_result.has_value()) {
-            void* window_ptr = window_result.value();
-            if (window_ptr) {
-                GtkWindow* gtk_window = GTK_WINDOW(window_ptr);
-                GError* error = nullptr;
-                gtk_window_set_icon_from_file(gtk_window, iconPathForWindow.c_str(), &error);
-                if (!error) {
-                    // Always log success (even in release mode)
-                    std::cout << " Window icon set: " << iconPathForWindow << std::endl;
-                } else {
-                    // Always log errors (even in release mode)
-                    std::cout << " Failed to set window icon: " << error->message << std::endl;
-                    g_error_free(error);
-                }
-            } else {
-                std::cout << " GTK window pointer is null" << std::endl;
-            }
-        } else {
-            std::cout << " Failed to get GTK window" << std::endl;
-        }
-    } else {
-        std::cout << " No icon path available" << std::endl;
-    }
-    #endif
-    
-    // Apply window config
-    w.set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
-    
-    //  Bind Steamworks to JavaScript (if enabled)
-    #ifdef ENABLE_STEAMWORKS
-    gemcore::steamworks::bindSteamworksToWebview(w, steamEnabled);
-    #endif
-    
+    return iconPathForWindow;
+}
+#endif
+
+#if USE_WEBVIEW
+/**
+ * Build JavaScript init code (window.Gemcore + Steamworks wrapper)
+ */
+static std::string buildJsInit(const gemcore::assets::SharedAssetLoader& assetLoader, bool steamEnabled,
+                               const std::string& apiToken) {
     // Load Steamworks wrapper from assets (if available)
     std::string steamworksWrapperScript;
     #ifdef ENABLE_STEAMWORKS
@@ -389,6 +233,8 @@ int main(int argc, char* argv[]) {
             steamworksWrapperScript = std::string(reinterpret_cast<const char*>(steamworksAsset.data), steamworksAsset.size);
         }
     }
+    #else
+    (void)assetLoader;
     #endif
     
     // Build JavaScript init code
@@ -399,6 +245,7 @@ int main(int argc, char* argv[]) {
         mode: 'shared-assets',
         steam: )JS";
     jsInit += steamEnabled ? "true" : "false";
+    jsInit += ",\n        apiToken: '" + apiToken + "'";
     jsInit += R"JS(
     };
     
@@ -410,44 +257,310 @@ int main(int argc, char* argv[]) {
     jsInit += R"JS(
     )JS";
     
-    w.init(jsInit.c_str());
+    return jsInit;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    auto appStart = std::chrono::high_resolution_clock::now();
+    gemcore::trace::setThreadName("main");
     
-    //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
-    if (config.app.splash) {
-        // Pass target URL as query parameter so splash.html knows where to redirect
-        std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.entrypoint + "&t=" + cacheBuster;
+    //  OPTIMIZATION: Disable console output in production for faster startup
+    #ifdef NDEBUG
+    std::ios::sync_with_stdio(false);
+    #else
+    std::cout << " Gemcore Launcher (Linux WebKitGTK)" << std::endl;
+    std::cout << "" << std::endl;
+    std::cout << std::endl;
+    #endif
+    
+    // OPTIMIZATION 1: Process Priority (Linux)
+    setpriority(PRIO_PROCESS, 0, -10);
+    #ifndef NDEBUG
+    std::cout << " Process priority: HIGH" << std::endl;
+    #endif
+    
+    gemcore::assets::SharedAssetLoader assetLoader;
+    
+    //  --verify: check every asset against its integrity hash and exit
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--verify") == 0) {
+            if (!assetLoader.load()) {
+                std::cerr << " Failed to load assets!" << std::endl;
+                return 1;
+            }
+            return assetLoader.verifyAll() ? 0 : 1;
+        }
+    }
+    
+    // Default config
+    GemcoreConfig config;
+    config.window.title = "Gemcore App";
+    config.window.width = 1280;
+    config.window.height = 720;
+    config.entrypoint = "index.html";
+    config.appName = "gemcore-app";  // Default app name
+    
+    int port = 8765;
+    std::string apiToken = gemcore::http::makeApiToken();  // Guards /__gemcore/ API routes
+    std::unique_ptr<gemcore::http::HTTPServer> server;
+    std::thread serverThread;
+    bool steamEnabled = false;
+    std::string cacheBuster;
+    std::string url;
+    
+    //  HIGH-PERFORMANCE MODE: Set high process priority
+    #ifndef NDEBUG
+    std::cout << " Enabling High-Performance Mode..." << std::endl;
+    #endif
+    
+    // Set high priority for better scheduling
+    #ifdef __linux__
+    setpriority(PRIO_PROCESS, 0, -10);  // Higher priority (requires root or CAP_SYS_NICE)
+    #endif
+    
+    //  OPTIMIZATION 2: Startup task graph
+    // Every boot step is a node with explicit dependencies; independent chains
+    // (cache build -> server start, Steam init -> window, icon extraction) run
+    // concurrently, so time to first navigate is the critical path only.
+    gemcore::startup::TaskGraph graph;
+    
+    auto assetsTask = graph.add("assets", [&]() {
+        if (!assetLoader.load()) {
+            std::cerr << " Failed to load assets!" << std::endl;
+            return false;
+        }
+        return true;
+    });
+    
+    auto configTask = graph.add("config", [&]() {
+        if (!loadConfig(assetLoader, config)) return false;
         
         #ifndef NDEBUG
-        std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
-        std::cout << " Splash URL: " << splashUrl << std::endl;
+        std::cout << " " << config.window.title << std::endl;
+        std::cout << " Entrypoint: " << config.entrypoint << std::endl;
+        std::cout << std::endl;
         #endif
         
-        w.navigate(splashUrl.c_str());
+        //  Use deterministic port based on app.name (NOT window.title!)
+        std::hash<std::string> hasher;
+        size_t hash = hasher(config.appName);
+        port = 8765 + (hash % 1000);  // Port range: 8765-9765
+        
+        //  CACHE BUSTER: Use timestamp to force reload on every build
+        cacheBuster = gemcore::getCacheBuster();
+        url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.entrypoint + "?t=" + cacheBuster;
         
-        // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
-        std::thread([&w, url]() {
-            std::this_thread::sleep_for(std::chrono::seconds(2));
-            w.eval(("window.location.href = '" + url + "';").c_str());
-        }).detach();
-    } else {
         #ifndef NDEBUG
-        std::cout << " URL: " << url << std::endl;
-        std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+        std::cout << " Port: " << port << " (based on app.name: " << config.appName << ")" << std::endl;
         #endif
+        return true;
+    }, { assetsTask });
+    
+    // OPTIMIZATION 3: Cache building (parallel to Steam init and window creation)
+    auto cacheTask = graph.add("cache", [&]() {
+        server.reset(new gemcore::http::HTTPServer(port));
+        server->setEntrypoint(config.entrypoint);
+        server->setAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getAsset(path);
+        });
+        server->setStoredAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getStoredAsset(path);
+        });
+        server->setAssetVerifier([&assetLoader](const std::string& path) {
+            return assetLoader.verifyAsset(path);
+        });
+        server->setApiToken(apiToken);
+        #ifdef ENABLE_STEAMWORKS
+        gemcore::steamworks::registerCloudRoutes(*server);  // Binary Steam Cloud saves
+        gemcore::steamworks::registerInputRoutes(*server);  // Steam Input state long-poll
+        #endif
+        
+        #ifndef NDEBUG
+        auto cacheStart = std::chrono::high_resolution_clock::now();
+        #endif
+        
+        server->buildCache(assetLoader.getAllPaths());
         
-        w.navigate(url.c_str());
+        #ifndef NDEBUG
+        auto cacheEnd = std::chrono::high_resolution_clock::now();
+        auto cacheDuration = std::chrono::duration_cast<std::chrono::microseconds>(cacheEnd - cacheStart);
+        std::cout << " Pre-cached " << server->getCacheSize() << " responses in " 
+                  << cacheDuration.count() << "s" << std::endl;
+        #endif
+        return true;
+    }, { configTask });
+    
+    // Start HTTP server (runs in background)
+    auto serverTask = graph.add("server", [&]() {
+        serverThread = std::thread(runServer, server.get());
+        
+        //  OPTIMIZATION: Sleep until the socket listens (no CPU burned while waiting)
+        std::string error;
+        if (!g_serverReady.wait(&error)) {
+            std::cerr << " HTTP server failed: " << error << std::endl;
+            return false;
+        }
+        return true;
+    }, { cacheTask });
+    
+    //  Initialize Steamworks (must be done BEFORE WebView creation)
+    auto steamTask = graph.add("steam", [&]() {
+        #ifdef ENABLE_STEAMWORKS
+        steamEnabled = gemcore::steamworks::initSteamworks(config);
+        #endif
+        return true;
+    }, { configTask });
+    
+    #if USE_WEBVIEW
+    using Graph = gemcore::startup::TaskGraph;
+    std::unique_ptr<webview::webview> webviewPtr;
+    
+    //  Extract icon from embedded assets (parallel to window creation)
+    std::string iconPathForWindow;
+    auto iconTask = graph.add("icon", [&]() {
+        #ifdef WEBVIEW_GTK
+        iconPathForWindow = extractIcon(assetLoader, config);
+        #endif
+        return true;
+    }, { configTask });
+    
+    // Create WebView with debug mode from config (GTK: main thread only)
+    auto windowTask = graph.add("window", [&]() {
+        #ifndef NDEBUG
+        std::cout << " Launching WebView..." << std::endl;
+        std::cout << std::endl;
+        #endif
+        
+        webviewPtr.reset(new webview::webview(config.app.debug, nullptr));
+        webviewPtr->set_title(config.window.title.c_str());
+        
+        // Apply window config
+        webviewPtr->set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
+        return true;
+    }, { configTask, steamTask }, Graph::MAIN_THREAD);
+    
+    //  Set window icon as soon as both the window and the icon file exist (Linux/GTK)
+    auto windowIconTask = graph.add("window-icon", [&]() {
+        #ifdef WEBVIEW_GTK
+        webview::webview& w = *webviewPtr;
+        if (!iconPathForWindow.empty()) {
+            auto window_result = w.window();
+            if (window_result.has_value()) {
+                void* window_ptr = window_result.value();
+                if (window_ptr) {
+                    GtkWindow* gtk_window = GTK_WINDOW(window_ptr);
+                    GError* error = nullptr;
+                    gtk_window_set_icon_from_file(gtk_window, iconPathForWindow.c_str(), &error);
+                    if (!error) {
+                        // Always log success (even in release mode)
+                        std::cout << " Window icon set: " << iconPathForWindow << std::endl;
+                    } else {
+                        // Always log errors (even in release mode)
+                        std::cout << " Failed to set window icon: " << error->message << std::endl;
+                        g_error_free(error);
+                    }
+                } else {
+                    std::cout << " GTK window pointer is null" << std::endl;
+                }
+            } else {
+                std::cout << " Failed to get GTK window" << std::endl;
+            }
+        } else {
+            std::cout << " No icon path available" << std::endl;
+        }
+        #endif
+        return true;
+    }, { windowTask, iconTask }, Graph::MAIN_THREAD);
+    
+    //  Bind Steamworks to JavaScript (if enabled)
+    auto bindingsTask = graph.add("bindings", [&]() {
+        webview::webview& w = *webviewPtr;
+        
+        #ifdef ENABLE_STEAMWORKS
+        gemcore::steamworks::bindSteamworksToWebview(w, steamEnabled);
+        #endif
+        
+        w.init(buildJsInit(assetLoader, steamEnabled, apiToken).c_str());
+        return true;
+    }, { windowTask, steamTask }, Graph::MAIN_THREAD);
+    
+    graph.add("navigate", [&]() {
+        webview::webview& w = *webviewPtr;
+        
+        //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
+        if (config.app.splash) {
+            // Pass target URL as query parameter so splash.html knows where to redirect
+            std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.entrypoint + "&t=" + cacheBuster;
+            
+            #ifndef NDEBUG
+            std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
+            std::cout << " Splash URL: " << splashUrl << std::endl;
+            #endif
+            
+            w.navigate(splashUrl.c_str());
+            
+            // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
+            std::thread([&w, url]() {
+                std::this_thread::sleep_for(std::chrono::seconds(2));
+                w.eval(("window.location.href = '" + url + "';").c_str());
+            }).detach();
+        } else {
+            #ifndef NDEBUG
+            std::cout << " URL: " << url << std::endl;
+            std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+            #endif
+            
+            w.navigate(url.c_str());
+        }
+        return true;
+    }, { bindingsTask, windowIconTask, serverTask }, Graph::MAIN_THREAD);
+    #else
+    (void)steamEnabled;
+    #endif
+    
+    graph.run();
+    
+    //  GEMCORE_TRACE: write the boot timeline now (the game may never exit cleanly)
+    gemcore::trace::flush();
+    
+    if (!graph.succeeded(assetsTask) || !graph.succeeded(configTask)) {
+        return 1;
+    }
+    
+    if (!graph.succeeded(serverTask)) {
+        if (serverThread.joinable()) serverThread.join();  // runServer() already returned
+        return 1;
     }
     
-    //  Start Steamworks callback thread (if enabled)
+    auto startupEnd = std::chrono::high_resolution_clock::now();
+    auto startupDuration = std::chrono::duration_cast<std::chrono::milliseconds>(startupEnd - appStart);
+    
+    #ifndef NDEBUG
+    std::cout << " STARTUP TIME: " << startupDuration.count() << "ms (all optimizations active)" << std::endl;
+    #else
+    (void)startupDuration;
+    #endif
+    
+    #if USE_WEBVIEW
+    if (!webviewPtr) {
+        return 1;
+    }
+    webview::webview& w = *webviewPtr;
+    
+    // Server threads live until the process exits
+    if (serverThread.joinable()) {
+        serverThread.detach();
+    }
+    
+    //  Pump Steam callbacks on an adaptive interval (GTK: from the main loop, no extra thread)
     #ifdef ENABLE_STEAMWORKS
-    std::thread steamThread;
     if (steamEnabled) {
-        steamThread = std::thread([]() {
-            while (g_running) {
-                gemcore::steamworks::SteamworksManager::RunCallbacks();
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
-            }
-        });
+        #ifdef WEBVIEW_GTK
+        gemcore::steamworks::startGtkCallbackPump();
+        #else
+        gemcore::steamworks::SteamworksManager::StartCallbackPump();
+        #endif
     }
     #endif
     
@@ -459,9 +572,9 @@ int main(int argc, char* argv[]) {
     //  Cleanup Steamworks
     #ifdef ENABLE_STEAMWORKS
     if (steamEnabled) {
-        if (steamThread.joinable()) {
-            steamThread.join();
-        }
+        #ifdef WEBVIEW_GTK
+        gemcore::steamworks::stopGtkCallbackPump();
+        #endif
         gemcore::steamworks::shutdownSteamworks();
     }
     #endif
@@ -504,35 +617,33 @@ int main(int argc, char* argv[]) {
     #endif
     std::cout << " Close browser tab to exit." << std::endl;
     
-    //  Run Steamworks callbacks in background thread (if enabled)
+    //  Pump Steam callbacks on a background thread (adaptive interval, if enabled)
     #ifdef ENABLE_STEAMWORKS
-    std::thread steamThread;
     if (steamEnabled) {
-        steamThread = std::thread([]() {
-            while (g_running) {
-                gemcore::steamworks::SteamworksManager::RunCallbacks();
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
-            }
-        });
+        gemcore::steamworks::SteamworksManager::StartCallbackPump();
     }
     #endif
     
     // Keep server running
-    serverThread.join();
+    if (serverThread.joinable()) {
+        serverThread.join();
+    }
     
     g_running = false;
     
     //  Cleanup Steamworks
     #ifdef ENABLE_STEAMWORKS
     if (steamEnabled) {
-        if (steamThread.joinable()) {
-            steamThread.join();
-        }
         gemcore::steamworks::shutdownSteamworks();
     }
     #endif
     #endif
     
+    //  GEMCORE_RECORD_ACCESS: asset access order for gemcore-pack --profile
+    if (server) server->writeAccessProfile();
+    
+    gemcore::trace::flush();
+    
     return 0;
 }
 
@@ -9,11 +9,13 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <cstdlib>  // For rand(), srand()
+#include <cerrno>
+#include <cstring>  // For strerror()
 #include <ctime>    // For time()
 #include <sys/resource.h>  // For setpriority on macOS/Linux
 
-#include <nlohmann/json.hpp>
 #include "webview/webview.h"
 
 #ifdef __APPLE__
@@ -27,14 +29,15 @@
 #include "gemcore-http-server.h"
 #include "gemcore-asset-loader.h"
 #include "gemcore-cache-buster.h"
+#include "gemcore-config-record.h"          // Binary launcher config
+#include "gemcore-task-graph.h"
+#include "gemcore-trace.h"
 #include "gemcore-window-helper.h"
 
 #ifdef ENABLE_STEAMWORKS
 #include "gemcore-steamworks-bindings.h"    //  Steamworks integration
 #endif
 
-using json = nlohmann::json;
-
 struct GemcoreConfig {
     struct {
         std::string title;
@@ -58,6 +61,8 @@ struct GemcoreConfig {
     struct {
         bool enabled = false;
         uint32_t appId = 0;
+        uint32_t storeStatsDelayMs = 1000;  // StoreStats coalescing window
+        uint32_t leaderboardCacheMs = 10000;  // Downloaded leaderboard pages reused this long
     } steamworks;
 };
 
@@ -65,6 +70,8 @@ std::atomic<bool> g_running{true};
 
 // Multi-threaded request handler
 void worker(int server_fd, gemcore::http::HTTPServer* server) {
+    gemcore::trace::setThreadName("http-worker");
+    
     while (g_running) {
         int client = accept(server_fd, nullptr, nullptr);
         if (client >= 0) {
@@ -77,14 +84,16 @@ void worker(int server_fd, gemcore::http::HTTPServer* server) {
     }
 }
 
-//  OPTIMIZATION: Atomic flag for server ready state
-std::atomic<bool> g_serverReady{false};
+//  OPTIMIZATION: Blocking readiness handshake (no busy wait during startup)
+gemcore::http::ServerReadiness g_serverReady;
 
 // Multi-threaded HTTP server
 void runServer(gemcore::http::HTTPServer* server) {
+    gemcore::trace::Span listenSpan("http.listen");
+    
     int fd = socket(AF_INET, SOCK_STREAM, 0);
     if (fd < 0) {
-        std::cerr << " Failed to create socket!" << std::endl;
+        g_serverReady.fail(std::string("socket: ") + std::strerror(errno));
         return;
     }
     
@@ -107,12 +116,14 @@ void runServer(gemcore::http::HTTPServer* server) {
     addr.sin_port = htons(server->getPort());
     
     if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        std::cerr << " Failed to bind to port " << server->getPort() << "!" << std::endl;
+        g_serverReady.fail("bind 127.0.0.1:" + std::to_string(server->getPort()) + ": " + std::strerror(errno));
+        close(fd);
         return;
     }
     
     if (listen(fd, 512) < 0) {
-        std::cerr << " Failed to listen on port " << server->getPort() << "!" << std::endl;
+        g_serverReady.fail(std::string("listen: ") + std::strerror(errno));
+        close(fd);
         return;
     }
     
@@ -125,8 +136,11 @@ void runServer(gemcore::http::HTTPServer* server) {
               << server->getPort() << std::endl;
     #endif
     
-    //  OPTIMIZATION: Signal that server is ready BEFORE launching workers
-    g_serverReady = true;
+    listenSpan.end();
+    
+    //  OPTIMIZATION: Signal ready BEFORE launching workers (the socket listens,
+    // early connections wait in the backlog)
+    g_serverReady.ready();
     
     std::vector<std::thread> workers;
     for (int i = 0; i < threads; i++) {
@@ -137,279 +151,63 @@ void runServer(gemcore::http::HTTPServer* server) {
     close(fd);
 }
 
-int main(int argc, char* argv[]) {
-    auto appStart = std::chrono::high_resolution_clock::now();
-    
-    // Seed random for port selection
-    srand(time(nullptr));
-    
-    //  OPTIMIZATION: Disable console output in production for faster startup
-    #ifdef NDEBUG
-    std::ios::sync_with_stdio(false);
-    #else
-    std::cout << " Gemcore Launcher (macOS Shared Assets)" << std::endl;
-    std::cout << "" << std::endl;
-    std::cout << std::endl;
-    #endif
-    
-    // OPTIMIZATION 1: Process Priority (macOS)
-    #ifdef __APPLE__
-    // Set high priority for main process
-    setpriority(PRIO_PROCESS, 0, -10);
-    #ifndef NDEBUG
-    std::cout << " Process priority: HIGH" << std::endl;
-    #endif
-    #endif
-    
-    // OPTIMIZATION 2: Load assets + config in parallel
-    gemcore::assets::SharedAssetLoader assetLoader;
-    GemcoreConfig config;
-    std::atomic<bool> assetsLoaded{false};
-    
-    std::thread assetLoadThread([&assetLoader, &assetsLoaded]() {
-        assetsLoaded = assetLoader.load();
-    });
-    
-    // While assets load, prepare default config
-    config.window.title = "Gemcore App";
-    config.window.width = 1280;
-    config.window.height = 720;
-    config.window.resizable = true;
-    config.window.fullscreen = false;
-    config.window.alwaysOnTop = false;
-    config.window.frameless = false;
-    config.window.minWidth = 400;
-    config.window.minHeight = 300;
-    config.app.name = "gemcore-app";
-    config.app.version = "1.0.0";
-    config.app.entrypoint = "index.html";
-    config.app.icon = "";
+/**
+ * Load config from encrypted assets (not accessible to user!)
+ *  OPTIMIZATION: Binary config record compiled at build time - no JSON parsing
+ * False if the container has no record (built by an older gemcore): the app
+ * must not start with a default entrypoint and Steam silently disabled
+ */
+static bool loadConfig(const gemcore::assets::SharedAssetLoader& assetLoader, GemcoreConfig& config) {
+    namespace cfg = gemcore::config;
     
-    // Wait for assets to load first
-    assetLoadThread.join();
-    if (!assetsLoaded) {
-        std::cerr << " Failed to load shared assets!" << std::endl;
-        return 1;
+    cfg::Record record;
+    if (!assetLoader.getConfigRecord(record)) {
+        std::cerr << " No config record in gemcore-assets - rebuild the assets with this gemcore version" << std::endl;
+        return false;
     }
     
-    //  Load config from encrypted assets (not accessible to user!)
-    auto configAsset = assetLoader.getAsset(".gemcore-config.json");
-    if (configAsset.data && configAsset.size > 0) {
-        try {
-            std::string configStr(reinterpret_cast<const char*>(configAsset.data), configAsset.size);
-            json j = json::parse(configStr);
-            
-            // Load window config
-            if (j.contains("window")) {
-                if (j["window"].contains("title")) config.window.title = j["window"]["title"].get<std::string>();
-                if (j["window"].contains("width")) config.window.width = j["window"]["width"].get<int>();
-                if (j["window"].contains("height")) config.window.height = j["window"]["height"].get<int>();
-                if (j["window"].contains("resizable")) config.window.resizable = j["window"]["resizable"].get<bool>();
-                if (j["window"].contains("fullscreen")) config.window.fullscreen = j["window"]["fullscreen"].get<bool>();
-                if (j["window"].contains("startFullscreen")) config.window.fullscreen = j["window"]["startFullscreen"].get<bool>();
-                if (j["window"].contains("alwaysOnTop")) config.window.alwaysOnTop = j["window"]["alwaysOnTop"].get<bool>();
-                if (j["window"].contains("frameless")) config.window.frameless = j["window"]["frameless"].get<bool>();
-                if (j["window"].contains("minWidth")) config.window.minWidth = j["window"]["minWidth"].get<int>();
-                if (j["window"].contains("minHeight")) config.window.minHeight = j["window"]["minHeight"].get<int>();
-            }
-            
-            // Load app config
-            if (j.contains("app")) {
-                if (j["app"].contains("name")) {
-                    config.app.name = j["app"]["name"].get<std::string>();
-                    if (config.window.title == "Gemcore App") {
-                        config.window.title = config.app.name;
-                    }
-                }
-                if (j["app"].contains("version")) config.app.version = j["app"]["version"].get<std::string>();
-                if (j["app"].contains("entrypoint")) config.app.entrypoint = j["app"]["entrypoint"].get<std::string>();
-                if (j["app"].contains("icon")) config.app.icon = j["app"]["icon"].get<std::string>();
-                if (j["app"].contains("debug")) config.app.debug = j["app"]["debug"].get<bool>();
-                if (j["app"].contains("splash")) config.app.splash = j["app"]["splash"].get<bool>();
-            }
-            
-            // Legacy: Load entrypoint from root (support both formats)
-            if (j.contains("entrypoint")) {
-                config.app.entrypoint = j["entrypoint"].get<std::string>();
-            }
-            
-            //  Load Steamworks config
-            if (j.contains("steamworks")) {
-                if (j["steamworks"].contains("enabled")) {
-                    config.steamworks.enabled = j["steamworks"]["enabled"].get<bool>();
-                }
-                if (j["steamworks"].contains("appId")) {
-                    config.steamworks.appId = j["steamworks"]["appId"].get<uint32_t>();
-                }
-            }
-            
-            #ifndef NDEBUG
-            std::cout << " Config loaded from encrypted assets" << std::endl;
-            #endif
-        } catch (const std::exception& e) {
-            #ifndef NDEBUG
-            std::cerr << " Failed to parse config: " << e.what() << std::endl;
-            #endif
+    for (cfg::Field field; record.next(field);) {
+        switch (field.id) {
+            case cfg::WINDOW_TITLE:         config.window.title.assign(field.str()); break;
+            case cfg::WINDOW_WIDTH:         config.window.width = field.i32(); break;
+            case cfg::WINDOW_HEIGHT:        config.window.height = field.i32(); break;
+            case cfg::WINDOW_RESIZABLE:     config.window.resizable = field.flag(); break;
+            case cfg::WINDOW_FULLSCREEN:    config.window.fullscreen = field.flag(); break;
+            case cfg::WINDOW_ALWAYS_ON_TOP: config.window.alwaysOnTop = field.flag(); break;
+            case cfg::WINDOW_FRAMELESS:     config.window.frameless = field.flag(); break;
+            case cfg::WINDOW_MIN_WIDTH:     config.window.minWidth = field.i32(); break;
+            case cfg::WINDOW_MIN_HEIGHT:    config.window.minHeight = field.i32(); break;
+            case cfg::APP_NAME:             config.app.name.assign(field.str()); break;
+            case cfg::APP_VERSION:          config.app.version.assign(field.str()); break;
+            case cfg::APP_ENTRYPOINT:       config.app.entrypoint.assign(field.str()); break;
+            case cfg::APP_ICON:             config.app.icon.assign(field.str()); break;
+            case cfg::APP_DEBUG:            config.app.debug = field.flag(); break;
+            case cfg::APP_SPLASH:           config.app.splash = field.flag(); break;
+            case cfg::STEAM_ENABLED:        config.steamworks.enabled = field.flag(); break;
+            case cfg::STEAM_APP_ID:         config.steamworks.appId = field.u32(); break;
+            case cfg::STEAM_STORE_STATS_DELAY_MS: config.steamworks.storeStatsDelayMs = field.u32(); break;
+            case cfg::STEAM_LEADERBOARD_CACHE_MS: config.steamworks.leaderboardCacheMs = field.u32(); break;
+            default: break;  // Used by other platforms (or a newer build)
         }
     }
     
-    #ifndef NDEBUG
-    std::cout << " " << config.window.title << std::endl;
-    std::cout << " Entrypoint: " << config.app.entrypoint << std::endl;
-    std::cout << " Window: " << config.window.width << "x" << config.window.height 
-              << (config.window.resizable ? " (resizable)" : " (fixed)") << std::endl;
-    if (config.window.fullscreen) std::cout << "  Fullscreen: ON" << std::endl;
-    if (config.window.alwaysOnTop) std::cout << " Always on Top: ON" << std::endl;
-    if (config.window.frameless) std::cout << "  Frameless: ON" << std::endl;
-    if (config.steamworks.enabled) {
-        std::cout << " Steamworks: ENABLED (App ID: " << config.steamworks.appId << ")" << std::endl;
+    // The app name doubles as the window title
+    if (!config.app.name.empty() && config.window.title == "Gemcore App") {
+        config.window.title = config.app.name;
     }
-    std::cout << std::endl;
-    #endif
-    
-    //  Initialize Steamworks (must be done BEFORE WebView creation)
-    #ifdef ENABLE_STEAMWORKS
-    bool steamEnabled = gemcore::steamworks::initSteamworks(config);
-    #else
-    bool steamEnabled = false;
-    #endif
-    
-    // OPTIMIZATION 3: Setup server + Build cache in PARALLEL with WebView creation
-    //  Use deterministic port based on app.name (NOT window.title!)
-    // This ensures localStorage persists even if window title changes (e.g., version numbers)
-    std::hash<std::string> hasher;
-    size_t hash = hasher(config.app.name);
-    int port = 8765 + (hash % 1000);  // Port range: 8765-9765
-    
-    #ifndef NDEBUG
-    std::cout << " Port: " << port << " (based on app.name: " << config.app.name << ")" << std::endl;
-    std::cout << " Version: " << config.app.version << std::endl;
-    #endif
-    gemcore::http::HTTPServer server(port);
-    server.setEntrypoint(config.app.entrypoint);
-    server.setAssetProvider([&assetLoader](const std::string& path) {
-        return assetLoader.getAsset(path);
-    });
-    
-    std::atomic<bool> cacheReady{false};
-    std::thread cacheThread([&server, &assetLoader, &cacheReady]() {
-        #ifndef NDEBUG
-    auto start = std::chrono::high_resolution_clock::now();
-        #endif
-        
-    server.buildCache(assetLoader.getAllPaths());
-        
-        #ifndef NDEBUG
-    auto end = std::chrono::high_resolution_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    std::cout << " Pre-cached " << server.getCacheSize() << " responses in " << ms << "�s" << std::endl;
-        std::cout << "   � Critical assets (entrypoint, main.js) cached FIRST" << std::endl;
-        #endif
-        
-        cacheReady = true;
-    });
     
-    // Create WebView while cache builds (parallel!)
-    // true = debug mode (enables Inspector for development)
-    //  HIGH-PERFORMANCE MODE: Eliminate micro-stuttering
     #ifndef NDEBUG
-    std::cout << " Enabling High-Performance Mode..." << std::endl;
-    #endif
-    
-    #ifdef __APPLE__
-    // 1. REALTIME priority for smooth frame pacing
-    setpriority(PRIO_PROCESS, 0, -20);  // Maximum priority
-    
-    // 2. Disable App Nap via system command
-    system("defaults write NSGlobalDomain NSAppSleepDisabled -bool YES 2>/dev/null");
-    
-    // 3.  Request Game Mode optimizations (macOS Sonoma 14+)
-    // Game Mode gives highest priority to CPU/GPU when in fullscreen
-    // Reference: https://support.apple.com/en-us/105118
-    // Note: Full Game Mode only activates in native fullscreen, but we can
-    //       request latency-critical treatment for better performance
-    setenv("CA_LAYER_OPTIMIZE_FOR_GAME", "1", 1);  // Optimize Core Animation
-    setenv("MTL_SHADER_VALIDATION", "0", 1);  // Disable shader validation overhead
-    
-    // 4. Metal optimizations
-    setenv("MTL_HUD_ENABLED", "0", 1);  // Disable Metal HUD
-    setenv("MTL_DEBUG_LAYER", "0", 1);  // Disable debug layer
-    
-    // 5. Force Metal rendering for better performance
-    setenv("WEBKIT_USE_METAL", "1", 1);
-    setenv("WEBKIT_DISABLE_COMPOSITING_MODE", "0", 1);
-    
-    // 6. Request high-performance GPU (discrete over integrated)
-    setenv("WEBKIT_FORCE_DISCRETE_GPU", "1", 1);
-    
-    #ifndef NDEBUG
-    std::cout << "    Process priority: REALTIME (-20)" << std::endl;
-    std::cout << "    App Nap: Disabled" << std::endl;
-    std::cout << "    Game Mode: Requested (macOS Sonoma 14+)" << std::endl;
-    std::cout << "    Metal rendering: Forced" << std::endl;
-    std::cout << "    Discrete GPU: Requested" << std::endl;
-    std::cout << "     Note: Fullscreen will ALWAYS be faster (bypasses WindowServer)" << std::endl;
-    #endif
-    #endif
-    
-    // Create WebView with debug mode from config (or default to true for compatibility)
-    webview::webview w(config.app.debug, nullptr);
-    w.set_title(config.window.title.c_str());
-    
-    // Apply window config
-    w.set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
-    
-    //  Enable native macOS Game Mode support
-    // This adds the fullscreen button and enables Game Mode in fullscreen
-    #ifdef __APPLE__
-    auto window_result = w.window();
-    if (window_result.has_value()) {
-        void* window_ptr = window_result.value();
-        if (window_ptr) {
-            id nswindow = (id)window_ptr;
-            
-            // Enable fullscreen button (green button) - required for Game Mode
-            // NSWindowCollectionBehaviorFullScreenPrimary = 1 << 7 = 128 (main display)
-            // NSWindowCollectionBehaviorFullScreenAuxiliary = 1 << 8 = 256 (external displays)
-            // Combine both for multi-display support (like Godot!)
-            SEL setCollectionBehavior = sel_registerName("setCollectionBehavior:");
-            NSUInteger behavior = 128 | 256;  // Primary + Auxiliary (works on all displays!)
-            ((void (*)(id, SEL, NSUInteger))objc_msgSend)(nswindow, setCollectionBehavior, behavior);
-            
-            #ifndef NDEBUG
-            std::cout << " Native fullscreen button enabled (Game Mode ready)" << std::endl;
-            std::cout << "    Supports primary display (FullScreenPrimary)" << std::endl;
-            std::cout << "    Supports external displays (FullScreenAuxiliary)" << std::endl;
-            #endif
-        }
-    }
-    #endif
-    
-    //  Fullscreen mode for maximum performance (bypasses compositor)
-    if (config.window.fullscreen) {
-        #ifndef NDEBUG
-        std::cout << "  Fullscreen mode: ENABLED (better performance)" << std::endl;
-        #endif
-        
-        // Use native macOS fullscreen (from helper)
-        auto window_result = w.window();
-        if (window_result.has_value()) {
-            gemcore::window::toggleFullscreen(window_result.value());
-            
-            #ifndef NDEBUG
-            std::cout << " Native fullscreen activated" << std::endl;
-            #endif
-        }
-    }
-    
-    // DISABLED: Performance optimizations causing issues with some games
-    // gemcore::universal::enableUniversalPerformance(w);
-    
-    //  Bind Steamworks to JavaScript (if enabled)
-    #ifdef ENABLE_STEAMWORKS
-    gemcore::steamworks::bindSteamworksToWebview(w, steamEnabled);
+    std::cout << " Config loaded from encrypted assets" << std::endl;
     #endif
     
+    return true;
+}
+
+/**
+ * Build JavaScript init code (window.Gemcore + Steamworks wrapper + runtime optimizations)
+ */
+static std::string buildJsInit(const gemcore::assets::SharedAssetLoader& assetLoader, bool steamEnabled,
+                               const std::string& apiToken) {
     // Load Steamworks wrapper from assets (if available)
     std::string steamworksWrapperScript;
     #ifdef ENABLE_STEAMWORKS
@@ -419,6 +217,8 @@ int main(int argc, char* argv[]) {
             steamworksWrapperScript = std::string(reinterpret_cast<const char*>(steamworksAsset.data), steamworksAsset.size);
         }
     }
+    #else
+    (void)assetLoader;
     #endif
     
     // Build JavaScript init code with fullscreen value
@@ -429,6 +229,7 @@ int main(int argc, char* argv[]) {
         mode: 'shared-assets',
         steam: )JS";
     jsInit += steamEnabled ? "true" : "false";
+    jsInit += ",\n        apiToken: '" + apiToken + "'";
     jsInit += R"JS(
     };
     
@@ -573,69 +374,353 @@ int main(int argc, char* argv[]) {
     }
     )JS";
     
-    w.init(jsInit.c_str());
+    return jsInit;
+}
+
+int main(int argc, char* argv[]) {
+    auto appStart = std::chrono::high_resolution_clock::now();
+    gemcore::trace::setThreadName("main");
+    
+    // Seed random for port selection
+    srand(time(nullptr));
     
-    // Wait for cache to be ready before navigation
-    cacheThread.join();
+    //  OPTIMIZATION: Disable console output in production for faster startup
+    #ifdef NDEBUG
+    std::ios::sync_with_stdio(false);
+    #else
+    std::cout << " Gemcore Launcher (macOS Shared Assets)" << std::endl;
+    std::cout << "" << std::endl;
+    std::cout << std::endl;
+    #endif
     
-    // OPTIMIZATION 4: Start HTTP server BEFORE navigation (faster first request)
-    std::thread serverThread(runServer, &server);
-    serverThread.detach();
+    // OPTIMIZATION 1: Process Priority (macOS)
+    #ifdef __APPLE__
+    // Set high priority for main process
+    setpriority(PRIO_PROCESS, 0, -10);
+    #ifndef NDEBUG
+    std::cout << " Process priority: HIGH" << std::endl;
+    #endif
+    #endif
+    
+    gemcore::assets::SharedAssetLoader assetLoader;
     
-    //  OPTIMIZATION: Wait for server ready flag instead of sleep (faster!)
-    while (!g_serverReady) {
-        std::this_thread::yield();  // Cooperative wait, ~1-5ms instead of 50ms
+    //  --verify: check every asset against its integrity hash and exit
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--verify") == 0) {
+            if (!assetLoader.load()) {
+                std::cerr << " Failed to load shared assets!" << std::endl;
+                return 1;
+            }
+            return assetLoader.verifyAll() ? 0 : 1;
+        }
     }
     
-    auto appReady = std::chrono::high_resolution_clock::now();
-    auto startupMs = std::chrono::duration_cast<std::chrono::milliseconds>(appReady - appStart).count();
+    // Default config
+    GemcoreConfig config;
+    config.window.title = "Gemcore App";
+    config.window.width = 1280;
+    config.window.height = 720;
+    config.window.resizable = true;
+    config.window.fullscreen = false;
+    config.window.alwaysOnTop = false;
+    config.window.frameless = false;
+    config.window.minWidth = 400;
+    config.window.minHeight = 300;
+    config.app.name = "gemcore-app";
+    config.app.version = "1.0.0";
+    config.app.entrypoint = "index.html";
+    config.app.icon = "";
+    
+    int port = 8765;
+    std::string apiToken = gemcore::http::makeApiToken();  // Guards /__gemcore/ API routes
+    std::unique_ptr<gemcore::http::HTTPServer> server;
+    std::unique_ptr<webview::webview> webviewPtr;
+    bool steamEnabled = false;
+    std::string cacheBuster;
+    std::string url;
     
+    //  HIGH-PERFORMANCE MODE: Eliminate micro-stuttering
     #ifndef NDEBUG
-    std::cout << " STARTUP TIME: " << startupMs << "ms (all optimizations active)" << std::endl;
-    std::cout << " Launching WebView..." << std::endl;
-    std::cout << std::endl;
+    std::cout << " Enabling High-Performance Mode..." << std::endl;
+    #endif
+    
+    #ifdef __APPLE__
+    // 1. REALTIME priority for smooth frame pacing
+    setpriority(PRIO_PROCESS, 0, -20);  // Maximum priority
+    
+    // 2. Disable App Nap: see the "app-nap" task below (spawns a process, so it
+    //    runs in parallel with asset loading)
+    
+    // 3.  Request Game Mode optimizations (macOS Sonoma 14+)
+    // Game Mode gives highest priority to CPU/GPU when in fullscreen
+    // Reference: https://support.apple.com/en-us/105118
+    // Note: Full Game Mode only activates in native fullscreen, but we can
+    //       request latency-critical treatment for better performance
+    setenv("CA_LAYER_OPTIMIZE_FOR_GAME", "1", 1);  // Optimize Core Animation
+    setenv("MTL_SHADER_VALIDATION", "0", 1);  // Disable shader validation overhead
+    
+    // 4. Metal optimizations
+    setenv("MTL_HUD_ENABLED", "0", 1);  // Disable Metal HUD
+    setenv("MTL_DEBUG_LAYER", "0", 1);  // Disable debug layer
+    
+    // 5. Force Metal rendering for better performance
+    setenv("WEBKIT_USE_METAL", "1", 1);
+    setenv("WEBKIT_DISABLE_COMPOSITING_MODE", "0", 1);
+    
+    // 6. Request high-performance GPU (discrete over integrated)
+    setenv("WEBKIT_FORCE_DISCRETE_GPU", "1", 1);
+    
+    #ifndef NDEBUG
+    std::cout << "    Process priority: REALTIME (-20)" << std::endl;
+    std::cout << "    App Nap: Disabled" << std::endl;
+    std::cout << "    Game Mode: Requested (macOS Sonoma 14+)" << std::endl;
+    std::cout << "    Metal rendering: Forced" << std::endl;
+    std::cout << "    Discrete GPU: Requested" << std::endl;
+    std::cout << "     Note: Fullscreen will ALWAYS be faster (bypasses WindowServer)" << std::endl;
     #endif
+    #endif
+    
+    //  OPTIMIZATION 2: Startup task graph
+    // Every boot step is a node with explicit dependencies; independent chains
+    // (cache build -> server start, Steam init -> window) run concurrently, so
+    // time to first navigate is the critical path only.
+    using Graph = gemcore::startup::TaskGraph;
+    Graph graph;
+    
+    auto assetsTask = graph.add("assets", [&]() {
+        if (!assetLoader.load()) {
+            std::cerr << " Failed to load shared assets!" << std::endl;
+            return false;
+        }
+        return true;
+    });
     
-    //  CACHE BUSTER: Use timestamp to force reload on every build
-    std::string cacheBuster = gemcore::getCacheBuster();
-    std::string url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.app.entrypoint + "?t=" + cacheBuster;
+    #ifdef __APPLE__
+    graph.add("app-nap", []() {
+        int result = system("defaults write NSGlobalDomain NSAppSleepDisabled -bool YES 2>/dev/null");
+        (void)result;
+        return true;
+    });
+    #endif
     
-    //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
-    if (config.app.splash) {
-        // Pass target URL as query parameter so splash.html knows where to redirect
-        std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.app.entrypoint + "&t=" + cacheBuster;
+    auto configTask = graph.add("config", [&]() {
+        if (!loadConfig(assetLoader, config)) return false;
+        
+        #ifndef NDEBUG
+        std::cout << " " << config.window.title << std::endl;
+        std::cout << " Entrypoint: " << config.app.entrypoint << std::endl;
+        std::cout << " Window: " << config.window.width << "x" << config.window.height 
+                  << (config.window.resizable ? " (resizable)" : " (fixed)") << std::endl;
+        if (config.window.fullscreen) std::cout << "  Fullscreen: ON" << std::endl;
+        if (config.window.alwaysOnTop) std::cout << " Always on Top: ON" << std::endl;
+        if (config.window.frameless) std::cout << "  Frameless: ON" << std::endl;
+        if (config.steamworks.enabled) {
+            std::cout << " Steamworks: ENABLED (App ID: " << config.steamworks.appId << ")" << std::endl;
+        }
+        std::cout << std::endl;
+        #endif
+        
+        //  Use deterministic port based on app.name (NOT window.title!)
+        // This ensures localStorage persists even if window title changes (e.g., version numbers)
+        std::hash<std::string> hasher;
+        size_t hash = hasher(config.app.name);
+        port = 8765 + (hash % 1000);  // Port range: 8765-9765
+        
+        //  CACHE BUSTER: Use timestamp to force reload on every build
+        cacheBuster = gemcore::getCacheBuster();
+        url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.app.entrypoint + "?t=" + cacheBuster;
+        
+        #ifndef NDEBUG
+        std::cout << " Port: " << port << " (based on app.name: " << config.app.name << ")" << std::endl;
+        std::cout << " Version: " << config.app.version << std::endl;
+        #endif
+        return true;
+    }, { assetsTask });
+    
+    // OPTIMIZATION 3: Build cache in PARALLEL with Steam init + WebView creation
+    auto cacheTask = graph.add("cache", [&]() {
+        server.reset(new gemcore::http::HTTPServer(port));
+        server->setEntrypoint(config.app.entrypoint);
+        server->setAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getAsset(path);
+        });
+        server->setStoredAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getStoredAsset(path);
+        });
+        server->setAssetVerifier([&assetLoader](const std::string& path) {
+            return assetLoader.verifyAsset(path);
+        });
+        server->setApiToken(apiToken);
+        #ifdef ENABLE_STEAMWORKS
+        gemcore::steamworks::registerCloudRoutes(*server);  // Binary Steam Cloud saves
+        gemcore::steamworks::registerInputRoutes(*server);  // Steam Input state long-poll
+        #endif
         
         #ifndef NDEBUG
-        std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
-        std::cout << " Splash URL: " << splashUrl << std::endl;
+        auto start = std::chrono::high_resolution_clock::now();
         #endif
         
-        w.navigate(splashUrl);
+        server->buildCache(assetLoader.getAllPaths());
         
-        // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
-        std::thread([&w, url]() {
-            std::this_thread::sleep_for(std::chrono::seconds(2));
-            w.eval("window.location.href = '" + url + "';");
-        }).detach();
-    } else {
         #ifndef NDEBUG
-        std::cout << " URL: " << url << std::endl;
-        std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << " Pre-cached " << server->getCacheSize() << " responses in " << ms << "�s" << std::endl;
+        std::cout << "   � Critical assets (entrypoint, main.js) cached FIRST" << std::endl;
+        #endif
+        return true;
+    }, { configTask });
+    
+    // OPTIMIZATION 4: Start HTTP server BEFORE navigation (faster first request)
+    auto serverTask = graph.add("server", [&]() {
+        std::thread serverThread(runServer, server.get());
+        serverThread.detach();
+        
+        //  OPTIMIZATION: Sleep until the socket listens (no CPU burned while waiting)
+        std::string error;
+        if (!g_serverReady.wait(&error)) {
+            std::cerr << " HTTP server failed: " << error << std::endl;
+            return false;
+        }
+        return true;
+    }, { cacheTask });
+    
+    //  Initialize Steamworks (must be done BEFORE WebView creation)
+    auto steamTask = graph.add("steam", [&]() {
+        #ifdef ENABLE_STEAMWORKS
+        steamEnabled = gemcore::steamworks::initSteamworks(config);
+        #endif
+        return true;
+    }, { configTask });
+    
+    // Cocoa: window work stays on the main thread
+    auto windowTask = graph.add("window", [&]() {
+        // Create WebView with debug mode from config (or default to true for compatibility)
+        webviewPtr.reset(new webview::webview(config.app.debug, nullptr));
+        webview::webview& w = *webviewPtr;
+        w.set_title(config.window.title.c_str());
+        
+        // Apply window config
+        w.set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
+        
+        //  Enable native macOS Game Mode support
+        // This adds the fullscreen button and enables Game Mode in fullscreen
+        #ifdef __APPLE__
+        auto window_result = w.window();
+        if (window_result.has_value()) {
+            void* window_ptr = window_result.value();
+            if (window_ptr) {
+                id nswindow = (id)window_ptr;
+                
+                // Enable fullscreen button (green button) - required for Game Mode
+                // NSWindowCollectionBehaviorFullScreenPrimary = 1 << 7 = 128 (main display)
+                // NSWindowCollectionBehaviorFullScreenAuxiliary = 1 << 8 = 256 (external displays)
+                // Combine both for multi-display support (like Godot!)
+                SEL setCollectionBehavior = sel_registerName("setCollectionBehavior:");
+                NSUInteger behavior = 128 | 256;  // Primary + Auxiliary (works on all displays!)
+                ((void (*)(id, SEL, NSUInteger))objc_msgSend)(nswindow, setCollectionBehavior, behavior);
+                
+                #ifndef NDEBUG
+                std::cout << " Native fullscreen button enabled (Game Mode ready)" << std::endl;
+                std::cout << "    Supports primary display (FullScreenPrimary)" << std::endl;
+                std::cout << "    Supports external displays (FullScreenAuxiliary)" << std::endl;
+                #endif
+            }
+        }
         #endif
         
-        w.navigate(url);
+        //  Fullscreen mode for maximum performance (bypasses compositor)
+        if (config.window.fullscreen) {
+            #ifndef NDEBUG
+            std::cout << "  Fullscreen mode: ENABLED (better performance)" << std::endl;
+            #endif
+            
+            // Use native macOS fullscreen (from helper)
+            auto window_result = w.window();
+            if (window_result.has_value()) {
+                gemcore::window::toggleFullscreen(window_result.value());
+                
+                #ifndef NDEBUG
+                std::cout << " Native fullscreen activated" << std::endl;
+                #endif
+            }
+        }
+        return true;
+    }, { configTask, steamTask }, Graph::MAIN_THREAD);
+    
+    auto bindingsTask = graph.add("bindings", [&]() {
+        // DISABLED: Performance optimizations causing issues with some games
+        // gemcore::universal::enableUniversalPerformance(*webviewPtr);
+        
+        //  Bind Steamworks to JavaScript (if enabled)
+        #ifdef ENABLE_STEAMWORKS
+        gemcore::steamworks::bindSteamworksToWebview(*webviewPtr, steamEnabled);
+        #endif
+        
+        webviewPtr->init(buildJsInit(assetLoader, steamEnabled, apiToken).c_str());
+        return true;
+    }, { windowTask, steamTask }, Graph::MAIN_THREAD);
+    
+    graph.add("navigate", [&]() {
+        webview::webview& w = *webviewPtr;
+        
+        #ifndef NDEBUG
+        std::cout << " Launching WebView..." << std::endl;
+        std::cout << std::endl;
+        #endif
+        
+        //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
+        if (config.app.splash) {
+            // Pass target URL as query parameter so splash.html knows where to redirect
+            std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.app.entrypoint + "&t=" + cacheBuster;
+            
+            #ifndef NDEBUG
+            std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
+            std::cout << " Splash URL: " << splashUrl << std::endl;
+            #endif
+            
+            w.navigate(splashUrl);
+            
+            // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
+            std::thread([&w, url]() {
+                std::this_thread::sleep_for(std::chrono::seconds(2));
+                w.eval("window.location.href = '" + url + "';");
+            }).detach();
+        } else {
+            #ifndef NDEBUG
+            std::cout << " URL: " << url << std::endl;
+            std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+            #endif
+            
+            w.navigate(url);
+        }
+        return true;
+    }, { bindingsTask, serverTask }, Graph::MAIN_THREAD);
+    
+    graph.run();
+    
+    //  GEMCORE_TRACE: write the boot timeline now (the game may never exit cleanly)
+    gemcore::trace::flush();
+    
+    if (!graph.succeeded(assetsTask) || !graph.succeeded(configTask) ||
+        !graph.succeeded(serverTask) || !webviewPtr) {
+        return 1;
     }
+    webview::webview& w = *webviewPtr;
     
-    //  Start Steamworks callback thread (if enabled)
+    auto appReady = std::chrono::high_resolution_clock::now();
+    auto startupMs = std::chrono::duration_cast<std::chrono::milliseconds>(appReady - appStart).count();
+    
+    #ifndef NDEBUG
+    std::cout << " STARTUP TIME: " << startupMs << "ms (all optimizations active)" << std::endl;
+    #else
+    (void)startupMs;
+    #endif
+    
+    //  Pump Steam callbacks on a background thread (adaptive interval, if enabled)
     #ifdef ENABLE_STEAMWORKS
-    std::thread steamThread;
     if (steamEnabled) {
-        steamThread = std::thread([]() {
-            while (g_running) {
-                gemcore::steamworks::SteamworksManager::RunCallbacks();
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
-            }
-        });
+        gemcore::steamworks::SteamworksManager::StartCallbackPump();
     }
     #endif
     
@@ -646,13 +731,15 @@ int main(int argc, char* argv[]) {
     //  Cleanup Steamworks (if enabled)
     #ifdef ENABLE_STEAMWORKS
     if (steamEnabled) {
-        if (steamThread.joinable()) {
-            steamThread.join();
-        }
         gemcore::steamworks::shutdownSteamworks();
     }
     #endif
     
+    //  GEMCORE_RECORD_ACCESS: asset access order for gemcore-pack --profile
+    if (server) server->writeAccessProfile();
+    
+    gemcore::trace::flush();
+    
     return 0;
 }
 
@@ -9,6 +9,7 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <memory>
 
 // Windows headers
 #include <windows.h>
@@ -21,18 +22,18 @@
 #pragma comment(lib, "shlwapi.lib")
 #pragma comment(lib, "winmm.lib")  // For timeBeginPeriod
 
-#include <nlohmann/json.hpp>
 #include "webview/webview.h"
 
 // NEW: Shared HTTP server and asset loader!
 #include "gemcore-http-server.h"
 #include "gemcore-asset-loader.h"
 #include "gemcore-cache-buster.h"
+#include "gemcore-config-record.h"          // Binary launcher config
+#include "gemcore-task-graph.h"             // Startup dependency graph
+#include "gemcore-trace.h"                  // GEMCORE_TRACE startup tracing
 #include "gemcore-window-helper.h"          // Cross-platform window management
 #include "gemcore-steamworks-bindings.h"    //  Steamworks integration (cross-platform)
 
-using json = nlohmann::json;
-
 struct GemcoreConfig {
     struct {
         std::string title;
@@ -49,17 +50,21 @@ struct GemcoreConfig {
     struct {
         bool enabled = false;
         uint32_t appId = 0;
+        uint32_t storeStatsDelayMs = 1000;  // StoreStats coalescing window
+        uint32_t leaderboardCacheMs = 10000;  // Downloaded leaderboard pages reused this long
     } steamworks;
     std::string entrypoint;
     std::string appName;  // Used for deterministic port (localStorage persistence)
 };
 
 std::atomic<bool> g_running{true};
-//  OPTIMIZATION: Atomic flag for server ready state
-std::atomic<bool> g_serverReady{false};
+//  OPTIMIZATION: Blocking readiness handshake (no busy wait during startup)
+gemcore::http::ServerReadiness g_serverReady;
 
 // Multi-threaded request handler (Windows version)
 void worker(SOCKET server_fd, gemcore::http::HTTPServer* server) {
+    gemcore::trace::setThreadName("http-worker");
+    
     while (g_running) {
         SOCKET client = accept(server_fd, nullptr, nullptr);
         if (client != INVALID_SOCKET) {
@@ -74,21 +79,19 @@ void worker(SOCKET server_fd, gemcore::http::HTTPServer* server) {
 
 // Multi-threaded HTTP server (Windows version)
 void runServer(gemcore::http::HTTPServer* server) {
+    gemcore::trace::Span listenSpan("http.listen");
+    
     // Initialize Winsock
     WSADATA wsaData;
     int wsaResult = WSAStartup(MAKEWORD(2, 2), &wsaData);
     if (wsaResult != 0) {
-        #ifndef NDEBUG
-        std::cerr << " WSAStartup failed: " << wsaResult << std::endl;
-        #endif
+        g_serverReady.fail("WSAStartup failed (error " + std::to_string(wsaResult) + ")");
         return;
     }
     
     SOCKET fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (fd == INVALID_SOCKET) {
-        #ifndef NDEBUG
-        std::cerr << " Socket creation failed: " << WSAGetLastError() << std::endl;
-        #endif
+        g_serverReady.fail("socket failed (error " + std::to_string(WSAGetLastError()) + ")");
         WSACleanup();
         return;
     }
@@ -112,22 +115,15 @@ void runServer(gemcore::http::HTTPServer* server) {
     addr.sin_port = htons(server->getPort());
     
     if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR) {
-        #ifndef NDEBUG
-        int err = WSAGetLastError();
-        std::cerr << " Failed to bind to port " << server->getPort() 
-                  << " (error: " << err << ")" << std::endl;
-        #endif
+        g_serverReady.fail("bind 127.0.0.1:" + std::to_string(server->getPort())
+                           + " failed (error " + std::to_string(WSAGetLastError()) + ")");
         closesocket(fd);
         WSACleanup();
         return;
     }
     
     if (listen(fd, 512) == SOCKET_ERROR) {
-        #ifndef NDEBUG
-        int err = WSAGetLastError();
-        std::cerr << " Failed to listen on port " << server->getPort() 
-                  << " (error: " << err << ")" << std::endl;
-        #endif
+        g_serverReady.fail("listen failed (error " + std::to_string(WSAGetLastError()) + ")");
         closesocket(fd);
         WSACleanup();
         return;
@@ -142,8 +138,11 @@ void runServer(gemcore::http::HTTPServer* server) {
               << server->getPort() << std::endl;
     #endif
     
-    //  OPTIMIZATION: Signal that server is ready BEFORE launching workers
-    g_serverReady = true;
+    listenSpan.end();
+    
+    //  OPTIMIZATION: Signal ready BEFORE launching workers (the socket listens,
+    // early connections wait in the backlog)
+    g_serverReady.ready();
     
     std::vector<std::thread> workers;
     for (int i = 0; i < threads; i++) {
@@ -155,231 +154,57 @@ void runServer(gemcore::http::HTTPServer* server) {
     WSACleanup();
 }
 
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    auto appStart = std::chrono::high_resolution_clock::now();
-    
-    //  OPTIMIZATION: Disable console output in production for faster startup
-    #ifdef NDEBUG
-    std::ios::sync_with_stdio(false);
-    #else
-    std::cout << " Gemcore Launcher (Windows Shared Assets)" << std::endl;
-    std::cout << "" << std::endl;
-    std::cout << std::endl;
-    #endif
-    
-    // OPTIMIZATION 1: Process Priority (Windows)
-    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
-    #ifndef NDEBUG
-    std::cout << " Process priority: HIGH" << std::endl;
-    #endif
-    
-    // OPTIMIZATION 2: Parallel Asset Loading
-    gemcore::assets::SharedAssetLoader assetLoader;
-    std::atomic<bool> assetsLoaded{false};
-    
-    std::thread assetLoadThread([&assetLoader, &assetsLoaded]() {
-        assetsLoaded = assetLoader.load();
-    });
-    
-    // OPTIMIZATION 3: Prepare default config
-    GemcoreConfig config;
-    config.window.title = "Gemcore App";
-    config.window.width = 1280;
-    config.window.height = 720;
-    config.entrypoint = "index.html";
-    config.appName = "gemcore-app";  // Default app name
-    
-    // Wait for assets to load
-    assetLoadThread.join();
+/**
+ * Load config from encrypted assets (not accessible to user!)
+ *  OPTIMIZATION: Binary config record compiled at build time - no JSON parsing
+ * False if the container has no record (built by an older gemcore): the app
+ * must not start with a default entrypoint and Steam silently disabled
+ */
+static bool loadConfig(const gemcore::assets::SharedAssetLoader& assetLoader, GemcoreConfig& config) {
+    namespace cfg = gemcore::config;
     
-    if (!assetsLoaded) {
-        MessageBoxA(NULL, "Failed to load assets!", "Gemcore Error", MB_ICONERROR);
-        return 1;
+    cfg::Record record;
+    if (!assetLoader.getConfigRecord(record)) {
+        std::cerr << " No config record in gemcore-assets - rebuild the assets with this gemcore version" << std::endl;
+        return false;
     }
     
-    //  Load config from encrypted assets (not accessible to user!)
-    auto configAsset = assetLoader.getAsset(".gemcore-config.json");
-    if (configAsset.data && configAsset.size > 0) {
-        try {
-            std::string configStr(reinterpret_cast<const char*>(configAsset.data), configAsset.size);
-            json j = json::parse(configStr);
-            
-            // Load window config
-            if (j.contains("window")) {
-                if (j["window"].contains("title")) {
-                    config.window.title = j["window"]["title"].get<std::string>();
-                }
-                if (j["window"].contains("width")) {
-                    config.window.width = j["window"]["width"].get<int>();
-                }
-                if (j["window"].contains("height")) {
-                    config.window.height = j["window"]["height"].get<int>();
-                }
-                if (j["window"].contains("fullscreen")) {
-                    config.window.fullscreen = j["window"]["fullscreen"].get<bool>();
-                }
-                if (j["window"].contains("startFullscreen")) {
-                    config.window.fullscreen = j["window"]["startFullscreen"].get<bool>();
-                }
-            }
-            
-            // Load app config
-            if (j.contains("app")) {
-                if (j["app"].contains("name")) {
-                    config.appName = j["app"]["name"].get<std::string>();
-                    config.app.name = config.appName;
-                    if (config.window.title == "Gemcore App") {
-                        config.window.title = config.appName;
-                    }
-                }
-                if (j["app"].contains("version")) {
-                    config.app.version = j["app"]["version"].get<std::string>();
-                }
-                if (j["app"].contains("entrypoint")) {
-                    config.entrypoint = j["app"]["entrypoint"].get<std::string>();
-                }
-                if (j["app"].contains("debug")) {
-                    config.app.debug = j["app"]["debug"].get<bool>();
-                }
-                if (j["app"].contains("splash")) {
-                    config.app.splash = j["app"]["splash"].get<bool>();
-                }
-            }
-            if (j.contains("entrypoint")) {
-                config.entrypoint = j["entrypoint"].get<std::string>();
-            }
-            
-            // Load Steamworks config
-            if (j.contains("steamworks")) {
-                if (j["steamworks"].contains("enabled")) {
-                    config.steamworks.enabled = j["steamworks"]["enabled"].get<bool>();
-                }
-                if (j["steamworks"].contains("appId")) {
-                    config.steamworks.appId = j["steamworks"]["appId"].get<uint32_t>();
-                }
-            }
-            
-            #ifndef NDEBUG
-            std::cout << " Config loaded from encrypted assets" << std::endl;
-            #endif
-        } catch (const std::exception& e) {
-            #ifndef NDEBUG
-            std::cerr << " Failed to parse config: " << e.what() << std::endl;
-            #endif
+    for (cfg::Field field; record.next(field);) {
+        switch (field.id) {
+            case cfg::WINDOW_TITLE:      config.window.title.assign(field.str()); break;
+            case cfg::WINDOW_WIDTH:      config.window.width = field.i32(); break;
+            case cfg::WINDOW_HEIGHT:     config.window.height = field.i32(); break;
+            case cfg::WINDOW_FULLSCREEN: config.window.fullscreen = field.flag(); break;
+            case cfg::APP_NAME:          config.appName.assign(field.str()); config.app.name = config.appName; break;
+            case cfg::APP_VERSION:       config.app.version.assign(field.str()); break;
+            case cfg::APP_ENTRYPOINT:    config.entrypoint.assign(field.str()); break;
+            case cfg::APP_DEBUG:         config.app.debug = field.flag(); break;
+            case cfg::APP_SPLASH:        config.app.splash = field.flag(); break;
+            case cfg::STEAM_ENABLED:     config.steamworks.enabled = field.flag(); break;
+            case cfg::STEAM_APP_ID:      config.steamworks.appId = field.u32(); break;
+            case cfg::STEAM_STORE_STATS_DELAY_MS: config.steamworks.storeStatsDelayMs = field.u32(); break;
+            case cfg::STEAM_LEADERBOARD_CACHE_MS: config.steamworks.leaderboardCacheMs = field.u32(); break;
+            default: break;  // Used by other platforms (or a newer build)
         }
     }
     
-    #ifndef NDEBUG
-    std::cout << " " << config.window.title << std::endl;
-    std::cout << " Entrypoint: " << config.entrypoint << std::endl;
-    std::cout << std::endl;
-    #endif
-    
-    // OPTIMIZATION 4: Parallel Cache Building
-    //  Use deterministic port based on app.name (NOT window.title!)
-    std::hash<std::string> hasher;
-    size_t hash = hasher(config.appName);
-    int port = 8765 + (hash % 1000);  // Port range: 8765-9765
-    
-    #ifndef NDEBUG
-    std::cout << " Port: " << port << " (based on app.name: " << config.appName << ")" << std::endl;
-    #endif
-    gemcore::http::HTTPServer server(port);
-    server.setEntrypoint(config.entrypoint);
-    server.setAssetProvider([&assetLoader](const std::string& path) {
-        return assetLoader.getAsset(path);
-    });
-    
-    std::atomic<bool> cacheReady{false};
-    std::thread cacheThread([&server, &assetLoader, &cacheReady]() {
-        #ifndef NDEBUG
-        auto cacheStart = std::chrono::high_resolution_clock::now();
-        #endif
-        
-        server.buildCache(assetLoader.getAllPaths());
-        
-        #ifndef NDEBUG
-        auto cacheEnd = std::chrono::high_resolution_clock::now();
-        auto cacheDuration = std::chrono::duration_cast<std::chrono::microseconds>(cacheEnd - cacheStart);
-        std::cout << " Pre-cached " << server.getCacheSize() << " responses in " 
-                  << cacheDuration.count() << "s" << std::endl;
-        #endif
-        
-        cacheReady = true;
-    });
-    
-    //  HIGH-PERFORMANCE MODE: Disable Power Throttling
-    #ifndef NDEBUG
-    std::cout << " Enabling High-Performance Mode..." << std::endl;
-    #endif
-    
-    // Disable Windows Power Throttling for maximum FPS
-    PROCESS_POWER_THROTTLING_STATE PowerThrottling{};
-    PowerThrottling.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
-    PowerThrottling.ControlMask = PROCESS_POWER_THROTTLING_EXECUTION_SPEED;
-    PowerThrottling.StateMask = 0;  // 0 = disable throttling
-    
-    SetProcessInformation(
-        GetCurrentProcess(),
-        ProcessPowerThrottling,
-        &PowerThrottling,
-        sizeof(PowerThrottling)
-    );
-    
-    //  Windows Game Mode Optimizations
-    // Request high-performance GPU (prefer discrete over integrated)
-    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
-    
-    // Set process priority boost (Windows Game Mode equivalent)
-    SetProcessPriorityBoost(GetCurrentProcess(), FALSE);  // Disable priority boost throttling
-    
-    // Set thread priority for main thread (additional boost)
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
-    
-    // Set time-critical scheduling for lower latency
-    timeBeginPeriod(1);  // Request 1ms timer resolution (reduces input latency)
+    // The app name doubles as the window title
+    if (!config.app.name.empty() && config.window.title == "Gemcore App") {
+        config.window.title = config.appName;
+    }
     
     #ifndef NDEBUG
-    std::cout << " Windows Game Mode optimizations enabled:" << std::endl;
-    std::cout << "    HIGH_PRIORITY_CLASS" << std::endl;
-    std::cout << "    Power Throttling disabled" << std::endl;
-    std::cout << "    Priority Boost enabled" << std::endl;
-    std::cout << "    Thread Priority: HIGHEST" << std::endl;
-    std::cout << "    Timer Resolution: 1ms (lower latency)" << std::endl;
+    std::cout << " Config loaded from encrypted assets" << std::endl;
     #endif
     
-    //  Initialize Steamworks (cross-platform helper)
-    bool steamEnabled = gemcore::steamworks::initSteamworks(config);
-    
-    // While cache builds, create WebView (parallel!)
-    // Create WebView with debug mode from config (enables right-click menu, DevTools)
-    webview::webview w(config.app.debug, nullptr);
-    w.set_title(config.window.title);
-    w.set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
-    
-    //  Native Windows Fullscreen mode for maximum performance
-    if (config.window.fullscreen) {
-        #ifndef NDEBUG
-        std::cout << "  Fullscreen mode: ENABLED (better performance)" << std::endl;
-        #endif
-        
-        // Get window handle and set fullscreen
-        auto window_result = w.window();
-        if (window_result.has_value()) {
-            void* window_ptr = window_result.value();
-            if (window_ptr) {
-                gemcore::window::enableFullscreen(window_ptr);
-                
-                #ifndef NDEBUG
-                std::cout << "    Native fullscreen activated!" << std::endl;
-                #endif
-            }
-        }
-    }
-    
-    //  Bind Steamworks to JavaScript (cross-platform helper)
-    gemcore::steamworks::bindSteamworksToWebview(w, steamEnabled);
-    
+    return true;
+}
+
+/**
+ * Build the init script (Gemcore API + Steamworks wrapper + runtime optimizations)
+ */
+static std::string buildInitScript(const gemcore::assets::SharedAssetLoader& assetLoader, bool steamEnabled,
+                                   const std::string& apiToken) {
     // Load Steamworks wrapper from assets (if available)
     std::string steamworksWrapperScript;
     #ifdef ENABLE_STEAMWORKS
@@ -389,6 +214,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
             steamworksWrapperScript = std::string(reinterpret_cast<const char*>(steamworksAsset.data), steamworksAsset.size);
         }
     }
+    #else
+    (void)assetLoader;
     #endif
     
     // Inject Gemcore API + Runtime Optimizations
@@ -400,6 +227,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         launcher: 'shared-assets',
         steam: )JS";
     gemcoreInit += steamEnabled ? "true" : "false";
+    gemcoreInit += ",\n        apiToken: '" + apiToken + "'";
     gemcoreInit += R"JS(
     };
     
@@ -411,7 +239,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     gemcoreInit += R"JS(
 )JS";
     
-    w.init(gemcoreInit + R"(
+    return gemcoreInit + R"(
         
         //  RUNTIME OPTIMIZATION 1: Passive Event Listeners
         (function() {
@@ -496,69 +324,299 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
                 document.head.appendChild(style);
             });
         }
-    )");
+    )";
+}
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    auto appStart = std::chrono::high_resolution_clock::now();
+    gemcore::trace::setThreadName("main");
     
-    // Wait for cache to be ready
-    cacheThread.join();
+    //  OPTIMIZATION: Disable console output in production for faster startup
+    #ifdef NDEBUG
+    std::ios::sync_with_stdio(false);
+    #else
+    std::cout << " Gemcore Launcher (Windows Shared Assets)" << std::endl;
+    std::cout << "" << std::endl;
+    std::cout << std::endl;
+    #endif
     
-    // OPTIMIZATION 5: Start HTTP server BEFORE navigation
-    std::thread serverThread(runServer, &server);
-    serverThread.detach();
+    // OPTIMIZATION 1: Process Priority (Windows)
+    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
+    #ifndef NDEBUG
+    std::cout << " Process priority: HIGH" << std::endl;
+    #endif
     
-    //  OPTIMIZATION: Wait for server ready flag instead of sleep (faster!)
-    while (!g_serverReady) {
-        std::this_thread::yield();  // Cooperative wait, ~1-5ms instead of 50ms
+    gemcore::assets::SharedAssetLoader assetLoader;
+    
+    //  --verify: check every asset against its integrity hash and exit
+    if (lpCmdLine && std::strstr(lpCmdLine, "--verify")) {
+        if (!assetLoader.load()) {
+            MessageBoxA(NULL, "Failed to load assets!", "Gemcore Error", MB_ICONERROR);
+            return 1;
+        }
+        bool verified = assetLoader.verifyAll();
+        MessageBoxA(NULL, verified ? "All assets verified." : "Corrupted assets found!", "Gemcore",
+                    verified ? MB_ICONINFORMATION : MB_ICONERROR);
+        return verified ? 0 : 1;
     }
     
-    auto startupEnd = std::chrono::high_resolution_clock::now();
-    auto startupDuration = std::chrono::duration_cast<std::chrono::milliseconds>(startupEnd - appStart);
+    // Default config
+    GemcoreConfig config;
+    config.window.title = "Gemcore App";
+    config.window.width = 1280;
+    config.window.height = 720;
+    config.entrypoint = "index.html";
+    config.appName = "gemcore-app";  // Default app name
     
+    int port = 8765;
+    std::string apiToken = gemcore::http::makeApiToken();  // Guards /__gemcore/ API routes
+    std::unique_ptr<gemcore::http::HTTPServer> server;
+    std::unique_ptr<webview::webview> webviewPtr;
+    bool steamEnabled = false;
+    std::string cacheBuster;
+    std::string url;
+    
+    //  HIGH-PERFORMANCE MODE: Disable Power Throttling
     #ifndef NDEBUG
-    std::cout << " STARTUP TIME: " << startupDuration.count() << "ms (all optimizations active)" << std::endl;
-    std::cout << " Launching WebView..." << std::endl;
-    std::cout << std::endl;
+    std::cout << " Enabling High-Performance Mode..." << std::endl;
     #endif
     
-    //  CACHE BUSTER: Use timestamp to force reload on every build
-    std::string cacheBuster = gemcore::getCacheBuster();
-    std::string url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.entrypoint + "?t=" + cacheBuster;
+    // Disable Windows Power Throttling for maximum FPS
+    PROCESS_POWER_THROTTLING_STATE PowerThrottling{};
+    PowerThrottling.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    PowerThrottling.ControlMask = PROCESS_POWER_THROTTLING_EXECUTION_SPEED;
+    PowerThrottling.StateMask = 0;  // 0 = disable throttling
+    
+    SetProcessInformation(
+        GetCurrentProcess(),
+        ProcessPowerThrottling,
+        &PowerThrottling,
+        sizeof(PowerThrottling)
+    );
     
-    //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
-    if (config.app.splash) {
-        // Pass target URL as query parameter so splash.html knows where to redirect
-        std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.entrypoint + "&t=" + cacheBuster;
+    //  Windows Game Mode Optimizations
+    // Request high-performance GPU (prefer discrete over integrated)
+    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
+    
+    // Set process priority boost (Windows Game Mode equivalent)
+    SetProcessPriorityBoost(GetCurrentProcess(), FALSE);  // Disable priority boost throttling
+    
+    // Set thread priority for main thread (additional boost)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    
+    // Set time-critical scheduling for lower latency
+    timeBeginPeriod(1);  // Request 1ms timer resolution (reduces input latency)
+    
+    #ifndef NDEBUG
+    std::cout << " Windows Game Mode optimizations enabled:" << std::endl;
+    std::cout << "    HIGH_PRIORITY_CLASS" << std::endl;
+    std::cout << "    Power Throttling disabled" << std::endl;
+    std::cout << "    Priority Boost enabled" << std::endl;
+    std::cout << "    Thread Priority: HIGHEST" << std::endl;
+    std::cout << "    Timer Resolution: 1ms (lower latency)" << std::endl;
+    #endif
+    
+    //  OPTIMIZATION 2: Startup task graph
+    // Every boot step is a node with explicit dependencies; independent chains
+    // (cache build -> server start, Steam init -> window) run concurrently, so
+    // time to first navigate is the critical path only.
+    using Graph = gemcore::startup::TaskGraph;
+    Graph graph;
+    
+    auto assetsTask = graph.add("assets", [&]() {
+        return assetLoader.load();
+    });
+    
+    auto configTask = graph.add("config", [&]() {
+        if (!loadConfig(assetLoader, config)) return false;
         
         #ifndef NDEBUG
-        std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
-        std::cout << " Splash URL: " << splashUrl << std::endl;
+        std::cout << " " << config.window.title << std::endl;
+        std::cout << " Entrypoint: " << config.entrypoint << std::endl;
+        std::cout << std::endl;
         #endif
         
-        w.navigate(splashUrl.c_str());
+        //  Use deterministic port based on app.name (NOT window.title!)
+        std::hash<std::string> hasher;
+        size_t hash = hasher(config.appName);
+        port = 8765 + (hash % 1000);  // Port range: 8765-9765
+        
+        //  CACHE BUSTER: Use timestamp to force reload on every build
+        cacheBuster = gemcore::getCacheBuster();
+        url = "http://127.0.0.1:" + std::to_string(port) + "/" + config.entrypoint + "?t=" + cacheBuster;
+        
+        #ifndef NDEBUG
+        std::cout << " Port: " << port << " (based on app.name: " << config.appName << ")" << std::endl;
+        #endif
+        return true;
+    }, { assetsTask });
+    
+    // OPTIMIZATION 3: Build cache in PARALLEL with Steam init + WebView creation
+    auto cacheTask = graph.add("cache", [&]() {
+        server.reset(new gemcore::http::HTTPServer(port));
+        server->setEntrypoint(config.entrypoint);
+        server->setAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getAsset(path);
+        });
+        server->setStoredAssetProvider([&assetLoader](const std::string& path) {
+            return assetLoader.getStoredAsset(path);
+        });
+        server->setAssetVerifier([&assetLoader](const std::string& path) {
+            return assetLoader.verifyAsset(path);
+        });
+        server->setApiToken(apiToken);
+        #ifdef ENABLE_STEAMWORKS
+        gemcore::steamworks::registerCloudRoutes(*server);  // Binary Steam Cloud saves
+        gemcore::steamworks::registerInputRoutes(*server);  // Steam Input state long-poll
+        #endif
         
-        // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
-        std::thread([&w, url]() {
-            std::this_thread::sleep_for(std::chrono::seconds(2));
-            std::string js = "window.location.href = '" + url + "';";
-            w.eval(js.c_str());
-        }).detach();
-    } else {
         #ifndef NDEBUG
-        std::cout << " URL: " << url << std::endl;
-        std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+        auto cacheStart = std::chrono::high_resolution_clock::now();
         #endif
         
-        w.navigate(url.c_str());
+        server->buildCache(assetLoader.getAllPaths());
+        
+        #ifndef NDEBUG
+        auto cacheEnd = std::chrono::high_resolution_clock::now();
+        auto cacheDuration = std::chrono::duration_cast<std::chrono::microseconds>(cacheEnd - cacheStart);
+        std::cout << " Pre-cached " << server->getCacheSize() << " responses in " 
+                  << cacheDuration.count() << "s" << std::endl;
+        #endif
+        return true;
+    }, { configTask });
+    
+    // OPTIMIZATION 4: Start HTTP server BEFORE navigation
+    std::string serverError;
+    auto serverTask = graph.add("server", [&]() {
+        std::thread serverThread(runServer, server.get());
+        serverThread.detach();
+        
+        //  OPTIMIZATION: Sleep until the socket listens (no CPU burned while waiting)
+        if (!g_serverReady.wait(&serverError)) {
+            std::cerr << " HTTP server failed: " << serverError << std::endl;
+            return false;
+        }
+        return true;
+    }, { cacheTask });
+    
+    //  Initialize Steamworks (cross-platform helper, BEFORE WebView creation)
+    auto steamTask = graph.add("steam", [&]() {
+        steamEnabled = gemcore::steamworks::initSteamworks(config);
+        return true;
+    }, { configTask });
+    
+    // Win32: the window belongs to the thread that runs the message loop
+    auto windowTask = graph.add("window", [&]() {
+        // Create WebView with debug mode from config (enables right-click menu, DevTools)
+        webviewPtr.reset(new webview::webview(config.app.debug, nullptr));
+        webview::webview& w = *webviewPtr;
+        w.set_title(config.window.title);
+        w.set_size(config.window.width, config.window.height, WEBVIEW_HINT_NONE);
+        
+        //  Native Windows Fullscreen mode for maximum performance
+        if (config.window.fullscreen) {
+            #ifndef NDEBUG
+            std::cout << "  Fullscreen mode: ENABLED (better performance)" << std::endl;
+            #endif
+            
+            // Get window handle and set fullscreen
+            auto window_result = w.window();
+            if (window_result.has_value()) {
+                void* window_ptr = window_result.value();
+                if (window_ptr) {
+                    gemcore::window::enableFullscreen(window_ptr);
+                    
+                    #ifndef NDEBUG
+                    std::cout << "    Native fullscreen activated!" << std::endl;
+                    #endif
+                }
+            }
+        }
+        return true;
+    }, { configTask, steamTask }, Graph::MAIN_THREAD);
+    
+    auto bindingsTask = graph.add("bindings", [&]() {
+        //  Bind Steamworks to JavaScript (cross-platform helper)
+        gemcore::steamworks::bindSteamworksToWebview(*webviewPtr, steamEnabled);
+        
+        // Inject Gemcore API + Runtime Optimizations
+        webviewPtr->init(buildInitScript(assetLoader, steamEnabled, apiToken));
+        return true;
+    }, { windowTask, steamTask }, Graph::MAIN_THREAD);
+    
+    graph.add("navigate", [&]() {
+        webview::webview& w = *webviewPtr;
+        
+        #ifndef NDEBUG
+        std::cout << " Launching WebView..." << std::endl;
+        std::cout << std::endl;
+        #endif
+        
+        //  Splash Screen: Show splash.html first, then navigate to game after 2 seconds
+        if (config.app.splash) {
+            // Pass target URL as query parameter so splash.html knows where to redirect
+            std::string splashUrl = "http://127.0.0.1:" + std::to_string(port) + "/splash.html?redirect=" + config.entrypoint + "&t=" + cacheBuster;
+            
+            #ifndef NDEBUG
+            std::cout << " Splash Screen: ENABLED (splash.html)" << std::endl;
+            std::cout << " Splash URL: " << splashUrl << std::endl;
+            #endif
+            
+            w.navigate(splashUrl.c_str());
+            
+            // After 2 seconds, navigate to the actual game (backup if splash.html doesn't redirect)
+            std::thread([&w, url]() {
+                std::this_thread::sleep_for(std::chrono::seconds(2));
+                std::string js = "window.location.href = '" + url + "';";
+                w.eval(js.c_str());
+            }).detach();
+        } else {
+            #ifndef NDEBUG
+            std::cout << " URL: " << url << std::endl;
+            std::cout << " Cache Buster: t=" << cacheBuster << std::endl;
+            #endif
+            
+            w.navigate(url.c_str());
+        }
+        return true;
+    }, { bindingsTask, serverTask }, Graph::MAIN_THREAD);
+    
+    graph.run();
+    
+    //  GEMCORE_TRACE: write the boot timeline now (the game may never exit cleanly)
+    gemcore::trace::flush();
+    
+    if (!graph.succeeded(assetsTask)) {
+        MessageBoxA(NULL, "Failed to load assets!", "Gemcore Error", MB_ICONERROR);
+        return 1;
+    }
+    if (!graph.succeeded(configTask)) {
+        MessageBoxA(NULL, "No config record in the game assets.\nRebuild the assets with this gemcore version.",
+                    "Gemcore Error", MB_ICONERROR);
+        return 1;
     }
+    if (!graph.succeeded(serverTask)) {
+        std::string message = "Failed to start the local server:\n" + serverError;
+        MessageBoxA(NULL, message.c_str(), "Gemcore Error", MB_ICONERROR);
+        return 1;
+    }
+    if (!webviewPtr) {
+        return 1;
+    }
+    webview::webview& w = *webviewPtr;
     
-    //  Run Steamworks callbacks in background thread (if enabled)
-    std::thread steamThread;
+    auto startupEnd = std::chrono::high_resolution_clock::now();
+    auto startupDuration = std::chrono::duration_cast<std::chrono::milliseconds>(startupEnd - appStart);
+    
+    #ifndef NDEBUG
+    std::cout << " STARTUP TIME: " << startupDuration.count() << "ms (all optimizations active)" << std::endl;
+    #else
+    (void)startupDuration;
+    #endif
+    
+    //  Pump Steam callbacks on a background thread (adaptive interval, if enabled)
     if (steamEnabled) {
-        steamThread = std::thread([]() {
-            while (g_running) {
-                gemcore::steamworks::SteamworksManager::RunCallbacks();
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
-            }
-        });
+        gemcore::steamworks::SteamworksManager::StartCallbackPump();
     }
     
     // Run event loop
@@ -569,12 +627,14 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     
     //  Cleanup Steamworks
     if (steamEnabled) {
-        if (steamThread.joinable()) {
-            steamThread.join();
-        }
         gemcore::steamworks::shutdownSteamworks();
     }
     
+    //  GEMCORE_RECORD_ACCESS: asset access order for gemcore-pack --profile
+    if (server) server->writeAccessProfile();
+    
+    gemcore::trace::flush();
+    
     return 0;
 }
 
@@ -0,0 +1,228 @@
+/**
+ *  Gemcore Asset Container Format - SHARED BY LOADER AND PACKER
+ *
+ * Container formats (all integers little-endian):
+ *   GEMCORE1: "GEMCORE1\0", key[32], u32 count,
+ *             count x { u32 pathLen, path, u64 size, data }
+ *   GEMCORE2: "GEMCORE2\0", key[32], u32 count,
+ *             count x { u32 pathLen, path, u8 codec, u64 offset, u64 storedSize, u64 rawSize },
+ *             data blobs at `offset` (from the container start); incremental
+ *             packs leave zero padding after the TOC and may leave dead blobs.
+ *             Byte-identical assets share one blob (same offset in the TOC).
+ *   GEMCORE3: GEMCORE2 with integrity hashes: "GEMCORE3\0", key[32], u32 count,
+ *             u64 tocHash (XXH64 of the TOC entries),
+ *             count x { ...GEMCORE2 fields..., u64 hash (XXH64 of the decrypted
+ *             stored payload) }
+ *             The TOC hash covers every asset hash, so checking it plus every
+ *             asset verifies the whole container.
+ *
+ * GEMCORE2/3 containers packed with an access profile (gemcore-pack --profile)
+ * store their blobs in first-access order and list the profiled ("hot") paths
+ * in the raw entry PROFILE_PATH, which is stored first.
+ *
+ * Data is XOR'd with key[(i + (i >> 8)) % 32] where i restarts at 0 for every
+ * asset. Written by launcher/tools/gemcore-pack.cpp (and the fallback in
+ * scripts/embed-assets-shared.ts), read by gemcore-asset-loader.h.
+ */
+
+#ifndef GEMCORE_ASSET_FORMAT_H
+#define GEMCORE_ASSET_FORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace gemcore {
+namespace assets {
+
+static const char MAGIC_V1[9] = { 'G','E','M','C','O','R','E','1','\0' };
+static const char MAGIC_V2[9] = { 'G','E','M','C','O','R','E','2','\0' };
+static const char MAGIC_V3[9] = { 'G','E','M','C','O','R','E','3','\0' };
+static const size_t MAGIC_SIZE = 9;
+static const size_t KEY_SIZE = 32;
+static const size_t HEADER_SIZE = MAGIC_SIZE + KEY_SIZE + 4;
+
+// GEMCORE2 TOC entry size after the path: codec + offset + storedSize + rawSize
+static const size_t TOC_FIELDS_SIZE = 1 + 8 + 8 + 8;
+
+// GEMCORE3: header + tocHash, TOC entry fields + hash
+static const size_t HEADER_V3_SIZE = HEADER_SIZE + 8;
+static const size_t TOC_FIELDS_V3_SIZE = TOC_FIELDS_SIZE + 8;
+
+// Access profile entry: PROFILE_HEADER, then one hot path per line in access order
+static const char PROFILE_PATH[] = ".gemcore-profile";
+static const char PROFILE_HEADER[] = "gemcore-profile 1\n";
+
+/**
+ * Per-asset codec (GEMCORE2 TOC)
+ */
+enum AssetCodec : uint8_t {
+    CODEC_RAW = 0,
+    CODEC_GZIP = 1
+};
+
+/**
+ *  XOR keystream, 256 bytes at a time
+ *
+ * key[(i + (i >> 8)) % 32] only depends on (i & 255) and (i >> 8) % 32: every
+ * 256-byte block uses the key rotated by its block index. The 32 possible
+ * blocks are precomputed, so the hot loop is a plain 256-byte XOR that the
+ * compiler vectorizes (SSE2/AVX2/NEON).
+ */
+class Keystream {
+private:
+    alignas(64) uint8_t blocks_[KEY_SIZE][256];
+
+public:
+    explicit Keystream(const uint8_t* key) {
+        for (size_t b = 0; b < KEY_SIZE; b++) {
+            for (size_t j = 0; j < 256; j++) {
+                blocks_[b][j] = key[(j + b) % KEY_SIZE];
+            }
+        }
+    }
+
+    /**
+     * XOR len bytes that start at stream position `pos` of an asset
+     * (pos lets large files be processed in chunks)
+     */
+    void apply(uint8_t* data, size_t len, uint64_t pos = 0) const {
+        // Leading partial block
+        size_t j = (size_t)(pos & 255);
+        if (j != 0) {
+            const uint8_t* ks = blocks_[(pos >> 8) % KEY_SIZE];
+            size_t n = len < 256 - j ? len : 256 - j;
+            for (size_t k = 0; k < n; k++) data[k] ^= ks[j + k];
+            data += n;
+            len -= n;
+            pos += n;
+        }
+
+        // Whole blocks
+        while (len >= 256) {
+            const uint8_t* ks = blocks_[(pos >> 8) % KEY_SIZE];
+            for (size_t k = 0; k < 256; k++) data[k] ^= ks[k];
+            data += 256;
+            len -= 256;
+            pos += 256;
+        }
+
+        // Trailing partial block
+        const uint8_t* ks = blocks_[(pos >> 8) % KEY_SIZE];
+        for (size_t k = 0; k < len; k++) data[k] ^= ks[k];
+    }
+};
+
+/**
+ *  XXH64 content hash (streaming)
+ * Used for change detection in incremental packing and GEMCORE3 integrity
+ * checks. Four independent 64-bit lanes keep the CPU's multipliers busy, so
+ * it runs at memory speed without SIMD intrinsics.
+ */
+class XXH64 {
+private:
+    static const uint64_t P1 = 11400714785074694791ULL;
+    static const uint64_t P2 = 14029467366897019727ULL;
+    static const uint64_t P3 = 1609587929392839161ULL;
+    static const uint64_t P4 = 9650029242287828579ULL;
+    static const uint64_t P5 = 2870177450012600261ULL;
+
+    uint64_t v_[4];
+    uint64_t totalLen_ = 0;
+    uint8_t mem_[32];
+    size_t memSize_ = 0;
+    uint64_t seed_;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t read64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+    static uint32_t read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    static uint64_t round(uint64_t acc, uint64_t input) { return rotl(acc + input * P2, 31) * P1; }
+    static uint64_t merge(uint64_t acc, uint64_t val) { return (acc ^ round(0, val)) * P1 + P4; }
+
+    void stripe(const uint8_t* p) {
+        v_[0] = round(v_[0], read64(p));
+        v_[1] = round(v_[1], read64(p + 8));
+        v_[2] = round(v_[2], read64(p + 16));
+        v_[3] = round(v_[3], read64(p + 24));
+    }
+
+public:
+    explicit XXH64(uint64_t seed = 0) : seed_(seed) {
+        v_[0] = seed + P1 + P2;
+        v_[1] = seed + P2;
+        v_[2] = seed;
+        v_[3] = seed - P1;
+    }
+
+    void update(const uint8_t* data, size_t len) {
+        totalLen_ += len;
+
+        if (memSize_ + len < 32) {
+            std::memcpy(mem_ + memSize_, data, len);
+            memSize_ += len;
+            return;
+        }
+        if (memSize_ > 0) {
+            size_t fill = 32 - memSize_;
+            std::memcpy(mem_ + memSize_, data, fill);
+            stripe(mem_);
+            data += fill;
+            len -= fill;
+            memSize_ = 0;
+        }
+        while (len >= 32) {
+            stripe(data);
+            data += 32;
+            len -= 32;
+        }
+        std::memcpy(mem_, data, len);
+        memSize_ = len;
+    }
+
+    uint64_t digest() const {
+        uint64_t h;
+        if (totalLen_ >= 32) {
+            h = rotl(v_[0], 1) + rotl(v_[1], 7) + rotl(v_[2], 12) + rotl(v_[3], 18);
+            for (int i = 0; i < 4; i++) h = merge(h, v_[i]);
+        } else {
+            h = seed_ + P5;
+        }
+        h += totalLen_;
+
+        const uint8_t* p = mem_;
+        size_t len = memSize_;
+        while (len >= 8) {
+            h = rotl(h ^ round(0, read64(p)), 27) * P1 + P4;
+            p += 8;
+            len -= 8;
+        }
+        if (len >= 4) {
+            h = rotl(h ^ (uint64_t)read32(p) * P1, 23) * P2 + P3;
+            p += 4;
+            len -= 4;
+        }
+        while (len > 0) {
+            h = rotl(h ^ (*p) * P5, 11) * P1;
+            p++;
+            len--;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static uint64_t hash(const uint8_t* data, size_t len, uint64_t seed = 0) {
+        XXH64 state(seed);
+        state.update(data, len);
+        return state.digest();
+    }
+};
+
+} // namespace assets
+} // namespace gemcore
+
+#endif // GEMCORE_ASSET_FORMAT_H
@@ -4,6 +4,31 @@
  * Loads assets from:
  * 1. Embedded C++ arrays (embedded-assets.h)
  * 2. External binary file (gemcore-assets)  WITH XOR DECRYPTION
+ * 3. A region (fd, offset, length) of another file, e.g. the asset container
+ *    embedded in the single-file executable (mapped in place, never extracted)
+ *
+ * Container layout: see gemcore-asset-format.h.
+ * GEMCORE2 assets may be stored gzip-compressed (codec 1): they stay compressed
+ * in memory, are served as-is to HTTP clients accepting gzip and are inflated
+ * on demand otherwise.
+ *
+ * GEMCORE3 adds integrity hashes. The TOC hash is checked at load (a corrupted
+ * or truncated TOC refuses to load); asset hashes are checked lazily on first
+ * use by default. GEMCORE_VERIFY_ASSETS=full checks every asset inside the
+ * decryption workers, =off disables the checks. verifyAll() backs the
+ * launchers' --verify flag.
+ *
+ * GEMCORE_SHARED_ASSETS=1 (Linux) shares the decrypted container between
+ * concurrent instances through /dev/shm instead of a private copy each.
+ *
+ * Containers packed with an access profile (gemcore-pack --profile) only have
+ * their hot prefix read ahead and decrypted before load() returns; the rest is
+ * read ahead and decrypted by a background thread in layout order. An asset
+ * requested before the thread reached it is decrypted on the spot. Without a
+ * profile the whole container is decrypted at load, as before.
+ *
+ * The binary launcher config (gemcore-config-record.h) is a raw entry that is
+ * located once at load time; getConfigRecord() decodes it without a lookup.
  */
 
 #ifndef GEMCORE_ASSET_LOADER_H
@@ -15,7 +40,20 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include <zlib.h>
 #include "gemcore-http-server.h"
+#include "gemcore-asset-format.h"
+#include "gemcore-config-record.h"
+#include "gemcore-trace.h"
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h>
@@ -24,6 +62,17 @@
 #ifdef _WIN32
 #include <windows.h>
 #include <shlwapi.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/file.h>       // flock() for the shared asset segment
 #endif
 
 namespace gemcore {
@@ -33,6 +82,11 @@ namespace assets {
  *  XOR Decryption with multi-key rotation (matches TypeScript version!)
  */
 inline void xorDecrypt(uint8_t* data, size_t len, const uint8_t* key, size_t keyLen) {
+    if (keyLen == KEY_SIZE) {
+        Keystream(key).apply(data, len);
+        return;
+    }
+    
     // Multi-key rotation for better security (same algorithm as TypeScript)
     for (size_t i = 0; i < len; i++) {
         // Use position-dependent key rotation
@@ -41,6 +95,26 @@ inline void xorDecrypt(uint8_t* data, size_t len, const uint8_t* key, size_t key
     }
 }
 
+/**
+ * Inflate a gzip payload whose uncompressed size is known (single pass)
+ */
+inline bool inflateGzip(const unsigned char* data, size_t size, uint64_t rawSize, std::string& out) {
+    out.resize((size_t)rawSize);
+    
+    z_stream stream = {};
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) return false;
+    
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = (uInt)size;
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = (uInt)rawSize;
+    
+    int ret = inflate(&stream, Z_FINISH);
+    bool ok = ret == Z_STREAM_END && stream.total_out == rawSize;
+    inflateEnd(&stream);
+    return ok;
+}
+
 /**
  * Get executable directory (cross-platform)
  */
@@ -85,6 +159,246 @@ inline bool endsWith(const std::string& str, const std::string& suffix) {
     return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
+/**
+ * Copy-on-write memory mapping of a file region (fd, offset, length)
+ * 
+ * The region does not need to be page aligned: the mapping starts at the
+ * enclosing page/allocation boundary and data() points at `offset`.
+ * Pages are mapped private + writable so assets can be decrypted in place
+ * without ever touching the file on disk.
+ */
+class MappedRegion {
+private:
+    void* base_ = nullptr;
+    size_t mappedSize_ = 0;
+    unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE mapping_ = NULL;
+#endif
+    
+public:
+    MappedRegion() = default;
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+    ~MappedRegion() { unmap(); }
+    
+    bool map(int fd, uint64_t offset, uint64_t length) {
+        unmap();
+        if (fd < 0 || length == 0) return false;
+        
+#ifdef _WIN32
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        uint64_t granularity = sysInfo.dwAllocationGranularity;
+        uint64_t alignedOffset = offset - (offset % granularity);
+        uint64_t delta = offset - alignedOffset;
+        
+        HANDLE file = (HANDLE)_get_osfhandle(fd);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        
+        mapping_ = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (!mapping_) return false;
+        
+        base_ = MapViewOfFile(mapping_, FILE_MAP_COPY,
+                              (DWORD)(alignedOffset >> 32), (DWORD)(alignedOffset & 0xFFFFFFFF),
+                              (SIZE_T)(length + delta));
+        if (!base_) {
+            CloseHandle(mapping_);
+            mapping_ = NULL;
+            return false;
+        }
+#else
+        uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+        uint64_t alignedOffset = offset - (offset % pageSize);
+        uint64_t delta = offset - alignedOffset;
+        
+        void* addr = mmap(nullptr, (size_t)(length + delta), PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, fd, (off_t)alignedOffset);
+        if (addr == MAP_FAILED) return false;
+        base_ = addr;
+#endif
+        mappedSize_ = (size_t)(length + delta);
+        data_ = static_cast<unsigned char*>(base_) + delta;
+        size_ = (size_t)length;
+        return true;
+    }
+    
+    void unmap() {
+        if (!base_) return;
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+#else
+        munmap(base_, mappedSize_);
+#endif
+        base_ = nullptr;
+        data_ = nullptr;
+        mappedSize_ = 0;
+        size_ = 0;
+    }
+    
+    /**
+     * Start reading [offset, offset + length) of the region ahead of use
+     * (POSIX madvise; no-op on Windows)
+     */
+    void prefetch(size_t offset, size_t length) const {
+#ifndef _WIN32
+        if (!data_ || offset >= size_) return;
+        uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+        uintptr_t start = (uintptr_t)(data_ + offset) & ~(pageSize - 1);
+        uintptr_t end = (uintptr_t)(data_ + offset + std::min(length, size_ - offset));
+        madvise((void*)start, (size_t)(end - start), MADV_WILLNEED);
+#else
+        (void)offset;
+        (void)length;
+#endif
+    }
+    
+    unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+#ifdef __linux__
+/**
+ *  Decrypted container shared by concurrent instances (Linux, opt-in with
+ * GEMCORE_SHARED_ASSETS=1)
+ *
+ * The first instance decrypts into /dev/shm/gemcore-<bundle hash> and publishes
+ * it with link() once complete, so a visible segment is always whole. Later
+ * instances map it read-only instead of decrypting a private copy.
+ *
+ * Refcounting: every user holds a shared flock() on the segment. The kernel
+ * drops it when a process dies, so whoever unloads last (gets the exclusive
+ * lock) unlinks the segment. A segment left behind when every user crashed
+ * is still valid (it is keyed by content) and is reused, then cleaned up by
+ * the next clean exit.
+ */
+class SharedSegment {
+private:
+    int fd_ = -1;
+    unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    std::string path_;
+    std::string tmpPath_;   // Set while creating (not yet published)
+    
+public:
+    SharedSegment() = default;
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+    ~SharedSegment() { release(); }
+    
+    /**
+     * Map a published segment read-only; false if there is none (or it is unusable)
+     */
+    bool attach(const std::string& name, size_t size) {
+        path_ = "/dev/shm/" + name;
+        for (int attempt = 0; attempt < 3; attempt++) {
+            int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            
+            struct stat st;
+            if (flock(fd, LOCK_SH) != 0 || fstat(fd, &st) != 0) {
+                close(fd);
+                return false;
+            }
+            if (st.st_nlink == 0) {
+                close(fd);      // The last user unlinked it while we waited for the lock
+                continue;
+            }
+            if (st.st_uid != geteuid() || (uint64_t)st.st_size != size) {
+                close(fd);      // Not ours, or a different container
+                return false;
+            }
+            
+            void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                return false;
+            }
+            fd_ = fd;
+            data_ = static_cast<unsigned char*>(addr);
+            size_ = size;
+            return true;
+        }
+        return false;
+    }
+    
+    /**
+     * Create an unpublished, writable segment; nullptr if /dev/shm is not usable
+     * (space is reserved up front: a full tmpfs must fail here, not SIGBUS later)
+     */
+    unsigned char* create(const std::string& name, size_t size) {
+        path_ = "/dev/shm/" + name;
+        tmpPath_ = path_ + "." + std::to_string(getpid());
+        int fd = open(tmpPath_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            tmpPath_.clear();
+            return nullptr;
+        }
+        
+        void* addr = MAP_FAILED;
+        if (posix_fallocate(fd, 0, (off_t)size) == 0) {
+            addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (addr == MAP_FAILED) {
+            close(fd);
+            unlink(tmpPath_.c_str());
+            tmpPath_.clear();
+            return nullptr;
+        }
+        fd_ = fd;
+        data_ = static_cast<unsigned char*>(addr);
+        size_ = size;
+        return data_;
+    }
+    
+    /**
+     * Make a created segment visible to other instances (read-only from now on).
+     * If another instance published first, ours stays private to this process.
+     */
+    void publish() {
+        if (tmpPath_.empty()) return;
+        mprotect(data_, size_, PROT_READ);
+        flock(fd_, LOCK_SH);
+        bool linked = link(tmpPath_.c_str(), path_.c_str()) == 0;
+        unlink(tmpPath_.c_str());
+        tmpPath_.clear();
+        
+        #ifndef NDEBUG
+        std::cout << (linked ? " Published shared assets: " : " Shared assets already published: ")
+                  << path_ << std::endl;
+        #else
+        (void)linked;
+        #endif
+    }
+    
+    void release() {
+        if (fd_ < 0) return;
+        munmap(data_, size_);
+        if (!tmpPath_.empty()) {
+            unlink(tmpPath_.c_str());
+            tmpPath_.clear();
+        } else if (flock(fd_, LOCK_EX | LOCK_NB) == 0) {
+            // Last user: unlink, unless the name already belongs to a newer segment
+            struct stat mine, current;
+            if (fstat(fd_, &mine) == 0 && stat(path_.c_str(), &current) == 0 &&
+                mine.st_ino == current.st_ino && mine.st_dev == current.st_dev) {
+                unlink(path_.c_str());
+            }
+        }
+        close(fd_);
+        fd_ = -1;
+        data_ = nullptr;
+        size_ = 0;
+    }
+    
+    unsigned char* data() const { return data_; }
+    const std::string& path() const { return path_; }
+};
+#endif
+
 /**
  * Asset container
  */
@@ -141,10 +455,11 @@ public:
             return {
                 it->second.data.data(),
                 it->second.data.size(),
-                it->second.mimeType
+                it->second.mimeType,
+                ""
             };
         }
-        return { nullptr, 0, "" };
+        return { nullptr, 0, "", "" };
     }
     
     /**
@@ -163,131 +478,394 @@ public:
 };
 
 /**
- * Shared Asset Loader (from gemcore-assets file)
+ * Shared Asset Loader (from gemcore-assets file or an embedded region)
+ * 
+ * The container is memory-mapped and decrypted in place, so asset pointers
+ * stay valid for the lifetime of the loader.
  */
 class SharedAssetLoader {
+public:
+    enum VerifyMode {
+        VERIFY_OFF,
+        VERIFY_LAZY,    // Check each asset on first use (default)
+        VERIFY_FULL     // Check every asset at load, inside the decryption workers
+    };
+    
 private:
-    std::unordered_map<std::string, AssetData> assets_;
+    struct StoredAsset {
+        http::Asset asset;      // Points into the mapping (compressed if codec != RAW)
+        uint8_t codec;
+        uint64_t rawSize;
+        uint32_t blob;          // Index into blobs_ (shared by deduplicated aliases)
+    };
+    
+    // Distinct stored payloads (decrypted in place)
+    struct Blob {
+        unsigned char* data;
+        size_t size;
+        uint64_t hash;          // XXH64 from the GEMCORE3 TOC
+    };
+    
+    // Blob integrity state
+    enum : uint8_t { BLOB_UNCHECKED = 0, BLOB_OK = 1, BLOB_CORRUPTED = 2 };
+    
+    // Blob decryption state (only cold blobs of a profiled container start encrypted)
+    enum : uint8_t { BLOB_ENCRYPTED = 0, BLOB_DECRYPTING = 1, BLOB_DECRYPTED = 2 };
+    
+    std::unordered_map<std::string, StoredAsset> assets_;
+    const StoredAsset* configRecord_ = nullptr;  // Element pointers survive rehashing
+    MappedRegion region_;
+#ifdef __linux__
+    SharedSegment shared_;  // GEMCORE_SHARED_ASSETS=1
+#endif
+    
+    std::vector<Blob> blobs_;
+    std::unique_ptr<std::atomic<uint8_t>[]> blobState_;
+    bool hasHashes_ = false;
+    VerifyMode verifyMode_ = VERIFY_LAZY;
+    
+    // Access profile: cold blobs are decrypted in the background (or on first use)
+    std::unique_ptr<std::atomic<uint8_t>[]> blobCipher_;
+    std::unique_ptr<Keystream> keystream_;
+    mutable std::mutex cipherMutex_;
+    mutable std::condition_variable cipherCv_;
+    std::thread predecrypt_;
+    std::atomic<bool> stopPredecrypt_{false};
+    
+    // Inflated copies of compressed assets (filled on demand, never evicted).
+    // Keyed by blob, so deduplicated paths share one copy.
+    mutable std::mutex decodeMutex_;
+    mutable std::unordered_map<const unsigned char*, std::unique_ptr<std::string>> decoded_;
     
 public:
+    SharedAssetLoader() = default;
+    ~SharedAssetLoader() { stopPredecrypt(); }
+    
     /**
-     * Load from external gemcore-assets file (with XOR decryption!)
+     * Load assets (with XOR decryption!)
+     * 
+     * The single-file universal launcher passes the asset container as a region
+     * of its own executable through GEMCORE_ASSETS_FD / GEMCORE_ASSETS_OFFSET /
+     * GEMCORE_ASSETS_SIZE. Otherwise the gemcore-assets file next to the
+     * executable is used.
      */
     bool load() {
+        GEMCORE_TRACE_SCOPE("assets.load");
+        
+        const char* fdEnv = std::getenv("GEMCORE_ASSETS_FD");
+        const char* sizeEnv = std::getenv("GEMCORE_ASSETS_SIZE");
+        if (fdEnv && sizeEnv) {
+            const char* offsetEnv = std::getenv("GEMCORE_ASSETS_OFFSET");
+            int fd = std::atoi(fdEnv);
+            uint64_t offset = offsetEnv ? std::strtoull(offsetEnv, nullptr, 10) : 0;
+            uint64_t length = std::strtoull(sizeEnv, nullptr, 10);
+            
+#ifndef _WIN32
+            // The descriptor was inherited across exec on purpose; keep it and
+            // the variables pointing at it away from WebKit helpers and system()
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+            unsetenv("GEMCORE_ASSETS_FD");
+            unsetenv("GEMCORE_ASSETS_OFFSET");
+            unsetenv("GEMCORE_ASSETS_SIZE");
+#endif
+            
+            #ifndef NDEBUG
+            std::cout << " Mapping embedded assets (fd " << fd << ", offset " << offset
+                      << ", " << length << " bytes)" << std::endl;
+            #endif
+            
+            return loadFromRegion(fd, offset, length);
+        }
+        
         std::string execDir = getExecutableDir();
         std::string assetsPath = execDir + "/gemcore-assets";
         
-        std::ifstream file(assetsPath, std::ios::binary);
-        if (!file) {
+#ifdef _WIN32
+        int fd = _open(assetsPath.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        int fd = open(assetsPath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+        if (fd < 0) {
             std::cerr << " Failed to open gemcore-assets at: " << assetsPath << std::endl;
             return false;
         }
         
-        //  Read magic header (9 bytes: "GEMCORE1\0")
-        char magicHeader[9];
-        file.read(magicHeader, 9);
+#ifdef _WIN32
+        struct _stat64 st;
+        bool statOk = _fstat64(fd, &st) == 0;
+#else
+        struct stat st;
+        bool statOk = fstat(fd, &st) == 0;
+#endif
+        bool ok = statOk && loadFromRegion(fd, 0, (uint64_t)st.st_size);
         
-        if (std::memcmp(magicHeader, "GEMCORE1\0", 9) != 0) {
+        // The mapping keeps the file referenced, the descriptor is not needed anymore
+#ifdef _WIN32
+        _close(fd);
+#else
+        close(fd);
+#endif
+        return ok;
+    }
+    
+    /**
+     * Load from a region (fd, offset, length) of an already open file
+     * The region is mapped in place - nothing is copied to disk.
+     * A second load replaces the first one: Assets handed out before point
+     * into the old mapping and must not be used anymore.
+     */
+    bool loadFromRegion(int fd, uint64_t offset, uint64_t length) {
+        gemcore::trace::Span mapSpan("assets.map");
+        stopPredecrypt();
+        
+        // Everything below points into the previous mapping (decoded_ is keyed by blob address)
+        assets_.clear();
+        configRecord_ = nullptr;
+        blobs_.clear();
+        blobState_.reset();
+        blobCipher_.reset();
+        keystream_.reset();
+        hasHashes_ = false;
+        {
+            std::lock_guard<std::mutex> lock(decodeMutex_);
+            decoded_.clear();
+        }
+        #ifdef __linux__
+        shared_.release();
+        #endif
+        if (!region_.map(fd, offset, length)) {
+            std::cerr << " Failed to map gemcore-assets region (offset " << offset
+                      << ", " << length << " bytes)" << std::endl;
+            return false;
+        }
+        
+        mapSpan.end();
+        
+        unsigned char* base = region_.data();
+        const size_t total = region_.size();
+        size_t pos = 0;
+        
+        //  Read magic header (9 bytes: "GEMCORE1\0", "GEMCORE2\0" or "GEMCORE3\0")
+        hasHashes_ = total >= HEADER_V3_SIZE && std::memcmp(base, MAGIC_V3, MAGIC_SIZE) == 0;
+        bool hasToc = hasHashes_ || (total >= MAGIC_SIZE && std::memcmp(base, MAGIC_V2, MAGIC_SIZE) == 0);
+        if (total < HEADER_SIZE || (!hasToc && std::memcmp(base, MAGIC_V1, MAGIC_SIZE) != 0)) {
             std::cerr << " Invalid gemcore-assets file (wrong magic header)" << std::endl;
+            region_.unmap();
             return false;
         }
+        pos += 9;
         
         #ifndef NDEBUG
-        std::cout << " Encrypted assets detected" << std::endl;
+        std::cout << " Encrypted assets detected" << (hasHashes_ ? " (GEMCORE3)" : hasToc ? " (GEMCORE2)" : "") << std::endl;
         #endif
         
         //  Read encryption key (32 bytes)
         uint8_t encryptionKey[32];
-        file.read((char*)encryptionKey, 32);
+        std::memcpy(encryptionKey, base + pos, 32);
+        pos += 32;
         
         // Read file count
         uint32_t fileCount;
-        file.read((char*)&fileCount, 4);
+        std::memcpy(&fileCount, base + pos, 4);
+        pos += 4;
+        
+        // GEMCORE3: hash of the TOC entries (checked once the table is walked)
+        uint64_t tocHash = 0;
+        if (hasHashes_) {
+            std::memcpy(&tocHash, base + pos, 8);
+            pos += 8;
+        }
+        const size_t tocStart = pos;
         
         #ifndef NDEBUG
         std::cout << " Loading " << fileCount << " assets from gemcore-assets..." << std::endl;
         #endif
         
-        uint32_t loaded = 0;
-        uint32_t skipped = 0;
-        
         //  OPTIMIZATION: Pre-allocate assets map
         assets_.reserve(fileCount);
         
-        //  OPTIMIZATION: Load all assets first, then decrypt in parallel
-        std::vector<AssetData> tempAssets;
-        tempAssets.reserve(fileCount);
+        // PHASE 1: Walk the table (no copies - entries point into the mapping)
+        gemcore::trace::Span tocSpan("assets.toc");
+        struct Entry {
+            std::string path;
+            unsigned char* data;
+            size_t size;
+            uint8_t codec;
+            uint64_t rawSize;
+            uint64_t hash;
+        };
+        std::vector<Entry> entries;
+        entries.reserve(fileCount);
         
-        // PHASE 1: Sequential read from file (I/O bound)
         for (uint32_t i = 0; i < fileCount; i++) {
-            // Read path length
-            uint32_t pathLen;
-            file.read((char*)&pathLen, 4);
-            
-            if (!file) {
-                std::cerr << "  File stream error at asset " << i << "/" << fileCount << std::endl;
+            if (total - pos < 4) {
+                std::cerr << "  Truncated gemcore-assets at asset " << i << "/" << fileCount << std::endl;
                 break;
             }
             
-            if (pathLen == 0 || pathLen > 4096) {
+            // Read path length
+            uint32_t pathLen;
+            std::memcpy(&pathLen, base + pos, 4);
+            pos += 4;
+            
+            const size_t fieldsLen = hasHashes_ ? TOC_FIELDS_V3_SIZE : hasToc ? TOC_FIELDS_SIZE : 8;
+            if (pathLen == 0 || pathLen > 4096 || total - pos < (size_t)pathLen + fieldsLen) {
                 std::cerr << "  Invalid path length at asset " << i << ": " << pathLen << std::endl;
                 break;
             }
             
             // Read path
-            std::string path(pathLen, '\0');
-            file.read(&path[0], pathLen);
+            std::string path(reinterpret_cast<const char*>(base + pos), pathLen);
+            pos += pathLen;
+            
+            if (hasToc) {
+                // TOC entry: codec, offset, stored size, raw size
+                uint8_t codec = base[pos];
+                uint64_t dataOffset, storedSize, rawSize, hash = 0;
+                std::memcpy(&dataOffset, base + pos + 1, 8);
+                std::memcpy(&storedSize, base + pos + 9, 8);
+                std::memcpy(&rawSize, base + pos + 17, 8);
+                if (hasHashes_) std::memcpy(&hash, base + pos + 25, 8);
+                pos += fieldsLen;
+                
+                if (dataOffset > total || storedSize > total - dataOffset || codec > CODEC_GZIP) {
+                    std::cerr << "  Invalid TOC entry for " << path << std::endl;
+                    continue;
+                }
+                
+                entries.push_back({ std::move(path), base + dataOffset, static_cast<size_t>(storedSize), codec, rawSize, hash });
+                continue;
+            }
             
             // Read size (uint64)
             uint64_t size64;
-            file.read((char*)&size64, 8);
+            std::memcpy(&size64, base + pos, 8);
+            pos += 8;
             
-            if (!file) {
-                std::cerr << "  Failed to read size for " << path << std::endl;
+            if (size64 > total - pos) {
+                std::cerr << "  Truncated data for " << path << std::endl;
                 break;
             }
             
-            if (size64 > 100ULL * 1024 * 1024) {  // Max 100MB per file
-                std::cerr << "  File too large: " << path << " (" << (size64/1024/1024) << " MB, skipping)" << std::endl;
-                // Skip this file's data
-                file.seekg(size64, std::ios::cur);
-                skipped++;
-                continue;
+            entries.push_back({ std::move(path), base + pos, static_cast<size_t>(size64), CODEC_RAW, size64, 0 });
+            pos += static_cast<size_t>(size64);
+        }
+        
+        // A damaged TOC cannot be trusted for anything (offsets, sizes, hashes)
+        if (hasHashes_ && XXH64::hash(base + tocStart, pos - tocStart) != tocHash) {
+            std::cerr << " gemcore-assets is corrupted or truncated (TOC checksum mismatch)" << std::endl;
+            region_.unmap();
+            return false;
+        }
+        if (hasHashes_ && entries.size() != fileCount) {
+            std::cerr << " gemcore-assets is truncated (" << entries.size() << " of " << fileCount
+                      << " assets present)" << std::endl;
+            region_.unmap();
+            return false;
+        }
+        
+        // Deduplicated containers point several paths at one blob: decrypt every
+        // blob exactly once (a second XOR would scramble it again)
+        std::vector<uint32_t> entryBlob(entries.size());
+        blobs_.clear();
+        blobs_.reserve(entries.size());
+        {
+            std::unordered_map<unsigned char*, uint32_t> blobIndex;
+            blobIndex.reserve(entries.size());
+            for (size_t i = 0; i < entries.size(); i++) {
+                const Entry& entry = entries[i];
+                auto [it, inserted] = blobIndex.emplace(entry.data, (uint32_t)blobs_.size());
+                if (inserted) {
+                    blobs_.push_back({ entry.data, entry.size, entry.hash });
+                } else {
+                    // The keystream restarts per blob, so the longest alias covers the others
+                    blobs_[it->second].size = std::max(blobs_[it->second].size, entry.size);
+                }
+                entryBlob[i] = it->second;
             }
-            
-            // Read ENCRYPTED data (don't decrypt yet!)
-            AssetData asset;
-            asset.path = std::move(path);
-            asset.data.resize(static_cast<size_t>(size64));
-            file.read((char*)asset.data.data(), asset.data.size());
-            
-            if (!file) {
-                std::cerr << "  Failed to read data for " << asset.path << std::endl;
-                skipped++;
-                continue;
+        }
+        blobState_.reset(new std::atomic<uint8_t>[blobs_.size()]);
+        blobCipher_.reset(new std::atomic<uint8_t>[blobs_.size()]);  // Cold blobs are marked below
+        for (size_t i = 0; i < blobs_.size(); i++) {
+            blobState_[i].store(BLOB_UNCHECKED, std::memory_order_relaxed);
+            blobCipher_[i].store(BLOB_DECRYPTED, std::memory_order_relaxed);
+        }
+        
+        tocSpan.end();
+        
+        verifyMode_ = verifyModeFromEnv();
+        const bool verifyNow = hasHashes_ && verifyMode_ == VERIFY_FULL;
+        
+        // Shared segment: GEMCORE3 only (the TOC hash pins the content, so the
+        // header + TOC identify the bundle)
+        bool decrypted = false;
+        #ifdef __linux__
+        unsigned char* sharedBase = nullptr;
+        if (hasHashes_ && !entries.empty() && sharedAssetsFromEnv()) {
+            GEMCORE_TRACE_SCOPE("assets.share");
+            char name[32];
+            std::snprintf(name, sizeof(name), "gemcore-%016llx", (unsigned long long)XXH64::hash(base, pos, total));
+            if (shared_.attach(name, total)) {
+                sharedBase = shared_.data();
+                decrypted = true;
+                
+                #ifndef NDEBUG
+                std::cout << " Mapped shared decrypted assets: " << shared_.path() << std::endl;
+                #endif
+            } else if ((sharedBase = shared_.create(name, total))) {
+                std::memcpy(sharedBase, base, total);
+            }
+            if (sharedBase) {
+                for (auto& entry : entries) entry.data = sharedBase + (entry.data - base);
+                for (auto& blob : blobs_) blob.data = sharedBase + (blob.data - base);
             }
-            
-            tempAssets.push_back(std::move(asset));
-            loaded++;
         }
+        #endif
         
-        file.close();
+        keystream_.reset(new Keystream(encryptionKey));
         
-        // PHASE 2: Parallel decryption (CPU bound)
-        if (!tempAssets.empty()) {
+        // Access profile: decrypt the hot blobs now, the cold ones in the background.
+        // Not with a shared segment (published whole) or full verification (checks all now).
+        std::vector<uint32_t> cold;
+        size_t hotEnd = total;
+        bool sharedBlobs = false;
+        #ifdef __linux__
+        sharedBlobs = sharedBase != nullptr;
+        #endif
+        if (hasToc && !sharedBlobs && !verifyNow) {
+            hotEnd = splitByProfile(entries, entryBlob, base, cold);
+        }
+        
+        // Profile: read the hot prefix ahead, the cold rest from the background thread.
+        // (Not for a full pass: the sequential faults get kernel read-ahead already, and
+        // madvise() over a whole large container measured slower than none.)
+        if (hotEnd < total) {
+            region_.prefetch(0, hotEnd);
+        }
+        
+        // PHASE 2: Parallel in-place decryption (CPU bound, copy-on-write pages)
+        // In full verify mode each blob is hashed right after decryption, while hot in cache.
+        // A mapped shared segment is already decrypted (only hashed in full verify mode).
+        if (!entries.empty()) {
+            const Keystream& keystream = *keystream_;
             const size_t numThreads = std::min<size_t>(
-                std::thread::hardware_concurrency(),
-                std::max<size_t>(1, tempAssets.size() / 50)  // At least 50 assets per thread
+                std::max<size_t>(1, std::thread::hardware_concurrency()),
+                std::max<size_t>(1, (blobs_.size() - cold.size()) / 50)  // At least 50 assets per thread
             );
             
-            if (numThreads > 1) {
+            if (decrypted && !verifyNow) {
+                // Nothing to do
+            } else if (numThreads > 1) {
                 std::vector<std::thread> workers;
                 workers.reserve(numThreads);
                 
                 for (size_t t = 0; t < numThreads; t++) {
-                    workers.emplace_back([&tempAssets, &encryptionKey, t, numThreads]() {
-                        for (size_t i = t; i < tempAssets.size(); i += numThreads) {
-                            xorDecrypt(tempAssets[i].data.data(), tempAssets[i].data.size(), encryptionKey, 32);
+                    workers.emplace_back([this, &keystream, decrypted, verifyNow, t, numThreads]() {
+                        GEMCORE_TRACE_SCOPE("assets.decrypt");
+                        for (size_t i = t; i < blobs_.size(); i += numThreads) {
+                            if (blobCipher_[i].load(std::memory_order_relaxed) == BLOB_ENCRYPTED) continue;  // Cold
+                            if (!decrypted) keystream.apply(blobs_[i].data, blobs_[i].size);
+                            if (verifyNow) checkBlob(i);
                         }
                     });
                 }
@@ -297,41 +875,144 @@ public:
                 }
             } else {
                 // Single-threaded fallback
-                for (auto& asset : tempAssets) {
-                    xorDecrypt(asset.data.data(), asset.data.size(), encryptionKey, 32);
+                GEMCORE_TRACE_SCOPE("assets.decrypt");
+                for (size_t i = 0; i < blobs_.size(); i++) {
+                    if (blobCipher_[i].load(std::memory_order_relaxed) == BLOB_ENCRYPTED) continue;  // Cold
+                    if (!decrypted) keystream.apply(blobs_[i].data, blobs_[i].size);
+                    if (verifyNow) checkBlob(i);
                 }
             }
             
-            // PHASE 3: Move to final map with MIME types
-            for (auto& asset : tempAssets) {
-                asset.mimeType = http::getMimeType(asset.path);
-                assets_[asset.path] = std::move(asset);
+            // PHASE 3: Index with MIME types (compressed assets are inflated on demand)
+            GEMCORE_TRACE_SCOPE("assets.index");
+            for (size_t i = 0; i < entries.size(); i++) {
+                Entry& entry = entries[i];
+                std::string mimeType = http::getMimeType(entry.path);
+                std::string encoding = entry.codec == CODEC_GZIP ? "gzip" : "";
+                assets_[std::move(entry.path)] = {
+                    { entry.data, entry.size, std::move(mimeType), std::move(encoding) },
+                    entry.codec,
+                    entry.rawSize,
+                    entryBlob[i]
+                };
+            }
+            
+            if (verifyNow) {
+                reportCorrupted();
             }
         }
         
+        #ifdef __linux__
+        if (sharedBase) {
+            shared_.publish();  // No-op if we mapped an existing segment
+            region_.unmap();    // Every asset lives in the segment now
+        }
+        #endif
+        
+        auto configIt = assets_.find(config::RECORD_PATH);
+        configRecord_ = configIt != assets_.end() && configIt->second.codec == CODEC_RAW ? &configIt->second : nullptr;
+        
+        if (!cold.empty()) {
+            predecrypt_ = std::thread([this, cold = std::move(cold), hotEnd]() {
+                gemcore::trace::setThreadName("asset-predecrypt");
+                GEMCORE_TRACE_SCOPE("assets.predecrypt");
+                region_.prefetch(hotEnd, region_.size() - hotEnd);
+                for (uint32_t i : cold) {
+                    if (stopPredecrypt_.load(std::memory_order_relaxed)) break;
+                    ensureDecrypted(i);
+                }
+            });
+        }
+        
         #ifndef NDEBUG
-        if (skipped > 0) {
-            std::cout << "  Skipped " << skipped << " assets" << std::endl;
+        if (entries.size() < fileCount) {
+            std::cout << "  Skipped " << (fileCount - entries.size()) << " assets" << std::endl;
+        }
+        std::cout << " Loaded " << assets_.size() << " shared assets";
+        if (blobs_.size() < entries.size()) {
+            std::cout << " (" << (entries.size() - blobs_.size()) << " deduplicated)";
         }
-        std::cout << " Loaded " << assets_.size() << " shared assets" << std::endl;
+        std::cout << std::endl;
         #endif
         
         return true;
     }
     
     /**
-     * Get asset by path
+     * Get asset by path (always uncompressed)
+     * Compressed assets are inflated on first access; concurrent callers for
+     * different assets decode in parallel.
      */
     http::Asset getAsset(const std::string& path) const {
+        auto it = assets_.find(path);
+        if (it == assets_.end()) {
+            return { nullptr, 0, "", "" };
+        }
+        
+        const StoredAsset& stored = it->second;
+        ensureDecrypted(stored.blob);
+        if (!verifyBlob(stored.blob)) {
+            std::cerr << " Corrupted asset (hash mismatch): " << path << std::endl;
+            return { nullptr, 0, "", "" };
+        }
+        if (stored.codec == CODEC_RAW) {
+            return stored.asset;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(decodeMutex_);
+            auto dit = decoded_.find(stored.asset.data);
+            if (dit != decoded_.end()) {
+                return { reinterpret_cast<const unsigned char*>(dit->second->data()),
+                         dit->second->size(), stored.asset.mimeType, "" };
+            }
+        }
+        
+        // Decode outside the lock
+        GEMCORE_TRACE_SCOPE("assets.inflate", path.c_str());
+        auto inflated = std::make_unique<std::string>();
+        if (!inflateGzip(stored.asset.data, stored.asset.size, stored.rawSize, *inflated)) {
+            std::cerr << " Failed to decompress asset: " << path << std::endl;
+            return { nullptr, 0, "", "" };
+        }
+        
+        std::lock_guard<std::mutex> lock(decodeMutex_);
+        auto& slot = decoded_[stored.asset.data];
+        if (!slot) slot = std::move(inflated);  // Another thread may have won
+        return { reinterpret_cast<const unsigned char*>(slot->data()),
+                 slot->size(), stored.asset.mimeType, "" };
+    }
+    
+    /**
+     * Get asset as stored in the container (contentEncoding is set when the
+     * payload is compressed) - lets the HTTP server pass it through untouched.
+     * Not verified (nor necessarily decrypted yet with an access profile): the
+     * server calls verifyAsset() on first request, which does both.
+     */
+    http::Asset getStoredAsset(const std::string& path) const {
         auto it = assets_.find(path);
         if (it != assets_.end()) {
-            return {
-                it->second.data.data(),
-                it->second.data.size(),
-                it->second.mimeType
-            };
+            return it->second.asset;
+        }
+        return { nullptr, 0, "", "" };
+    }
+    
+    /**
+     * Binary launcher config (see gemcore-config-record.h), verified like any
+     * other asset. False if the container has none (older packer) or it is damaged.
+     */
+    bool getConfigRecord(config::Record& record) const {
+        if (!configRecord_) return false;
+        ensureDecrypted(configRecord_->blob);
+        if (!verifyBlob(configRecord_->blob)) {
+            std::cerr << " Corrupted asset (hash mismatch): " << config::RECORD_PATH << std::endl;
+            return false;
         }
-        return { nullptr, 0, "" };
+        if (!record.parse(configRecord_->asset.data, configRecord_->asset.size)) {
+            std::cerr << " Unsupported or damaged config record: " << config::RECORD_PATH << std::endl;
+            return false;
+        }
+        return true;
     }
     
     /**
@@ -346,7 +1027,192 @@ public:
         return paths;
     }
     
+    /**
+     * Lazy integrity check of one asset (hashed on first call, then cached).
+     * Always true for GEMCORE1/2 containers or with GEMCORE_VERIFY_ASSETS=off.
+     * Decrypts the asset first if the background thread has not reached it yet.
+     */
+    bool verifyAsset(const std::string& path) const {
+        auto it = assets_.find(path);
+        if (it == assets_.end()) return false;
+        ensureDecrypted(it->second.blob);
+        return verifyBlob(it->second.blob);
+    }
+    
+    /**
+     * Check every asset now, in parallel (--verify). Prints corrupted paths.
+     */
+    bool verifyAll() const {
+        if (!hasHashes_) {
+            std::cout << " gemcore-assets has no integrity hashes (GEMCORE1/2), repack with gemcore-pack" << std::endl;
+            return true;
+        }
+        
+        GEMCORE_TRACE_SCOPE("assets.verify");
+        auto start = std::chrono::steady_clock::now();
+        const size_t numThreads = std::min<size_t>(
+            std::max<size_t>(1, std::thread::hardware_concurrency()),
+            std::max<size_t>(1, blobs_.size())
+        );
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < numThreads; t++) {
+            workers.emplace_back([this, &next]() {
+                size_t i;
+                while ((i = next++) < blobs_.size()) {
+                    ensureDecrypted((uint32_t)i);
+                    if (blobState_[i].load(std::memory_order_acquire) == BLOB_UNCHECKED) checkBlob(i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        uint64_t bytes = 0;
+        for (const auto& blob : blobs_) {
+            bytes += blob.size;
+        }
+        size_t corrupted = reportCorrupted();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << " Verified " << assets_.size() << " assets (" << (bytes / (1024 * 1024)) << " MB) in "
+                  << ms << " ms: " << (corrupted == 0 ? "OK" : std::to_string(corrupted) + " corrupted") << std::endl;
+        return corrupted == 0;
+    }
+    
     size_t size() const { return assets_.size(); }
+    
+private:
+    static VerifyMode verifyModeFromEnv() {
+        const char* mode = std::getenv("GEMCORE_VERIFY_ASSETS");
+        if (!mode) return VERIFY_LAZY;
+        if (std::strcmp(mode, "off") == 0 || std::strcmp(mode, "0") == 0) return VERIFY_OFF;
+        if (std::strcmp(mode, "full") == 0) return VERIFY_FULL;
+        return VERIFY_LAZY;
+    }
+    
+#ifdef __linux__
+    static bool sharedAssetsFromEnv() {
+        const char* mode = std::getenv("GEMCORE_SHARED_ASSETS");
+        return mode && std::strcmp(mode, "1") == 0;
+    }
+#endif
+    
+    /**
+     * Mark the blobs not listed in the container's access profile as cold.
+     * Returns the end of the hot prefix (everything if there is no profile);
+     * `cold` gets the cold blobs in layout order.
+     */
+    template <typename Entries>
+    size_t splitByProfile(const Entries& entries, const std::vector<uint32_t>& entryBlob,
+                          const unsigned char* base, std::vector<uint32_t>& cold) {
+        size_t profile = entries.size();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].path == PROFILE_PATH && entries[i].codec == CODEC_RAW) profile = i;
+        }
+        if (profile == entries.size()) return region_.size();
+        
+        // Decrypted into a copy: the blob itself is decrypted with the other hot ones
+        const Blob& blob = blobs_[entryBlob[profile]];
+        std::string list(reinterpret_cast<const char*>(blob.data), blob.size);
+        keystream_->apply(reinterpret_cast<uint8_t*>(&list[0]), list.size());
+        const char* text = list.data();
+        const size_t headerLen = sizeof(PROFILE_HEADER) - 1;
+        if (list.size() < headerLen || std::memcmp(text, PROFILE_HEADER, headerLen) != 0) {
+            return region_.size();  // Unknown profile layout: decrypt everything now
+        }
+        
+        std::unordered_map<std::string, uint32_t> blobByPath;
+        blobByPath.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            blobByPath.emplace(entries[i].path, entryBlob[i]);
+        }
+        
+        // The profile entry and the listed blobs are hot, everything else is cold
+        std::vector<uint8_t> hot(blobs_.size(), 0);
+        hot[entryBlob[profile]] = 1;
+        size_t hotEnd = (size_t)(blob.data + blob.size - base);
+        for (size_t pos = headerLen; pos < list.size();) {
+            const char* eol = static_cast<const char*>(std::memchr(text + pos, '\n', list.size() - pos));
+            size_t len = eol ? (size_t)(eol - (text + pos)) : list.size() - pos;
+            auto it = blobByPath.find(std::string(text + pos, len));
+            if (it != blobByPath.end()) {
+                hot[it->second] = 1;
+                hotEnd = std::max(hotEnd, (size_t)(blobs_[it->second].data + blobs_[it->second].size - base));
+            }
+            pos += len + 1;
+        }
+        
+        for (uint32_t i = 0; i < blobs_.size(); i++) {
+            if (!hot[i]) {
+                blobCipher_[i].store(BLOB_ENCRYPTED, std::memory_order_relaxed);
+                cold.push_back(i);
+            }
+        }
+        std::sort(cold.begin(), cold.end(), [this](uint32_t a, uint32_t b) { return blobs_[a].data < blobs_[b].data; });
+        
+        #ifndef NDEBUG
+        std::cout << " Access profile: " << (blobs_.size() - cold.size()) << " hot assets ("
+                  << (hotEnd / 1024) << " KB) decrypted now, " << cold.size() << " in the background" << std::endl;
+        #endif
+        return hotEnd;
+    }
+    
+    /**
+     * Make sure a blob is decrypted: claims and decrypts it, or waits for the
+     * thread that claimed it (every blob is XOR'd exactly once)
+     */
+    void ensureDecrypted(uint32_t i) const {
+        if (blobCipher_[i].load(std::memory_order_acquire) == BLOB_DECRYPTED) return;
+        
+        uint8_t expected = BLOB_ENCRYPTED;
+        if (blobCipher_[i].compare_exchange_strong(expected, BLOB_DECRYPTING, std::memory_order_acquire)) {
+            keystream_->apply(blobs_[i].data, blobs_[i].size);
+            {
+                std::lock_guard<std::mutex> lock(cipherMutex_);
+                blobCipher_[i].store(BLOB_DECRYPTED, std::memory_order_release);
+            }
+            cipherCv_.notify_all();
+            return;
+        }
+        
+        std::unique_lock<std::mutex> lock(cipherMutex_);
+        cipherCv_.wait(lock, [this, i]() { return blobCipher_[i].load(std::memory_order_acquire) == BLOB_DECRYPTED; });
+    }
+    
+    void stopPredecrypt() {
+        if (!predecrypt_.joinable()) return;
+        stopPredecrypt_.store(true, std::memory_order_relaxed);
+        predecrypt_.join();
+        stopPredecrypt_.store(false, std::memory_order_relaxed);
+    }
+    
+    // Hash one (decrypted) blob and record the result
+    bool checkBlob(size_t i) const {
+        bool ok = XXH64::hash(blobs_[i].data, blobs_[i].size) == blobs_[i].hash;
+        blobState_[i].store(ok ? BLOB_OK : BLOB_CORRUPTED, std::memory_order_release);
+        return ok;
+    }
+    
+    bool verifyBlob(uint32_t i) const {
+        if (!hasHashes_ || verifyMode_ == VERIFY_OFF) return true;
+        
+        // Racing first users may both hash: same result, no lock needed
+        uint8_t state = blobState_[i].load(std::memory_order_acquire);
+        if (state == BLOB_UNCHECKED) return checkBlob(i);
+        return state == BLOB_OK;
+    }
+    
+    size_t reportCorrupted() const {
+        size_t corrupted = 0;
+        for (const auto& kv : assets_) {
+            if (blobState_[kv.second.blob].load(std::memory_order_acquire) == BLOB_CORRUPTED) {
+                std::cerr << " Corrupted asset (hash mismatch): " << kv.first << std::endl;
+                corrupted++;
+            }
+        }
+        return corrupted;
+    }
 };
 
 } // namespace assets
@@ -0,0 +1,543 @@
+/**
+ *  Gemcore Binding JSON - SHARED BY ALL LAUNCHERS
+ *
+ * Fast path for webview bindings. webview hands a bound function its arguments
+ * as one JSON array string and expects a JSON string back; going through a
+ * JSON DOM for that (parse, get<>, json(result).dump()) allocates on every
+ * call and costs more than most of the calls it wraps.
+ *
+ * ArgReader decodes positional arguments straight from the request string:
+ * no DOM and no allocations, except for decoded strings growing their buffer.
+ * Writer appends results to a reusable string (integers via std::to_chars).
+ * call() ties both to a typed function:
+ *
+ *   std::string result;
+ *   gemcore::bindjson::ArgReader in(req);
+ *   gemcore::bindjson::Writer out(result);
+ *   bool ok = gemcore::bindjson::call<std::string, int32_t>(in, out, [](const std::string& name, int32_t value) {
+ *       return SteamworksManager::SetStatInt(name, value);
+ *   });
+ *   if (!ok) result = "false";  // Missing or mistyped arguments
+ *
+ * Covers what bindings exchange: arrays, strings, numbers, booleans and null
+ * (objects can be skipped, not read). A mistyped value is skipped and its
+ * read() returns false; malformed JSON stops the reader (ok() == false).
+ */
+
+#ifndef GEMCORE_BIND_JSON_H
+#define GEMCORE_BIND_JSON_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gemcore {
+namespace bindjson {
+
+static const int MAX_DEPTH = 8;
+
+/**
+ * Sequential reader over a JSON array (the bound function's argument list)
+ */
+class ArgReader {
+public:
+    explicit ArgReader(std::string_view json)
+        : p_(json.data()), end_(json.data() + json.size()) {
+        enter();
+    }
+
+    bool ok() const {
+        return ok_;
+    }
+
+    /**
+     * Move to the next element of the current array; false at its end
+     */
+    bool next() {
+        skipSpace();
+        if (!ok_ || p_ == end_ || *p_ == ']') return false;
+        if (!first_[depth_]) {
+            if (*p_ != ',') return fail();
+            p_++;
+            skipSpace();
+        }
+        first_[depth_] = false;
+        return p_ != end_ || fail();
+    }
+
+    /**
+     * True if the current array has no further elements
+     */
+    bool atEnd() {
+        skipSpace();
+        return !ok_ || p_ == end_ || *p_ == ']';
+    }
+
+    /**
+     * True if the value at the current position (after next()) is an array
+     */
+    bool isArray() {
+        skipSpace();
+        return ok_ && p_ != end_ && *p_ == '[';
+    }
+
+    /**
+     * Descend into the array at the current position (after next())
+     */
+    bool enter() {
+        skipSpace();
+        if (!ok_ || p_ == end_ || *p_ != '[' || depth_ + 1 >= MAX_DEPTH) return fail();
+        p_++;
+        first_[++depth_] = true;
+        return true;
+    }
+
+    /**
+     * Skip what is left of the current array and return to its parent
+     */
+    bool leave() {
+        while (next()) skipValue();
+        if (!ok_ || p_ == end_ || *p_ != ']' || depth_ == 0) return fail();
+        p_++;
+        depth_--;
+        return true;
+    }
+
+    /**
+     * Read the next element as T: bool, an integer or floating-point type,
+     * std::string, or a std::vector of those
+     */
+    template<typename T>
+    bool read(T& out) {
+        return next() && value(out);
+    }
+
+    /**
+     * read(), except that a missing trailing argument keeps `out` as it is
+     */
+    template<typename T>
+    bool optional(T& out) {
+        return atEnd() ? ok_ : read(out);
+    }
+
+    /**
+     * Skip the value at the current position (after next())
+     */
+    bool skipValue() {
+        skipSpace();
+        if (!ok_ || p_ == end_) return fail();
+        if (*p_ == '"') return skipString();
+        if (*p_ == '[' || *p_ == '{') {
+            int nesting = 0;
+            while (p_ != end_) {
+                char c = *p_;
+                if (c == '"') {
+                    if (!skipString()) return false;
+                    continue;
+                }
+                p_++;
+                if (c == '[' || c == '{') nesting++;
+                if ((c == ']' || c == '}') && --nesting == 0) return true;
+            }
+            return fail();
+        }
+        const char* start = p_;
+        while (p_ != end_ && *p_ != ',' && *p_ != ']' && *p_ != '}' && !isSpace(*p_)) p_++;
+        return p_ != start || fail();
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+    int depth_ = -1;
+    bool first_[MAX_DEPTH] = {};
+    bool ok_ = true;
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    void skipSpace() {
+        while (p_ != end_ && isSpace(*p_)) p_++;
+    }
+
+    bool fail() {
+        ok_ = false;
+        return false;
+    }
+
+    // A value of the wrong type: skip it, the reader stays usable
+    bool mismatch() {
+        skipValue();
+        return false;
+    }
+
+    bool value(bool& out) {
+        if (end_ - p_ >= 4 && std::memcmp(p_, "true", 4) == 0) {
+            p_ += 4;
+            out = true;
+            return true;
+        }
+        if (end_ - p_ >= 5 && std::memcmp(p_, "false", 5) == 0) {
+            p_ += 5;
+            out = false;
+            return true;
+        }
+        return mismatch();
+    }
+
+    template<typename T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, bool> value(T& out) {
+        auto result = std::from_chars(p_, end_, out);
+        if (result.ec == std::errc() && (result.ptr == end_ || (*result.ptr != '.' && *result.ptr != 'e' && *result.ptr != 'E'))) {
+            p_ = result.ptr;
+            return true;
+        }
+        // 3.0 or 1e3: truncated, as a JSON DOM's get<int>() would
+        double number;
+        if (!parseNumber(number)) return mismatch();
+        // (parenthesized: windows.h defines min/max macros)
+        if (!(number >= static_cast<double>((std::numeric_limits<T>::min)()) &&
+              number <= static_cast<double>((std::numeric_limits<T>::max)()))) {
+            return false;
+        }
+        out = static_cast<T>(number);
+        return true;
+    }
+
+    template<typename T>
+    std::enable_if_t<std::is_floating_point_v<T>, bool> value(T& out) {
+        double number;
+        if (!parseNumber(number)) return mismatch();
+        out = static_cast<T>(number);
+        return true;
+    }
+
+    bool value(std::string& out) {
+        if (*p_ != '"') return mismatch();
+        p_++;
+        out.clear();
+        while (p_ != end_) {
+            const char* run = p_;
+            while (p_ != end_ && *p_ != '"' && *p_ != '\\') p_++;
+            out.append(run, p_ - run);
+            if (p_ == end_) break;
+            if (*p_++ == '"') return true;
+            if (p_ == end_) break;
+            char escape = *p_++;
+            switch (escape) {
+                case '"': case '\\': case '/': out += escape; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (!hex4(code)) return fail();
+                    // Surrogate pair -> one code point
+                    if (code >= 0xD800 && code < 0xDC00 && end_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u') {
+                        p_ += 2;
+                        uint32_t low;
+                        if (!hex4(low)) return fail();
+                        code = (low >= 0xDC00 && low < 0xE000) ? 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00) : 0xFFFD;
+                    } else if (code >= 0xD800 && code < 0xE000) {
+                        code = 0xFFFD;
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: return fail();
+            }
+        }
+        return fail();
+    }
+
+    template<typename T>
+    bool value(std::vector<T>& out) {
+        if (*p_ != '[') return mismatch();
+        out.clear();
+        enter();
+        bool typed = true;
+        while (next()) {
+            out.emplace_back();
+            typed &= value(out.back());
+        }
+        return leave() && typed;
+    }
+
+    bool skipString() {
+        p_++;
+        while (p_ != end_) {
+            char c = *p_++;
+            if (c == '"') return true;
+            if (c == '\\' && p_ != end_) p_++;
+        }
+        return fail();
+    }
+
+    bool hex4(uint32_t& out) {
+        if (end_ - p_ < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = *p_++;
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= c - '0';
+            else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    /**
+     * JSON number -> double (locale-independent, unlike strtod; floating-point
+     * from_chars is missing from older libc++). Exact for integers up to 2^53,
+     * otherwise within an ulp or two, which is plenty for arguments.
+     */
+    bool parseNumber(double& out) {
+        const char* q = p_;
+        bool negative = q != end_ && *q == '-';
+        if (negative) q++;
+        if (q == end_ || *q < '0' || *q > '9') return false;
+
+        double mantissa = 0;
+        int exponent = 0;
+        for (; q != end_ && *q >= '0' && *q <= '9'; q++) mantissa = mantissa * 10 + (*q - '0');
+        if (q != end_ && *q == '.') {
+            q++;
+            if (q == end_ || *q < '0' || *q > '9') return false;
+            for (; q != end_ && *q >= '0' && *q <= '9'; q++) {
+                mantissa = mantissa * 10 + (*q - '0');
+                exponent--;
+            }
+        }
+        if (q != end_ && (*q == 'e' || *q == 'E')) {
+            q++;
+            bool negativeExponent = q != end_ && *q == '-';
+            if (q != end_ && (*q == '-' || *q == '+')) q++;
+            if (q == end_ || *q < '0' || *q > '9') return false;
+            int e = 0;
+            for (; q != end_ && *q >= '0' && *q <= '9'; q++) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+            }
+            exponent += negativeExponent ? -e : e;
+        }
+        out = exponent == 0 ? mantissa : mantissa * std::pow(10.0, exponent);
+        if (negative) out = -out;
+        p_ = q;
+        return true;
+    }
+};
+
+/**
+ * Appends JSON values to a string, separating array elements itself
+ * The string is cleared on construction and its capacity reused.
+ */
+class Writer {
+public:
+    explicit Writer(std::string& out) : out_(out) {
+        out_.clear();
+    }
+
+    /**
+     * Arrays nested deeper than MAX_DEPTH are written as null (contents dropped)
+     */
+    void beginArray() {
+        if (skipped_ || depth_ + 1 >= MAX_DEPTH) {
+            if (!skipped_) null();
+            skipped_++;
+            return;
+        }
+        separate();
+        out_ += '[';
+        needComma_[++depth_] = false;
+    }
+
+    void endArray() {
+        if (skipped_) {
+            skipped_--;
+            return;
+        }
+        out_ += ']';
+        depth_--;
+    }
+
+    void null() {
+        raw("null");
+    }
+
+    /**
+     * A value that already is JSON text
+     */
+    void raw(std::string_view json) {
+        if (skipped_) return;
+        separate();
+        out_.append(json.data(), json.size());
+    }
+
+    void value(bool v) {
+        raw(v ? "true" : "false");
+    }
+
+    template<typename T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>> value(T v) {
+        if (skipped_) return;
+        separate();
+        char buf[24];
+        auto result = std::to_chars(buf, buf + sizeof(buf), v);
+        out_.append(buf, result.ptr - buf);
+    }
+
+    void value(const char* v) {
+        value(std::string_view(v ? v : ""));
+    }
+
+    void value(const std::string& v) {
+        value(std::string_view(v));
+    }
+
+    /**
+     * Quoted and escaped; invalid UTF-8 is replaced with U+FFFD
+     */
+    void value(std::string_view v) {
+        if (skipped_) return;
+        separate();
+        out_ += '"';
+        const auto* s = reinterpret_cast<const unsigned char*>(v.data());
+        const auto* end = s + v.size();
+        while (s != end) {
+            const auto* run = s;
+            while (s != end && *s >= 0x20 && *s < 0x80 && *s != '"' && *s != '\\') s++;
+            out_.append(reinterpret_cast<const char*>(run), s - run);
+            if (s == end) break;
+
+            unsigned char c = *s;
+            if (c == '"' || c == '\\') {
+                out_ += '\\';
+                out_ += static_cast<char>(c);
+                s++;
+            } else if (c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                const char escape[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                out_.append(escape, sizeof(escape));
+                s++;
+            } else {
+                size_t length = utf8Length(s, end);
+                if (length) {
+                    out_.append(reinterpret_cast<const char*>(s), length);
+                    s += length;
+                } else {
+                    out_ += "\xEF\xBF\xBD";
+                    s++;
+                }
+            }
+        }
+        out_ += '"';
+    }
+
+    template<typename T>
+    void value(const std::vector<T>& v) {
+        beginArray();
+        for (const auto& element : v) value(element);
+        endArray();
+    }
+
+    /**
+     * Position to return to if a value has to be replaced (see rewind)
+     */
+    struct Mark {
+        size_t size;
+        int depth;
+        bool needComma;
+        int skipped;
+    };
+
+    Mark mark() const {
+        return Mark{out_.size(), depth_, depth_ >= 0 && needComma_[depth_], skipped_};
+    }
+
+    void rewind(const Mark& m) {
+        out_.resize(m.size);
+        depth_ = m.depth;
+        skipped_ = m.skipped;
+        if (depth_ >= 0) needComma_[depth_] = m.needComma;
+    }
+
+private:
+    std::string& out_;
+    int depth_ = -1;
+    bool needComma_[MAX_DEPTH] = {};
+    int skipped_ = 0;  // Open arrays beyond MAX_DEPTH
+
+    void separate() {
+        if (depth_ < 0) return;
+        if (needComma_[depth_]) out_ += ',';
+        needComma_[depth_] = true;
+    }
+
+    // Length of the valid UTF-8 sequence at s, 0 if it is not one
+    static size_t utf8Length(const unsigned char* s, const unsigned char* end) {
+        unsigned char c = s[0];
+        size_t length;
+        uint32_t min;
+        if (c >= 0xC2 && c <= 0xDF) { length = 2; min = 0x80; }
+        else if (c >= 0xE0 && c <= 0xEF) { length = 3; min = 0x800; }
+        else if (c >= 0xF0 && c <= 0xF4) { length = 4; min = 0x10000; }
+        else return 0;
+        if (static_cast<size_t>(end - s) < length) return 0;
+
+        uint32_t code = c & (0x3F >> (length - 1));
+        for (size_t i = 1; i < length; i++) {
+            if ((s[i] & 0xC0) != 0x80) return 0;
+            code = (code << 6) | (s[i] & 0x3F);
+        }
+        if (code < min || code > 0x10FFFF || (code >= 0xD800 && code < 0xE000)) return 0;
+        return length;
+    }
+};
+
+/**
+ * Read Args... from `in`, call `fn` with them and write its result
+ * Returns false (writing nothing) if an argument is missing or mistyped.
+ * The decoded arguments live in per-call-site thread_local storage, so
+ * string arguments reuse their buffers instead of allocating on every call.
+ */
+template<typename... Args, typename Fn>
+bool call(ArgReader& in, Writer& out, Fn&& fn) {
+    static thread_local std::tuple<std::decay_t<Args>...> args;
+    bool ok = std::apply([&in](auto&... arg) { return (in.read(arg) && ...); }, args);
+    if (!ok) return false;
+    out.value(std::apply(fn, args));
+    return true;
+}
+
+} // namespace bindjson
+} // namespace gemcore
+
+#endif // GEMCORE_BIND_JSON_H
@@ -0,0 +1,153 @@
+/**
+ *  Gemcore Config Record - SHARED BY ALL LAUNCHERS
+ *
+ * gemcore.config.json stays the authoring format; the build compiles it into a
+ * compact binary record (scripts/config-record.ts) that is packed into the
+ * asset container as the raw entry RECORD_PATH. Launchers decode it in place:
+ * no JSON parser, no allocations, unknown fields are skipped.
+ *
+ * Layout (all integers little-endian):
+ *   "GCFG", u16 version, u16 fieldCount,
+ *   fieldCount x { u16 id, u16 size, payload }
+ * Payloads: strings are UTF-8 (no terminator), integers u32/i32, flags u8.
+ * New fields get new ids (old launchers skip them); `version` only changes
+ * for incompatible layouts.
+ */
+
+#ifndef GEMCORE_CONFIG_RECORD_H
+#define GEMCORE_CONFIG_RECORD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace gemcore {
+namespace config {
+
+static const char RECORD_PATH[] = ".gemcore-config.bin";
+static const char RECORD_MAGIC[4] = { 'G','C','F','G' };
+static const uint16_t RECORD_VERSION = 1;
+static const size_t RECORD_HEADER_SIZE = 8;
+
+/**
+ * Field ids (never reuse or renumber - keep in sync with scripts/config-record.ts)
+ * Aliases are resolved at build time: window.startFullscreen is folded into
+ * WINDOW_FULLSCREEN and a root "entrypoint" into APP_ENTRYPOINT.
+ */
+enum FieldId : uint16_t {
+    WINDOW_TITLE = 1,
+    WINDOW_WIDTH = 2,
+    WINDOW_HEIGHT = 3,
+    WINDOW_FULLSCREEN = 4,
+    WINDOW_RESIZABLE = 5,
+    WINDOW_ALWAYS_ON_TOP = 6,
+    WINDOW_FRAMELESS = 7,
+    WINDOW_MIN_WIDTH = 8,
+    WINDOW_MIN_HEIGHT = 9,
+
+    APP_NAME = 32,
+    APP_VERSION = 33,
+    APP_ENTRYPOINT = 34,
+    APP_ICON = 35,
+    APP_ICON_PNG = 36,
+    APP_DEBUG = 37,
+    APP_SPLASH = 38,
+
+    STEAM_ENABLED = 64,
+    STEAM_APP_ID = 65,
+    STEAM_STORE_STATS_DELAY_MS = 66,
+    STEAM_LEADERBOARD_CACHE_MS = 67
+};
+
+/**
+ * One field (points into the record)
+ */
+struct Field {
+    uint16_t id = 0;
+    const unsigned char* data = nullptr;
+    uint16_t size = 0;
+
+    std::string_view str() const {
+        return std::string_view(reinterpret_cast<const char*>(data), size);
+    }
+
+    uint32_t u32() const {
+        uint32_t v = 0;
+        if (size == 4) std::memcpy(&v, data, 4);
+        return v;
+    }
+
+    int32_t i32() const {
+        return (int32_t)u32();
+    }
+
+    bool flag() const {
+        return size == 1 && data[0] != 0;
+    }
+};
+
+/**
+ * Read-only view of a config record
+ *
+ *   gemcore::config::Record record;
+ *   if (record.parse(data, size)) {
+ *       for (gemcore::config::Field field; record.next(field);) { switch (field.id) { ... } }
+ *   }
+ */
+class Record {
+private:
+    const unsigned char* data_ = nullptr;
+    size_t pos_ = 0;
+    uint16_t remaining_ = 0;
+
+    static uint16_t read16(const unsigned char* p) {
+        uint16_t v;
+        std::memcpy(&v, p, 2);
+        return v;
+    }
+
+public:
+    /**
+     * Check the header and the bounds of every field; false if the record is
+     * damaged or from an incompatible (newer) layout
+     */
+    bool parse(const unsigned char* data, size_t size) {
+        data_ = nullptr;
+        remaining_ = 0;
+        if (!data || size < RECORD_HEADER_SIZE || std::memcmp(data, RECORD_MAGIC, 4) != 0) return false;
+        if (read16(data + 4) != RECORD_VERSION) return false;
+
+        uint16_t count = read16(data + 6);
+        size_t pos = RECORD_HEADER_SIZE;
+        for (uint16_t i = 0; i < count; i++) {
+            if (size - pos < 4) return false;
+            size_t fieldSize = read16(data + pos + 2);
+            if (size - pos - 4 < fieldSize) return false;
+            pos += 4 + fieldSize;
+        }
+
+        data_ = data;
+        pos_ = RECORD_HEADER_SIZE;
+        remaining_ = count;
+        return true;
+    }
+
+    /**
+     * Next field in record order; false after the last one
+     */
+    bool next(Field& field) {
+        if (remaining_ == 0) return false;
+        field.id = read16(data_ + pos_);
+        field.size = read16(data_ + pos_ + 2);
+        field.data = data_ + pos_ + 4;
+        pos_ += 4 + (size_t)field.size;
+        remaining_--;
+        return true;
+    }
+};
+
+} // namespace config
+} // namespace gemcore
+
+#endif // GEMCORE_CONFIG_RECORD_H
@@ -0,0 +1,88 @@
+/**
+ *  Gemcore Embedded Footer - SHARED BY THE UNIVERSAL LAUNCHERS
+ *
+ * Single-file executables are laid out as
+ *   [universal launcher][binary][assets][config][steam library][footer]
+ *
+ * The footer has a fixed size and sits at the very end of the file, so the
+ * launcher finds it with ONE read at (fileSize - sizeof(Footer)) instead of
+ * scanning for the magic. Written by scripts/pack-{linux,windows}-single-exe.ts
+ * (all integers little-endian).
+ */
+
+#ifndef GEMCORE_EMBEDDED_FOOTER_H
+#define GEMCORE_EMBEDDED_FOOTER_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace gemcore {
+namespace embedded {
+
+static const uint32_t FOOTER_VERSION = 2;
+static const char FOOTER_MAGIC[16] = { 'G','E','M','C','O','R','E','_','E','M','B','E','D','D','E','D' };
+
+enum SectionId {
+    SECTION_BINARY = 0,     // Architecture-specific launcher binary
+    SECTION_ASSETS = 1,     // gemcore-assets container
+    SECTION_CONFIG = 2,     // Launcher config record, Steam fields (gemcore-config-record.h)
+    SECTION_STEAM_LIB = 3,  // libsteam_api.so / steam_api64.dll
+    SECTION_COUNT = 4
+};
+
+struct Section {
+    uint64_t offset;
+    uint64_t size;      // 0 = not embedded
+    uint64_t hash;      // FNV-1a 64 of the section bytes (extraction cache key)
+};
+
+struct Footer {
+    uint32_t version;                  // FOOTER_VERSION
+    uint32_t footerSize;               // sizeof(Footer)
+    Section sections[SECTION_COUNT];
+    uint32_t flags;                    // Reserved, 0
+    uint32_t checksum;                 // FNV-1a 32 of all bytes before this field
+    char magic[16];                    // FOOTER_MAGIC (last bytes of the file)
+};
+
+static_assert(sizeof(Footer) == 128, "Footer layout must match the packer scripts");
+static_assert(offsetof(Footer, checksum) == 108, "Footer layout must match the packer scripts");
+
+/**
+ * FNV-1a 32 (footer checksum)
+ */
+inline uint32_t fnv1a32(const uint8_t* data, size_t len) {
+    uint32_t hash = 0x811c9dc5u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+/**
+ * Validate a footer read from the end of a file of fileSize bytes
+ */
+inline bool validateFooter(const Footer& footer, uint64_t fileSize) {
+    if (memcmp(footer.magic, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0) return false;
+    if (footer.version != FOOTER_VERSION || footer.footerSize != sizeof(Footer)) return false;
+
+    uint32_t checksum = fnv1a32(reinterpret_cast<const uint8_t*>(&footer), offsetof(Footer, checksum));
+    if (checksum != footer.checksum) return false;
+
+    // Every section must lie before the footer
+    if (fileSize < sizeof(Footer)) return false;
+    uint64_t limit = fileSize - sizeof(Footer);
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        const Section& s = footer.sections[i];
+        if (s.size == 0) continue;
+        if (s.offset > limit || s.size > limit - s.offset) return false;
+    }
+    return true;
+}
+
+} // namespace embedded
+} // namespace gemcore
+
+#endif // GEMCORE_EMBEDDED_FOOTER_H
@@ -8,16 +8,32 @@
  * - TCP_NODELAY for instant send
  * - Multi-threaded request handling
  * - Pre-cached responses with iovec
+ * - gzip-compressed assets passed through untouched (Content-Encoding: gzip)
+ * - Blocking readiness handshake between the server thread and the launcher
+ * - Optional access profile (GEMCORE_RECORD_ACCESS) for the packer's layout
+ * - Token-protected API routes under /__gemcore/ with request bodies and
+ *   asynchronous replies (binary Steam Cloud transfers)
  */
 
 #ifndef GEMCORE_HTTP_SERVER_H
 #define GEMCORE_HTTP_SERVER_H
 
 #include <string>
+#include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <atomic>
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
+#include <random>
+
+#include "gemcore-trace.h"
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -44,6 +60,7 @@ struct Asset {
     const unsigned char* data;
     size_t size;
     std::string mimeType;
+    std::string contentEncoding;  // "gzip" if data is the compressed payload, else empty
 };
 
 /**
@@ -51,8 +68,13 @@ struct Asset {
  */
 struct Response {
     std::string headers;
-    const unsigned char* body;
+    const unsigned char* body;  // Provider memory (shared by deduplicated aliases), never copied
     size_t bodySize;
+    bool gzip = false;  // Body is gzip: clients without Accept-Encoding get an inflated copy
+    
+    // Integrity state when an asset verifier is set (0 unchecked, 1 ok, 2 corrupted),
+    // shared with copies of the response ("/" and the entrypoint)
+    std::shared_ptr<std::atomic<uint8_t>> integrity;
     
 #ifndef _WIN32
     // Pre-built iovec for writev() (Unix only)
@@ -95,6 +117,72 @@ inline bool needsUrlDecode(const char* start, size_t len) {
     return false;
 }
 
+/**
+ * Check the request headers for "Accept-Encoding: ... gzip"
+ */
+inline bool acceptsGzip(const char* request, size_t len) {
+    static const char header[] = "accept-encoding:";
+    const size_t headerLen = sizeof(header) - 1;
+    
+    for (size_t i = 0; i + headerLen < len; i++) {
+        if (request[i] != '\n') continue;
+        
+        size_t j = 0;
+        while (j < headerLen && std::tolower((unsigned char)request[i + 1 + j]) == header[j]) j++;
+        if (j != headerLen) continue;
+        
+        // Scan the header value up to the end of the line
+        for (size_t k = i + 1 + headerLen; k + 4 <= len && request[k] != '\r' && request[k] != '\n'; k++) {
+            if (std::memcmp(request + k, "gzip", 4) == 0) return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+/**
+ * Find a request header (case-insensitive name, e.g. "content-length") and
+ * return its value without surrounding whitespace
+ */
+inline bool findHeader(const char* request, size_t len, const char* name, std::string& value) {
+    const size_t nameLen = std::strlen(name);
+    
+    for (size_t i = 0; i + nameLen + 1 < len; i++) {
+        if (request[i] != '\n') continue;
+        
+        size_t j = 0;
+        while (j < nameLen && std::tolower((unsigned char)request[i + 1 + j]) == name[j]) j++;
+        if (j != nameLen || request[i + 1 + nameLen] != ':') continue;
+        
+        size_t k = i + 2 + nameLen;
+        while (k < len && (request[k] == ' ' || request[k] == '\t')) k++;
+        size_t end = k;
+        while (end < len && request[end] != '\r' && request[end] != '\n') end++;
+        while (end > k && (request[end - 1] == ' ' || request[end - 1] == '\t')) end--;
+        value.assign(request + k, end - k);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Random per-run token for API routes (hex), injected into the page as
+ * window.Gemcore.apiToken and expected in the X-Gemcore-Token header
+ */
+inline std::string makeApiToken() {
+    static const char hex[] = "0123456789abcdef";
+    std::random_device rd;
+    std::string token;
+    for (int i = 0; i < 8; i++) {
+        uint32_t bits = rd();
+        for (int b = 0; b < 8; b++) {
+            token += hex[bits & 0xF];
+            bits >>= 4;
+        }
+    }
+    return token;
+}
+
 /**
  * Get MIME type from file extension
  */
@@ -126,6 +214,215 @@ inline std::string getMimeType(const std::string& path) {
     return "application/octet-stream";
 }
 
+/**
+ * One-shot readiness handshake for the server thread
+ *
+ * runServer() reports ready() once listen() succeeded (connections queue in
+ * the backlog from then on) or fail() with the error of the step that did not.
+ * The launcher blocks in wait() instead of spinning on a flag, so it does not
+ * compete with the server thread (or WebKit) for the CPU on small machines.
+ */
+class ServerReadiness {
+private:
+    enum State { PENDING, READY, FAILED };
+    
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    State state_ = PENDING;
+    std::string error_;
+    
+    void set(State state, const std::string& error) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (state_ != PENDING) return;  // First report wins
+            state_ = state;
+            error_ = error;
+        }
+        cv_.notify_all();
+    }
+    
+public:
+    void ready() {
+        set(READY, std::string());
+    }
+    
+    void fail(const std::string& error) {
+        set(FAILED, error);
+    }
+    
+    /**
+     * Block until the server reported; returns false (and the error) on failure
+     */
+    bool wait(std::string* error = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return state_ != PENDING; });
+        if (state_ == FAILED && error) *error = error_;
+        return state_ == READY;
+    }
+};
+
+/**
+ * Access profile recorder (enable with GEMCORE_RECORD_ACCESS=<file>,
+ * GEMCORE_RECORD_ACCESS=1 writes gemcore-access-profile.txt)
+ *
+ * Records the first request for each asset, in order, with its time since
+ * process start. `gemcore-pack --profile` lays the container out in this order
+ * and the loader decrypts that prefix first (see gemcore-asset-loader.h).
+ * Record a representative startup (e.g. up to the main menu), then quit.
+ *
+ * Format (text): "gemcore-access-profile 1", then one "<ms>\t<path>" line per asset.
+ */
+class AccessRecorder {
+private:
+    struct Access {
+        uint64_t us;
+        std::string path;
+    };
+    
+    bool enabled_ = false;
+    std::string path_;
+    std::mutex mutex_;
+    std::unordered_set<std::string> seen_;
+    std::vector<Access> accesses_;
+    
+public:
+    AccessRecorder() {
+        const char* env = std::getenv("GEMCORE_RECORD_ACCESS");
+        if (env && *env && std::strcmp(env, "0") != 0) {
+            path_ = std::strcmp(env, "1") == 0 ? "gemcore-access-profile.txt" : env;
+            enabled_ = true;
+        }
+    }
+    
+    bool enabled() const { return enabled_; }
+    
+    void record(const std::string& path) {
+        if (!enabled_) return;
+        uint64_t us = gemcore::trace::nowUs();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (seen_.insert(path).second) {
+            accesses_.push_back({ us, path });
+        }
+    }
+    
+    /**
+     * Write the profile (overwrites the file); false on I/O errors
+     */
+    bool write() {
+        if (!enabled_) return true;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        FILE* f = std::fopen(path_.c_str(), "wb");
+        if (!f) {
+            std::cerr << " Failed to write access profile: " << path_ << std::endl;
+            return false;
+        }
+        std::fputs("gemcore-access-profile 1\n", f);
+        for (const auto& access : accesses_) {
+            std::fprintf(f, "%llu.%03llu\t%s\n", (unsigned long long)(access.us / 1000),
+                         (unsigned long long)(access.us % 1000), access.path.c_str());
+        }
+        bool ok = std::fclose(f) == 0;
+        
+        #ifndef NDEBUG
+        std::cout << " Access profile written: " << path_ << " (" << accesses_.size() << " assets)" << std::endl;
+        #endif
+        return ok;
+    }
+};
+
+/**
+ * Request to an API route (see HTTPServer::setApiRoute)
+ */
+struct ApiRequest {
+    std::string method;  // "GET", "PUT", ...
+    std::string path;    // URL-decoded remainder after the route prefix
+    std::vector<uint8_t> body;
+};
+
+/**
+ * Reply channel of an API request
+ * Copies share the connection; the first send() answers and closes it, from
+ * any thread. If the last copy is dropped without a reply, the client gets a 500.
+ */
+class ApiResponder {
+public:
+    explicit ApiResponder(int fd) : conn_(std::make_shared<Connection>(fd)) {}
+    
+    void send(int status, const char* contentType, const void* body, size_t size) const {
+        conn_->reply(status, contentType, body, size);
+    }
+    
+    void send(int status) const {
+        conn_->reply(status, "text/plain", nullptr, 0);
+    }
+    
+private:
+    struct Connection {
+        int fd;
+        std::atomic<bool> answered{false};
+        
+        explicit Connection(int fd) : fd(fd) {}
+        
+        ~Connection() {
+            reply(500, "text/plain", nullptr, 0);
+#ifdef _WIN32
+            closesocket(fd);
+#else
+            close(fd);
+#endif
+        }
+        
+        void reply(int status, const char* contentType, const void* body, size_t size) {
+            if (answered.exchange(true)) return;
+            
+            std::string headers =
+                "HTTP/1.1 " + std::to_string(status) + " " + statusText(status) + "\r\n"
+                "Content-Type: " + contentType + "\r\n"
+                "Content-Length: " + std::to_string(size) + "\r\n"
+                "Cache-Control: no-store\r\n"
+                "Connection: close\r\n\r\n";
+            if (sendAll(headers.data(), headers.size()) && size > 0) {
+                sendAll(static_cast<const char*>(body), size);
+            }
+#ifdef _WIN32
+            shutdown(fd, SD_SEND);
+#else
+            shutdown(fd, SHUT_WR);
+#endif
+        }
+        
+        bool sendAll(const char* data, size_t size) {
+            while (size > 0) {
+                int chunk = (int)std::min<size_t>(size, 1 << 30);
+                auto sent = ::send(fd, data, chunk, MSG_NOSIGNAL);
+                if (sent <= 0) return false;
+                data += sent;
+                size -= (size_t)sent;
+            }
+            return true;
+        }
+        
+        static const char* statusText(int status) {
+            switch (status) {
+                case 200: return "OK";
+                case 204: return "No Content";
+                case 400: return "Bad Request";
+                case 403: return "Forbidden";
+                case 404: return "Not Found";
+                case 405: return "Method Not Allowed";
+                case 413: return "Payload Too Large";
+                case 503: return "Service Unavailable";
+                default:  return status < 400 ? "OK" : "Internal Server Error";
+            }
+        }
+    };
+    
+    std::shared_ptr<Connection> conn_;
+};
+
+using ApiHandler = std::function<void(ApiRequest&&, ApiResponder)>;
+
 /**
  * Universal HTTP Server
  */
@@ -138,7 +435,27 @@ private:
     // Asset provider callback
     std::function<Asset(const std::string&)> getAsset_;
     
+    // Optional: assets as stored (possibly gzip) for pass-through responses
+    std::function<Asset(const std::string&)> getStoredAsset_;
+    
+    // Optional: integrity check, run on the first request for each stored asset
+    std::function<bool(const std::string&)> verifyAsset_;
+    
+    // Inflated responses for clients that do not accept gzip (built on demand)
+    std::mutex identityMutex_;
+    std::unordered_map<std::string, Response> identityCache_;
+    
+    // GEMCORE_RECORD_ACCESS
+    AccessRecorder accessRecorder_;
+    
+    // API routes under API_PREFIX (registered before the server starts)
+    std::vector<std::pair<std::string, ApiHandler>> apiRoutes_;
+    std::string apiToken_;
+    
 public:
+    static constexpr const char* API_PREFIX = "/__gemcore/";
+    static constexpr size_t MAX_API_BODY = 100u * 1024 * 1024;  // Steam Cloud file limit
+    
     HTTPServer(int port = 8765) : port_(port), entrypoint_("index.html") {}
     
     /**
@@ -148,6 +465,22 @@ public:
         getAsset_ = provider;
     }
     
+    /**
+     * Set stored-asset provider: assets returned with contentEncoding "gzip"
+     * are cached and sent compressed, without decoding them at startup
+     */
+    void setStoredAssetProvider(std::function<Asset(const std::string&)> provider) {
+        getStoredAsset_ = provider;
+    }
+    
+    /**
+     * Set asset verifier: stored assets are checked on their first request
+     * (not at cache build time) and answered with 500 if corrupted
+     */
+    void setAssetVerifier(std::function<bool(const std::string&)> verifier) {
+        verifyAsset_ = verifier;
+    }
+    
     /**
      * Set entrypoint (default: index.html)
      */
@@ -160,9 +493,15 @@ public:
      *  OPTIMIZATION: Critical assets (entrypoint, main.js, etc.) are cached FIRST
      */
     void buildCache(const std::vector<std::string>& assetPaths) {
+        GEMCORE_TRACE_SCOPE("http.buildCache");
+        
         //  CLEAR OLD CACHE (prevent stale content!)
         cache_.clear();
         modifiedHTMLs_.clear();
+        {
+            std::lock_guard<std::mutex> lock(identityMutex_);
+            identityCache_.clear();
+        }
         
         //  OPTIMIZATION: Pre-allocate cache to avoid rehashing
         cache_.reserve(assetPaths.size() + 10);
@@ -178,6 +517,8 @@ public:
         for (const auto& critical : criticalAssets) {
             auto it = std::find(assetPaths.begin(), assetPaths.end(), critical);
             if (it != assetPaths.end()) {
+                if (cacheStored(critical)) continue;
+                
                 Asset asset = getAsset_(critical);
                 if (!asset.data || asset.size == 0) continue;
                 
@@ -259,6 +600,9 @@ public:
             std::string checkUri = "/" + path;
             if (cache_.count(checkUri) > 0) continue;
             
+            //  Stored payload as-is (gzip passthrough, no decode, verified on first request)
+            if (cacheStored(path)) continue;
+            
             Asset asset = getAsset_(path);
             if (!asset.data || asset.size == 0) continue;
             
@@ -382,6 +726,7 @@ public:
      * Handle a single HTTP request (fast path!)
      */
     void handleRequest(int fd) {
+        gemcore::trace::Span span("http.serve");
         char buf[8192];
         
 #ifdef _WIN32
@@ -390,6 +735,12 @@ public:
         ssize_t n = recv(fd, buf, sizeof(buf), 0);
 #endif
         
+        // API routes: any method, with a body, answered asynchronously
+        if (n > 14 && !apiRoutes_.empty() && isApiRequest(buf, (size_t)n)) {
+            handleApi(fd, buf, (size_t)n);
+            return;
+        }
+        
         if (n <= 14 || buf[0] != 'G' || buf[1] != 'E' || buf[2] != 'T') {
 #ifdef _WIN32
             closesocket(fd);
@@ -405,12 +756,13 @@ public:
         while (uri_end < buf + n && *uri_end != ' ' && *uri_end != '?') uri_end++;
         
         size_t uri_len = uri_end - uri_start;
+        span.setDetail(uri_start, uri_len);
         
         // Fast path: root URI
         if (uri_len == 1 && uri_start[0] == '/') {
             auto it = cache_.find("/");
             if (it != cache_.end()) {
-                sendResponse(fd, it->second);
+                sendCached(fd, it->first, it->second, buf, (size_t)n);
             } else {
                 send404(fd);
             }
@@ -433,7 +785,7 @@ public:
         // Lookup in cache
         auto it = cache_.find(uri);
         if (it != cache_.end()) {
-            sendResponse(fd, it->second);
+            sendCached(fd, it->first, it->second, buf, (size_t)n);
         } else {
             send404(fd);
         }
@@ -445,6 +797,30 @@ public:
 #endif
     }
     
+    /**
+     * Register an API route: requests whose path starts with `prefix` (which
+     * must start with API_PREFIX) go to `handler` with any method and body.
+     * The handler may keep the responder and reply later from another thread.
+     * Register routes before the server starts.
+     */
+    void setApiRoute(const std::string& prefix, ApiHandler handler) {
+        apiRoutes_.emplace_back(prefix, std::move(handler));
+    }
+    
+    /**
+     * Require X-Gemcore-Token: <token> on API requests (see makeApiToken)
+     */
+    void setApiToken(const std::string& token) {
+        apiToken_ = token;
+    }
+    
+    /**
+     * Write the recorded access profile (no-op unless GEMCORE_RECORD_ACCESS is set)
+     */
+    bool writeAccessProfile() {
+        return accessRecorder_.write();
+    }
+    
     /**
      * Get cache size (for diagnostics)
      */
@@ -460,6 +836,202 @@ public:
     }
     
 private:
+    static std::string buildHeaders(const Asset& asset, size_t bodySize, bool gzip) {
+        bool isCode = (asset.mimeType.find("html") != std::string::npos ||
+                      asset.mimeType.find("javascript") != std::string::npos ||
+                      asset.mimeType.find("css") != std::string::npos ||
+                      asset.mimeType.find("json") != std::string::npos);
+        
+        std::string headers =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: " + asset.mimeType + "\r\n"
+            "Content-Length: " + std::to_string(bodySize) + "\r\n"
+            "Cache-Control: " + (isCode ? "no-cache, no-store, must-revalidate, max-age=0"
+                                        : "public, max-age=31536000, immutable") + "\r\n";
+        if (isCode) {
+            headers += "Pragma: no-cache\r\nExpires: 0\r\n";
+        }
+        if (gzip) {
+            // No byte ranges on the compressed representation
+            headers += "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n";
+        } else {
+            headers += "Accept-Ranges: bytes\r\n";
+        }
+        headers += "Connection: keep-alive\r\n\r\n";
+        return headers;
+    }
+    
+    static bool isApiRequest(const char* buf, size_t n) {
+        const size_t prefixLen = std::strlen(API_PREFIX);
+        const char* space = static_cast<const char*>(std::memchr(buf, ' ', std::min<size_t>(n, 8)));
+        return space && (size_t)(buf + n - space - 1) >= prefixLen &&
+               std::memcmp(space + 1, API_PREFIX, prefixLen) == 0;
+    }
+    
+    /**
+     * Parse an API request, read its body and hand it to the matching route
+     * (the first recv() must contain all headers)
+     */
+    void handleApi(int fd, const char* buf, size_t n) {
+        gemcore::trace::Span span("http.api");
+        ApiResponder responder(fd);
+        
+        const char* space = static_cast<const char*>(std::memchr(buf, ' ', n));
+        const char* uriStart = space + 1;
+        const char* uriEnd = uriStart;
+        while (uriEnd < buf + n && *uriEnd != ' ' && *uriEnd != '?') uriEnd++;
+        span.setDetail(uriStart, uriEnd - uriStart);
+        
+        const char* headersEnd = nullptr;
+        for (const char* p = uriEnd; p + 4 <= buf + n; p++) {
+            if (std::memcmp(p, "\r\n\r\n", 4) == 0) { headersEnd = p + 4; break; }
+        }
+        if (!headersEnd) {
+            responder.send(400);
+            return;
+        }
+        size_t headersLen = headersEnd - buf;
+        
+        std::string value;
+        if (!apiToken_.empty() &&
+            (!findHeader(buf, headersLen, "x-gemcore-token", value) || value != apiToken_)) {
+            responder.send(403);
+            return;
+        }
+        
+        std::string uri = needsUrlDecode(uriStart, uriEnd - uriStart)
+            ? urlDecode(uriStart, uriEnd - uriStart)
+            : std::string(uriStart, uriEnd - uriStart);
+        
+        const std::pair<std::string, ApiHandler>* route = nullptr;
+        for (const auto& candidate : apiRoutes_) {
+            if (uri.compare(0, candidate.first.size(), candidate.first) == 0 &&
+                (!route || candidate.first.size() > route->first.size())) {
+                route = &candidate;
+            }
+        }
+        if (!route) {
+            responder.send(404);
+            return;
+        }
+        
+        size_t contentLength = 0;
+        if (findHeader(buf, headersLen, "content-length", value)) {
+            contentLength = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        if (contentLength > MAX_API_BODY) {
+            responder.send(413);
+            return;
+        }
+        
+        ApiRequest request;
+        request.method.assign(buf, space - buf);
+        request.path = uri.substr(route->first.size());
+        request.body.resize(contentLength);
+        
+        size_t have = std::min(contentLength, n - headersLen);
+        std::memcpy(request.body.data(), headersEnd, have);
+        while (have < contentLength) {
+            auto got = recv(fd, reinterpret_cast<char*>(request.body.data()) + have, (int)std::min<size_t>(contentLength - have, 1 << 30), 0);
+            if (got <= 0) return;  // Client went away
+            have += (size_t)got;
+        }
+        
+        route->second(std::move(request), responder);
+    }
+    
+    static void initIov(Response& resp) {
+#ifndef _WIN32
+        resp.iov[0].iov_base = (void*)resp.headers.data();
+        resp.iov[0].iov_len = resp.headers.size();
+        resp.iov[1].iov_base = (void*)resp.body;
+        resp.iov[1].iov_len = resp.bodySize;
+#else
+        (void)resp;
+#endif
+    }
+    
+    /**
+     * Cache the stored payload of an asset as-is (gzip is passed through)
+     * HTML is excluded (needs the WebGPU helper injected into the plain text).
+     */
+    bool cacheStored(const std::string& path) {
+        if (!getStoredAsset_) return false;
+        
+        Asset stored = getStoredAsset_(path);
+        if (!stored.data || stored.size == 0) return false;
+        if (stored.mimeType.find("html") != std::string::npos) return false;
+        
+        Response resp;
+        resp.body = stored.data;
+        resp.bodySize = stored.size;
+        resp.gzip = stored.contentEncoding == "gzip";
+        resp.headers = buildHeaders(stored, stored.size, resp.gzip);
+        if (verifyAsset_) {
+            resp.integrity = std::make_shared<std::atomic<uint8_t>>(0);
+        }
+        
+        auto [it, inserted] = cache_.emplace("/" + path, std::move(resp));
+        initIov(it->second);
+        return true;
+    }
+    
+    /**
+     * First request for an asset runs the verifier, later ones read the cached result
+     */
+    bool checkIntegrity(const std::string& uri, std::atomic<uint8_t>& state) {
+        uint8_t value = state.load(std::memory_order_acquire);
+        if (value == 0) {
+            value = verifyAsset_(uri == "/" ? entrypoint_ : uri.substr(1)) ? 1 : 2;
+            state.store(value, std::memory_order_release);
+        }
+        return value == 1;
+    }
+    
+    /**
+     * Send a cached response, inflating gzip bodies for clients without gzip
+     */
+    void sendCached(int fd, const std::string& uri, const Response& resp, const char* request, size_t len) {
+        if (accessRecorder_.enabled()) {
+            accessRecorder_.record(uri == "/" ? entrypoint_ : uri.substr(1));
+        }
+        
+        if (resp.integrity && !checkIntegrity(uri, *resp.integrity)) {
+            send500(fd);
+            return;
+        }
+        
+        if (!resp.gzip || acceptsGzip(request, len)) {
+            sendResponse(fd, resp);
+            return;
+        }
+        
+        const Response* plain = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(identityMutex_);
+            auto it = identityCache_.find(uri);
+            if (it == identityCache_.end()) {
+                // Provider buffers stay valid for the server lifetime (as in buildCache)
+                Asset asset = getAsset_(uri == "/" ? entrypoint_ : uri.substr(1));
+                if (asset.data) {
+                    Response resp;
+                    resp.body = asset.data;
+                    resp.bodySize = asset.size;
+                    resp.headers = buildHeaders(asset, asset.size, false);
+                    it = identityCache_.emplace(uri, std::move(resp)).first;
+                    initIov(it->second);
+                }
+            }
+            if (it != identityCache_.end()) plain = &it->second;
+        }
+        
+        if (plain) {
+            sendResponse(fd, *plain);
+        } else {
+            send404(fd);
+        }
+    }
+    
     void sendResponse(int fd, const Response& resp) {
 #ifdef _WIN32
         // Windows: Two send() calls
@@ -481,6 +1053,15 @@ private:
 #endif
     }
     
+    void send500(int fd) {
+        const char* resp = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 15\r\n\r\nCorrupted asset";
+#ifdef _WIN32
+        send(fd, resp, strlen(resp), 0);
+#else
+        send(fd, resp, strlen(resp), MSG_NOSIGNAL);
+#endif
+    }
+    
     // Store modified HTML content so pointers remain valid
     std::vector<std::string> modifiedHTMLs_;
 };
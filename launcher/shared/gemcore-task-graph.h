@@ -0,0 +1,231 @@
+/**
+ *  Gemcore Task Graph - SHARED BY ALL LAUNCHERS
+ *
+ * Launcher boot as a dependency graph: every step (asset load, config parse,
+ * cache build, server start, Steam init, window creation, ...) is a task with
+ * explicit dependencies. Independent tasks run concurrently on a small thread
+ * pool, so time to first navigate is the critical path only.
+ *
+ * - Tasks return false on failure: their dependents are skipped (and fail too)
+ * - MAIN_THREAD tasks (GTK/Cocoa/Win32 window work) run on the thread that
+ *   calls run(); the others run on worker threads
+ * - Per-task start/end times are kept for startup diagnostics (and recorded as
+ *   trace spans with GEMCORE_TRACE, see gemcore-trace.h)
+ */
+
+#ifndef GEMCORE_TASK_GRAPH_H
+#define GEMCORE_TASK_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+#include "gemcore-trace.h"
+
+namespace gemcore {
+namespace startup {
+
+class TaskGraph {
+public:
+    using TaskId = size_t;
+    using Clock = std::chrono::steady_clock;
+
+    enum Affinity {
+        ANY_THREAD,
+        MAIN_THREAD
+    };
+
+    enum State {
+        PENDING,
+        SUCCEEDED,
+        FAILED,     // Returned false
+        SKIPPED     // A dependency failed or was skipped
+    };
+
+    struct Task {
+        std::string name;
+        std::function<bool()> fn;
+        Affinity affinity;
+        std::vector<TaskId> dependents;
+        size_t remaining = 0;           // Unfinished dependencies
+        bool blocked = false;           // A dependency did not succeed
+        State state = PENDING;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+private:
+    std::vector<Task> tasks_;
+    std::deque<TaskId> ready_;          // ANY_THREAD tasks ready to run
+    std::deque<TaskId> readyMain_;      // MAIN_THREAD tasks ready to run
+    size_t finished_ = 0;
+    std::mutex mutex_;
+    std::condition_variable workerCv_;
+    std::condition_variable mainCv_;
+    Clock::time_point origin_;
+
+public:
+    TaskGraph() : origin_(Clock::now()) {}
+
+    /**
+     * Add a task; dependencies must already be added
+     */
+    TaskId add(const std::string& name, std::function<bool()> fn,
+               std::initializer_list<TaskId> deps = {}, Affinity affinity = ANY_THREAD) {
+        TaskId id = tasks_.size();
+        Task task;
+        task.name = name;
+        task.fn = std::move(fn);
+        task.affinity = affinity;
+        task.remaining = deps.size();
+        tasks_.push_back(std::move(task));
+        for (TaskId dep : deps) {
+            tasks_[dep].dependents.push_back(id);
+        }
+        return id;
+    }
+
+    /**
+     * Run every task; blocks until all are finished. MAIN_THREAD tasks run on
+     * the calling thread. Returns true if every task succeeded.
+     */
+    bool run(unsigned maxWorkers = 0) {
+        size_t anyCount = 0;
+        for (TaskId id = 0; id < tasks_.size(); id++) {
+            if (tasks_[id].affinity == ANY_THREAD) anyCount++;
+            if (tasks_[id].remaining == 0) enqueue(id);
+        }
+
+        unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+        size_t numWorkers = std::min<size_t>(maxWorkers ? maxWorkers : hw, anyCount);
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < numWorkers; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+
+        // Main thread: run MAIN_THREAD tasks as they become ready
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (finished_ < tasks_.size()) {
+                if (readyMain_.empty()) {
+                    mainCv_.wait(lock);
+                    continue;
+                }
+                TaskId id = readyMain_.front();
+                readyMain_.pop_front();
+                lock.unlock();
+                execute(id);
+                lock.lock();
+            }
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        #ifndef NDEBUG
+        printTimeline();
+        #endif
+
+        bool ok = true;
+        for (const auto& task : tasks_) {
+            if (task.state != SUCCEEDED) ok = false;
+        }
+        return ok;
+    }
+
+    State state(TaskId id) const { return tasks_[id].state; }
+    bool succeeded(TaskId id) const { return tasks_[id].state == SUCCEEDED; }
+    const std::vector<Task>& tasks() const { return tasks_; }
+    Clock::time_point origin() const { return origin_; }
+
+    /**
+     * Per-task timeline relative to graph creation (debug builds print it after run())
+     */
+    void printTimeline() const {
+        std::cout << " Startup graph:" << std::endl;
+        for (const auto& task : tasks_) {
+            if (task.state == SKIPPED) {
+                std::cout << "   " << task.name << ": skipped" << std::endl;
+                continue;
+            }
+            auto startMs = std::chrono::duration<double, std::milli>(task.start - origin_).count();
+            auto durationMs = std::chrono::duration<double, std::milli>(task.end - task.start).count();
+            std::cout << "   " << task.name << ": +" << startMs << "ms, " << durationMs << "ms"
+                      << (task.affinity == MAIN_THREAD ? " (main)" : "")
+                      << (task.state == FAILED ? " FAILED" : "") << std::endl;
+        }
+    }
+
+private:
+    // Caller holds mutex_ (or no workers are running yet)
+    void enqueue(TaskId id) {
+        if (tasks_[id].affinity == MAIN_THREAD) {
+            readyMain_.push_back(id);
+            mainCv_.notify_one();
+        } else {
+            ready_.push_back(id);
+            workerCv_.notify_one();
+        }
+    }
+
+    void workerLoop() {
+        gemcore::trace::setThreadName("startup-worker");
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (finished_ < tasks_.size()) {
+            if (ready_.empty()) {
+                workerCv_.wait(lock);
+                continue;
+            }
+            TaskId id = ready_.front();
+            ready_.pop_front();
+            lock.unlock();
+            execute(id);
+            lock.lock();
+        }
+    }
+
+    void execute(TaskId id) {
+        Task& task = tasks_[id];
+        task.start = Clock::now();
+
+        bool ok = false;
+        if (!task.blocked) {
+            GEMCORE_TRACE_SCOPE(task.name.c_str());
+            try {
+                ok = task.fn();
+            } catch (const std::exception& e) {
+                std::cerr << " Startup task '" << task.name << "' failed: " << e.what() << std::endl;
+            }
+        }
+        task.end = Clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        task.state = task.blocked ? SKIPPED : ok ? SUCCEEDED : FAILED;
+        finished_++;
+
+        for (TaskId dep : task.dependents) {
+            Task& dependent = tasks_[dep];
+            if (task.state != SUCCEEDED) dependent.blocked = true;
+            if (--dependent.remaining == 0) enqueue(dep);
+        }
+
+        if (finished_ == tasks_.size()) {
+            workerCv_.notify_all();
+            mainCv_.notify_all();
+        }
+    }
+};
+
+} // namespace startup
+} // namespace gemcore
+
+#endif // GEMCORE_TASK_GRAPH_H
@@ -0,0 +1,259 @@
+/**
+ *  Gemcore Trace - SHARED BY ALL LAUNCHERS
+ *
+ * Low-overhead startup/runtime tracing, exported as Chrome trace_event JSON
+ * (open in https://ui.perfetto.dev or chrome://tracing).
+ *
+ * Enable with GEMCORE_TRACE=<file.json> (GEMCORE_TRACE=1 writes
+ * gemcore-trace.json in the working directory). Works in release builds.
+ *
+ * - Scoped spans (GEMCORE_TRACE_SCOPE) with monotonic microsecond timestamps
+ *   relative to process start and small per-thread ids
+ * - Lock-free event buffer: writers claim a slot with one fetch_add and publish
+ *   it with one release store. Slots are written once, so the boot timeline
+ *   is never overwritten by later request spans; events past the capacity are
+ *   counted and dropped
+ * - Disabled: one predictable branch per span, nothing is allocated
+ */
+
+#ifndef GEMCORE_TRACE_H
+#define GEMCORE_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace gemcore {
+namespace trace {
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t CAPACITY = 65536;  // Events (~8 MB, allocated only when enabled)
+
+struct Event {
+    std::atomic<bool> ready{false}; // Published (fields below are complete)
+    char name[32];
+    char detail[64];
+    uint64_t startUs;
+    uint64_t durUs;
+    uint32_t tid;
+    char phase;                     // 'X' = complete span, 'i' = instant, 'M' = thread name
+};
+
+struct State {
+    bool enabled = false;
+    std::string path;
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint64_t> head{0};      // Claimed slots (may exceed CAPACITY)
+    std::atomic<uint32_t> nextTid{1};
+};
+
+// Captured during static initialization, i.e. before main()
+inline const Clock::time_point g_origin = Clock::now();
+
+inline State& state() {
+    static State* s = []() {
+        State* st = new State();  // Never destroyed: threads may trace during exit
+        const char* env = std::getenv("GEMCORE_TRACE");
+        if (env && *env && std::strcmp(env, "0") != 0) {
+            st->path = std::strcmp(env, "1") == 0 ? "gemcore-trace.json" : env;
+            st->events.reset(new Event[CAPACITY]);
+            st->enabled = true;
+        }
+        return st;
+    }();
+    return *s;
+}
+
+inline bool enabled() {
+    return state().enabled;
+}
+
+inline uint64_t nowUs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_origin).count();
+}
+
+inline uint32_t threadId() {
+    thread_local uint32_t tid = state().nextTid.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+inline void copyField(char* dst, size_t cap, const char* src) {
+    size_t len = src ? std::strlen(src) : 0;
+    if (len >= cap) {
+        // Cut before the code point that does not fit (a split one is invalid JSON)
+        len = cap - 1;
+        while (len > 0 && ((unsigned char)src[len] & 0xC0) == 0x80) len--;
+    }
+    if (len) std::memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+/**
+ * Record one event (names are copied, callers may pass temporaries)
+ */
+inline void record(char phase, const char* name, const char* detail, uint64_t startUs, uint64_t durUs) {
+    State& st = state();
+    if (!st.enabled) return;
+
+    uint64_t index = st.head.fetch_add(1, std::memory_order_relaxed);
+    if (index >= CAPACITY) return;  // Full: keep the oldest (boot) events
+    Event& ev = st.events[index];
+
+    copyField(ev.name, sizeof(ev.name), name);
+    copyField(ev.detail, sizeof(ev.detail), detail);
+    ev.startUs = startUs;
+    ev.durUs = durUs;
+    ev.tid = threadId();
+    ev.phase = phase;
+    ev.ready.store(true, std::memory_order_release);
+}
+
+/**
+ * Name the calling thread in the trace viewer
+ */
+inline void setThreadName(const char* name) {
+    if (enabled()) record('M', name, nullptr, 0, 0);
+}
+
+/**
+ * Zero-duration marker (e.g. "first navigate")
+ */
+inline void instant(const char* name, const char* detail = nullptr) {
+    if (enabled()) record('i', name, detail, nowUs(), 0);
+}
+
+/**
+ * Scoped span: records [construction, destruction) on the calling thread
+ */
+class Span {
+private:
+    const char* name_;
+    std::string detail_;
+    uint64_t start_;
+    bool active_;
+
+public:
+    explicit Span(const char* name, const char* detail = nullptr)
+        : name_(name), start_(0), active_(enabled()) {
+        if (!active_) return;
+        if (detail) detail_ = detail;
+        start_ = nowUs();
+    }
+
+    ~Span() {
+        end();
+    }
+
+    /**
+     * Close the span early (for sequential phases in one scope)
+     */
+    void end() {
+        if (!active_) return;
+        active_ = false;
+        record('X', name_, detail_.c_str(), start_, nowUs() - start_);
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /**
+     * Attach a detail once it is known (e.g. the request path)
+     */
+    void setDetail(const char* data, size_t len) {
+        if (active_) detail_.assign(data, len);
+    }
+};
+
+inline void writeEscaped(FILE* f, const char* s) {
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', f);
+            std::fputc(c, f);
+        } else if (c < 0x20) {
+            std::fprintf(f, "\\u%04x", c);
+        } else {
+            std::fputc(c, f);
+        }
+    }
+}
+
+/**
+ * Write the buffer as Chrome trace_event JSON (overwrites the file)
+ * Safe to call while other threads keep tracing; returns false on I/O errors.
+ */
+inline bool flush() {
+    State& st = state();
+    if (!st.enabled) return true;
+
+    FILE* f = std::fopen(st.path.c_str(), "wb");
+    if (!f) {
+        std::cerr << " Failed to write trace: " << st.path << std::endl;
+        return false;
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+
+    uint64_t claimed = st.head.load(std::memory_order_acquire);
+    uint64_t count = claimed < CAPACITY ? claimed : CAPACITY;
+    bool comma = false;
+
+    for (uint64_t i = 0; i < count; i++) {
+        const Event& ev = st.events[i];
+        if (!ev.ready.load(std::memory_order_acquire)) continue;  // Still being written
+
+        if (comma) std::fputs(",\n", f);
+        comma = true;
+
+        if (ev.phase == 'M') {
+            std::fprintf(f, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", ev.tid);
+            writeEscaped(f, ev.name);
+            std::fputs("\"}}", f);
+            continue;
+        }
+
+        std::fputs("{\"ph\":\"", f);
+        std::fputc(ev.phase, f);
+        std::fputs("\",\"name\":\"", f);
+        writeEscaped(f, ev.name);
+        std::fprintf(f, "\",\"pid\":1,\"tid\":%u,\"ts\":%llu", ev.tid, (unsigned long long)ev.startUs);
+        if (ev.phase == 'X') {
+            std::fprintf(f, ",\"dur\":%llu", (unsigned long long)ev.durUs);
+        } else {
+            std::fputs(",\"s\":\"t\"", f);
+        }
+        if (ev.detail[0]) {
+            std::fputs(",\"args\":{\"detail\":\"", f);
+            writeEscaped(f, ev.detail);
+            std::fputs("\"}", f);
+        }
+        std::fputc('}', f);
+    }
+
+    std::fputs("\n]}\n", f);
+    bool ok = std::fclose(f) == 0;
+
+    #ifndef NDEBUG
+    std::cout << " Trace written: " << st.path << " (" << count << " events";
+    if (claimed > count) std::cout << ", " << (claimed - count) << " dropped";
+    std::cout << ")" << std::endl;
+    #endif
+    return ok;
+}
+
+} // namespace trace
+} // namespace gemcore
+
+#define GEMCORE_TRACE_CONCAT_(a, b) a##b
+#define GEMCORE_TRACE_CONCAT(a, b) GEMCORE_TRACE_CONCAT_(a, b)
+#define GEMCORE_TRACE_SCOPE(...) \
+    ::gemcore::trace::Span GEMCORE_TRACE_CONCAT(gemcoreTraceSpan_, __LINE__)(__VA_ARGS__)
+
+#endif // GEMCORE_TRACE_H
@@ -153,7 +153,7 @@ async function fileWrite(fileName, data) {
     
     return new Promise((resolve) => {
         window.steamFileWrite(fileName, data).then((result) => {
-            resolve(result === 'true');
+            resolve(result === true || result === 'true');
         });
     });
 }
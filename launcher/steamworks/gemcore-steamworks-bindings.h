@@ -6,6 +6,8 @@
  *   #include "gemcore-steamworks-bindings.h"
  *   
  *   bool steamEnabled = gemcore::steamworks::initSteamworks(config);
+ *   gemcore::steamworks::registerCloudRoutes(server);   // before the server starts
+ *   gemcore::steamworks::registerInputRoutes(server);
  *   gemcore::steamworks::bindSteamworksToWebview(w, steamEnabled);
  */
 
@@ -14,8 +16,19 @@
 
 #include <string>
 #include <fstream>
-#include <nlohmann/json.hpp>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <string_view>
+#include <charconv>
 #include "gemcore-steamworks.h"
+#include "gemcore-bind-json.h"
+#include "gemcore-http-server.h"
+#include "gemcore-trace.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -27,11 +40,13 @@
 #include <limits.h>
 #endif
 
+#ifdef WEBVIEW_GTK
+#include <glib.h>
+#endif
+
 namespace gemcore {
 namespace steamworks {
 
-using json = nlohmann::json;
-
 /**
  * Get the directory of the current executable
  */
@@ -101,25 +116,13 @@ inline void createSteamAppIdFile(uint32_t appId) {
 }
 
 /**
- * Load Steam DLL from TEMP directory (Windows only)
- * The universal launcher extracts the DLL to %TEMP%\gemcore_<pid>\steam_api64.dll
- * 
- * Note: The DLL is extracted to disk (like gemcore-assets file) because:
- * 1. Windows LoadLibrary requires a file path
- * 2. MemoryLoadLibrary is complex and not needed
- * 3. Steam client provides the runtime dependencies
- * 4. This works exactly like assets: extract to TEMP, load from there
+ * Load the Steam library (libsteam_api.so / libsteam_api.dylib / steam_api64.dll)
+ * Opened with dlopen/LoadLibrary only when Steamworks is enabled in the config
+ * (see steam-api-stubs.cpp); the universal launchers point GEMCORE_STEAM_LIB
+ * or PATH at their embedded copy.
  */
 inline bool loadSteamDLL() {
-    #ifdef _WIN32
-    // On Windows, the DLL is extracted to TEMP by the universal launcher
-    // Steam client will provide the runtime dependencies (VCRUNTIME140.dll, etc.)
-    // We don't need to explicitly load it - SteamAPI_Init will handle it
-    return true;
-    #else
-    // On macOS/Linux, the DLL/dylib/so is already linked or loaded via dlopen
-    return true;
-    #endif
+    return SteamworksManager::LoadSteamApi();
 }
 
 /**
@@ -136,12 +139,23 @@ inline bool initSteamworks(const ConfigType& config) {
         return false;
     }
     
-    // On Windows, explicitly load the Steam DLL from TEMP
-    // (This may fail if dependencies are missing, but Steam client will provide them)
-    loadSteamDLL();
+    // Open the Steam library only now: disabled games never load it
+    {
+        GEMCORE_TRACE_SCOPE("steam.loadLibrary");
+        if (!loadSteamDLL()) {
+            std::cerr << " Steamworks: FAILED (Steam library not loaded)" << std::endl;
+            return false;
+        }
+    }
     
     // Create steam_appid.txt if App ID is provided
-    if (config.steamworks.appId > 0) {
+    // (not needed when SteamAppId is already in the environment - set by the
+    // Steam client or the Linux universal launcher)
+    if (std::getenv("SteamAppId")) {
+        #ifndef NDEBUG
+        std::cout << " Using SteamAppId from environment: " << std::getenv("SteamAppId") << std::endl;
+        #endif
+    } else if (config.steamworks.appId > 0) {
         createSteamAppIdFile(config.steamworks.appId);
     } else {
         std::cerr << "  No Steam App ID configured!" << std::endl;
@@ -149,9 +163,13 @@ inline bool initSteamworks(const ConfigType& config) {
     
     // Initialize Steamworks
     std::cout << " Initializing Steamworks..." << std::endl;
+    gemcore::trace::Span initSpan("steam.init");
     bool success = SteamworksManager::Init();
+    initSpan.end();
     
     if (success) {
+        SteamworksManager::SetStoreStatsDelay(config.steamworks.storeStatsDelayMs);
+        SteamworksManager::SetLeaderboardCacheTtl(config.steamworks.leaderboardCacheMs);
         std::cout << " Steamworks: INITIALIZED" << std::endl;
     } else {
         std::cerr << " Steamworks: FAILED" << std::endl;
@@ -162,6 +180,345 @@ inline bool initSteamworks(const ConfigType& config) {
     return success;
 }
 
+namespace detail {
+
+/**
+ * Parked long-polls of /__gemcore/input/, answered when the input state changes
+ */
+struct InputWaiters {
+    static constexpr size_t MAX = 8;  // Reloaded pages leave their polls behind
+    std::mutex mutex;
+    std::vector<gemcore::http::ApiResponder> responders;
+};
+
+inline InputWaiters& inputWaiters() {
+    static InputWaiters waiters;
+    return waiters;
+}
+
+// Answer every parked poll with the current state (503 once the poller is
+// stopped, 500 if Steam Input failed to initialize)
+inline void wakeInputWaiters() {
+    std::vector<gemcore::http::ApiResponder> responders;
+    uint8_t state[InputLayout::SIZE];
+    uint32_t sequence;
+    bool failed;
+    {
+        std::lock_guard<std::mutex> lock(inputWaiters().mutex);
+        responders.swap(inputWaiters().responders);
+        sequence = SteamworksManager::GetInputState(state);
+        failed = SteamworksManager::InputFailed();
+    }
+    for (const auto& responder : responders) {
+        if (failed) {
+            responder.send(500);
+        } else if (sequence) {
+            responder.send(200, "application/octet-stream", state, sizeof(state));
+        } else {
+            responder.send(503);
+        }
+    }
+}
+
+using bindjson::ArgReader;
+using bindjson::Writer;
+
+// Ids go to JS as strings: 64-bit Steam ids do not fit a double
+inline void writeIdString(Writer& out, uint64_t steamId) {
+    char buf[24];
+    auto result = std::to_chars(buf, buf + sizeof(buf), steamId);
+    out.value(std::string_view(buf, result.ptr - buf));
+}
+
+/**
+ * A synchronous Steam call reachable from JS, either as its own binding
+ * (window.steamGetAchievement(id)) or as an operation of window.steamBatch().
+ * `call` reads its parameters from the JS argument array and writes its
+ * result; on missing or mistyped parameters it returns false (or throws) and
+ * the caller answers `fallback`, a JSON literal.
+ */
+struct SteamOp {
+    const char* name;
+    bool (*call)(ArgReader& args, Writer& result);
+    const char* fallback;
+};
+
+inline const std::vector<SteamOp>& steamOps() {
+    static const std::vector<SteamOp> ops = {
+        // User Info
+        {"steamGetSteamID", [](ArgReader&, Writer& result) {
+            writeIdString(result, SteamworksManager::GetSteamID());
+            return true;
+        }, "\"0\""},
+        {"steamGetPersonaName", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::GetPersonaName();
+            });
+        }, "\"\""},
+        {"steamGetAppID", [](ArgReader&, Writer& result) {
+            writeIdString(result, SteamworksManager::GetAppID());
+            return true;
+        }, "\"0\""},
+        
+        // Achievements
+        {"steamUnlockAchievement", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string>(args, result, [](const std::string& name) {
+                return SteamworksManager::UnlockAchievement(name);
+            });
+        }, "false"},
+        {"steamGetAchievement", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string>(args, result, [](const std::string& name) {
+                bool achieved = false;
+                bool success = SteamworksManager::GetAchievement(name, achieved);
+                return success && achieved;
+            });
+        }, "false"},
+        {"steamStoreStats", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::StoreStats();
+            });
+        }, "false"},
+        
+        // Stats
+        {"steamSetStatInt", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string, int32_t>(args, result, [](const std::string& name, int32_t value) {
+                return SteamworksManager::SetStatInt(name, value);
+            });
+        }, "false"},
+        {"steamGetStatInt", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string>(args, result, [](const std::string& name) {
+                int32_t value = 0;
+                bool success = SteamworksManager::GetStatInt(name, value);
+                return success ? value : 0;
+            });
+        }, "0"},
+        
+        // Cloud Storage (reads and writes are async, see bindSteamworksToWebview)
+        {"steamFileExists", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string>(args, result, [](const std::string& fileName) {
+                return SteamworksManager::FileExists(fileName);
+            });
+        }, "false"},
+        
+        // Rich Presence
+        {"steamSetRichPresence", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string, std::string>(args, result, [](const std::string& key, const std::string& value) {
+                return SteamworksManager::SetRichPresence(key, value);
+            });
+        }, "false"},
+        
+        // Overlay
+        {"steamIsOverlayEnabled", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::IsOverlayEnabled();
+            });
+        }, "false"},
+        {"steamActivateOverlay", [](ArgReader& args, Writer& result) {
+            return bindjson::call<std::string>(args, result, [](const std::string& dialog) {
+                SteamworksManager::ActivateOverlay(dialog);
+                return true;
+            });
+        }, "false"},
+        
+        // DLC
+        {"steamIsDlcInstalled", [](ArgReader& args, Writer& result) {
+            return bindjson::call<uint32_t>(args, result, [](uint32_t appId) {
+                return SteamworksManager::IsDlcInstalled(appId);
+            });
+        }, "false"},
+        {"steamGetDLCCount", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::GetDLCCount();
+            });
+        }, "0"},
+        
+        // Friends
+        {"steamGetFriendCount", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::GetFriendCount();
+            });
+        }, "0"},
+        {"steamGetFriendPersonaName", [](ArgReader& args, Writer& result) {
+            return bindjson::call<int32_t>(args, result, [](int32_t friendIndex) {
+                return friendIndex < 0 ? std::string() : SteamworksManager::GetFriendPersonaName(friendIndex);
+            });
+        }, "\"\""},
+        // [[steamId, name, personaState, gameAppId], ...]; ids as strings (64 bit)
+        {"steamGetFriends", [](ArgReader&, Writer& result) {
+            auto friends = SteamworksManager::GetFriendsSnapshot();
+            result.beginArray();
+            for (const FriendInfo& f : *friends) {
+                result.beginArray();
+                writeIdString(result, f.steamId);
+                result.value(f.name);
+                result.value(f.personaState);
+                result.value(f.gameAppId);
+                result.endArray();
+            }
+            result.endArray();
+            return true;
+        }, "[]"},
+        
+        // Steam Input (states are read through registerInputRoutes)
+        // [actionSet, [digital actions], [analog actions], rateHz]
+        {"steamInputConfigure", [](ArgReader& args, Writer& result) {
+            static thread_local std::string actionSet;
+            static thread_local std::vector<std::string> digital, analog;
+            uint32_t rateHz = 250;
+            if (!args.read(actionSet) || !args.read(digital) || !args.read(analog) || !args.optional(rateHz)) return false;
+            result.value(SteamworksManager::ConfigureInput(actionSet, digital, analog, rateHz));
+            return true;
+        }, "false"},
+        {"steamInputStop", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                SteamworksManager::StopInput();
+                wakeInputWaiters();
+                return true;
+            });
+        }, "false"},
+        
+        // Screenshots
+        {"steamTriggerScreenshot", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                SteamworksManager::TriggerScreenshot();
+                return true;
+            });
+        }, "false"},
+        
+        // App Info
+        {"steamGetCurrentGameLanguage", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::GetCurrentGameLanguage();
+            });
+        }, "\"english\""},
+        {"steamGetAvailableGameLanguages", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::GetAvailableGameLanguages();
+            });
+        }, "\"\""},
+        {"steamIsSteamInBigPictureMode", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::IsSteamInBigPictureMode();
+            });
+        }, "false"},
+        {"steamIsSteamDeck", [](ArgReader& args, Writer& result) {
+            return bindjson::call<>(args, result, [] {
+                return SteamworksManager::IsSteamDeck();
+            });
+        }, "false"},
+    };
+    return ops;
+}
+
+inline const SteamOp* findSteamOp(std::string_view name) {
+    // Keys point at the ops' static names
+    static const std::unordered_map<std::string_view, const SteamOp*> index = [] {
+        std::unordered_map<std::string_view, const SteamOp*> map;
+        for (const SteamOp& op : steamOps()) map.emplace(op.name, &op);
+        return map;
+    }();
+    auto it = index.find(name);
+    return it != index.end() ? it->second : nullptr;
+}
+
+inline void runSteamOp(const SteamOp& op, ArgReader& args, Writer& result) {
+    Writer::Mark mark = result.mark();
+    try {
+        if (op.call(args, result)) return;
+    } catch (...) {
+    }
+    result.rewind(mark);
+    result.raw(op.fallback);
+}
+
+/**
+ * One binding call: JSON argument array in, JSON result out
+ */
+inline std::string runSteamOp(const SteamOp& op, std::string_view req) {
+    static thread_local std::string buffer;
+    ArgReader args(req);
+    Writer result(buffer);
+    runSteamOp(op, args, result);
+    return buffer;
+}
+
+/**
+ * window.steamBatch([[name, [args...]], ...]) -> [result, ...]
+ * Runs the operations in order within a single bridge round-trip. Unknown
+ * names (including the async cloud calls) answer null.
+ */
+inline std::string runSteamBatch(std::string_view req) {
+    GEMCORE_TRACE_SCOPE("steam.batch");
+    static thread_local std::string buffer;
+    static thread_local std::string name;
+    ArgReader in(req);
+    Writer results(buffer);
+    results.beginArray();
+    if (in.next() && in.isArray()) {
+        in.enter();
+        while (in.next()) {
+            if (!in.isArray()) {
+                in.skipValue();
+                results.null();
+                continue;
+            }
+            in.enter();
+            const SteamOp* op = in.read(name) ? findSteamOp(name) : nullptr;
+            if (!op) {
+                results.null();
+            } else if (bool hasArgs = in.next(); hasArgs && in.isArray()) {
+                in.enter();
+                runSteamOp(*op, in, results);
+                in.leave();
+            } else {
+                if (hasArgs) in.skipValue();
+                ArgReader noArgs("[]");
+                runSteamOp(*op, noArgs, results);
+            }
+            in.leave();
+        }
+    }
+    results.endArray();
+    return buffer;
+}
+
+/**
+ * "global" | "aroundUser" | "friends" (anything else is global)
+ */
+inline LeaderboardRequest parseLeaderboardRequest(const std::string& type) {
+    if (type == "aroundUser") return LeaderboardRequest::AroundUser;
+    if (type == "friends") return LeaderboardRequest::Friends;
+    return LeaderboardRequest::Global;
+}
+
+/**
+ * [totalEntries, [[steamId, globalRank, score, name, details?], ...]], or null
+ * if the download failed; ids as strings (64 bit), details only when requested
+ */
+inline std::string leaderboardPageJson(const LeaderboardPage& page, bool withDetails) {
+    if (!page.ok) return "null";
+    std::string json;
+    json.reserve(64 + page.entries.size() * 64);
+    Writer out(json);
+    out.beginArray();
+    out.value(page.totalEntries);
+    out.beginArray();
+    for (const LeaderboardEntry& e : page.entries) {
+        out.beginArray();
+        writeIdString(out, e.steamId);
+        out.value(e.globalRank);
+        out.value(e.score);
+        out.value(e.name);
+        if (withDetails) out.value(e.details);
+        out.endArray();
+    }
+    out.endArray();
+    out.endArray();
+    return json;
+}
+
+} // namespace detail
+
 /**
  * Bind all Steamworks functions to the webview
  * This creates JavaScript functions that can be called from the web app
@@ -170,303 +527,278 @@ template<typename WebviewType>
 inline void bindSteamworksToWebview(WebviewType& w, bool steamEnabled) {
     if (!steamEnabled) return;
     
-    // User Info (no parameters)
-    // Note: webview expects JSON strings, so we use json::dump()
-    w.bind("steamGetSteamID", [](const std::string& req) -> std::string {
-        try {
-            uint64_t steamID = SteamworksManager::GetSteamID();
-            return json(std::to_string(steamID)).dump();
-        } catch (...) {
-            return json("0").dump();
-        }
-    });
-    
-    w.bind("steamGetPersonaName", [](const std::string& req) -> std::string {
-        try {
-            std::string name = SteamworksManager::GetPersonaName();
-            return json(name).dump();
-        } catch (...) {
-            return json("").dump();
-        }
-    });
-    
-    w.bind("steamGetAppID", [](const std::string& req) -> std::string {
-        try {
-            uint32_t appID = SteamworksManager::GetAppID();
-            return json(std::to_string(appID)).dump();
-        } catch (...) {
-            return json("0").dump();
-        }
-    });
-    
-    // Achievements
-    w.bind("steamUnlockAchievement", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            // j[0] is the function name, j[0] is the first actual parameter
-            if (!j.is_array() || j.size() < 1) return json(false).dump();
-            std::string achievementId = j[0].get<std::string>();
-            bool success = SteamworksManager::UnlockAchievement(achievementId);
-            return json(success).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
+    // One binding per synchronous call, plus steamBatch to run many of them in
+    // one round-trip (the JS wrapper batches calls made in the same microtask)
+    // Note: webview hands over the arguments as a JSON array and expects a JSON
+    // string back; both are read and written in place (see gemcore-bind-json.h)
+    for (const detail::SteamOp& op : detail::steamOps()) {
+        w.bind(op.name, [&op](const std::string& req) -> std::string {
+            return detail::runSteamOp(op, req);
+        });
+    }
     
-    w.bind("steamGetAchievement", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json(false).dump();
-            std::string achievementId = j[0].get<std::string>();
-            bool achieved = false;
-            bool success = SteamworksManager::GetAchievement(achievementId, achieved);
-            return json(success && achieved).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
+    w.bind("steamBatch", [](const std::string& req) -> std::string {
+        return detail::runSteamBatch(req);
     });
     
-    w.bind("steamStoreStats", [](const std::string& req) -> std::string {
-        try {
-            bool success = SteamworksManager::StoreStats();
-            return json(success).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
+    // Tell JS when a friends snapshot it fetched is stale (callback thread -> UI thread)
+    SteamworksManager::SetFriendsChangedHandler([&w] {
+        w.dispatch([&w] {
+            w.eval("window.dispatchEvent(new Event('gemcore-steam-friends-changed'))");
+        });
     });
     
-    // Stats
-    w.bind("steamSetStatInt", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 2) return json(false).dump();
-            std::string statName = j[0].get<std::string>();
-            int32_t value = j[1].get<int32_t>();
-            bool success = SteamworksManager::SetStatInt(statName, value);
-            return json(success).dump();
-        } catch (...) {
-            return json(false).dump();
+    // Cloud Storage (JSON strings; window.Steam sends bytes via registerCloudRoutes)
+    // Async binds: the Steam I/O worker resolves the promise, the UI thread
+    // only parses the request.
+    w.bind("steamFileWrite", [&w](const std::string& id, const std::string& req, void*) {
+        bindjson::ArgReader args(req);
+        std::string fileName, data;
+        if (args.read(fileName) && args.read(data)) {
+            SteamworksManager::FileWriteAsync(fileName, std::vector<uint8_t>(data.begin(), data.end()),
+                [&w, id](bool success) {
+                    w.resolve(id, 0, success ? "true" : "false");
+                });
+            return;
         }
-    });
-    
-    w.bind("steamGetStatInt", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(0).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json(0).dump();
-            std::string statName = j[0].get<std::string>();
-            int32_t value = 0;
-            bool success = SteamworksManager::GetStatInt(statName, value);
-            return json(success ? value : 0).dump();
-        } catch (...) {
-            return json(0).dump();
+        w.resolve(id, 0, "false");
+    }, nullptr);
+    
+    w.bind("steamFileRead", [&w](const std::string& id, const std::string& req, void*) {
+        bindjson::ArgReader args(req);
+        std::string fileName;
+        if (args.read(fileName)) {
+            SteamworksManager::FileReadAsync(fileName, [&w, id](bool, std::vector<uint8_t> data) {
+                // Invalid UTF-8 is replaced rather than failing the read
+                std::string result;
+                bindjson::Writer out(result);
+                out.value(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+                w.resolve(id, 0, result);
+            });
+            return;
         }
-    });
-    
-    // Cloud Storage
-    w.bind("steamFileWrite", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 2) return json(false).dump();
-            std::string fileName = j[0].get<std::string>();
-            std::string dataStr = j[1].get<std::string>();
-            std::vector<uint8_t> data(dataStr.begin(), dataStr.end());
-            bool success = SteamworksManager::FileWrite(fileName, data);
-            return json(success).dump();
-        } catch (...) {
-            return json(false).dump();
+        w.resolve(id, 0, "\"\"");
+    }, nullptr);
+    
+    // Leaderboards (async binds resolved from the callback pump when Steam answers)
+    // steamFindLeaderboard(name) -> entry count, or null if there is no such leaderboard
+    w.bind("steamFindLeaderboard", [&w](const std::string& id, const std::string& req, void*) {
+        bindjson::ArgReader args(req);
+        std::string name;
+        if (args.read(name)) {
+            SteamworksManager::FindLeaderboard(name, [&w, id](bool found, int32_t entryCount) {
+                w.resolve(id, 0, found ? std::to_string(entryCount) : "null");
+            });
+            return;
         }
-    });
-    
-    w.bind("steamFileRead", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json("").dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json("").dump();
-            std::string fileName = j[0].get<std::string>();
-            std::vector<uint8_t> data = SteamworksManager::FileRead(fileName);
-            std::string result(data.begin(), data.end());
-            return json(result).dump();
-        } catch (...) {
-            return json("").dump();
+        w.resolve(id, 0, "null");
+    }, nullptr);
+    
+    // steamUploadLeaderboardScore(name, score, keepBest, [details])
+    //   -> [changed, score, globalRankNew, globalRankPrevious], or null on failure
+    w.bind("steamUploadLeaderboardScore", [&w](const std::string& id, const std::string& req, void*) {
+        bindjson::ArgReader args(req);
+        std::string name;
+        int32_t score = 0;
+        bool keepBest = true;
+        std::vector<int32_t> details;
+        if (args.read(name) && args.read(score)) {
+            // Lenient like before: a mistyped keepBest / details uses the default
+            args.optional(keepBest);
+            if (!args.optional(details)) details.clear();
         }
-    });
-    
-    w.bind("steamFileExists", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json(false).dump();
-            std::string fileName = j[0].get<std::string>();
-            bool exists = SteamworksManager::FileExists(fileName);
-            return json(exists).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
-    
-    // Rich Presence
-    w.bind("steamSetRichPresence", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 2) return json(false).dump();
-            std::string key = j[0].get<std::string>();
-            std::string value = j[1].get<std::string>();
-            bool success = SteamworksManager::SetRichPresence(key, value);
-            return json(success).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
-    
-    // Overlay
-    w.bind("steamIsOverlayEnabled", [](const std::string& req) -> std::string {
-        try {
-            bool enabled = SteamworksManager::IsOverlayEnabled();
-            return json(enabled).dump();
-        } catch (...) {
-            return json(false).dump();
+        if (args.ok() && !name.empty()) {
+            SteamworksManager::UploadLeaderboardScore(name, score, keepBest, details,
+                [&w, id](const LeaderboardUpload& upload) {
+                    if (!upload.ok) {
+                        w.resolve(id, 0, "null");
+                        return;
+                    }
+                    std::string result;
+                    bindjson::Writer out(result);
+                    out.beginArray();
+                    out.value(upload.changed);
+                    out.value(upload.score);
+                    out.value(upload.globalRankNew);
+                    out.value(upload.globalRankPrevious);
+                    out.endArray();
+                    w.resolve(id, 0, result);
+                });
+            return;
         }
-    });
-    
-    w.bind("steamActivateOverlay", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json(false).dump();
-            std::string dialog = j[0].get<std::string>();
-            SteamworksManager::ActivateOverlay(dialog);
-            return json(true).dump();
-        } catch (...) {
-            return json(false).dump();
+        w.resolve(id, 0, "null");
+    }, nullptr);
+    
+    // steamDownloadLeaderboardEntries(name, type, start, end, maxDetails) -> see leaderboardPageJson
+    w.bind("steamDownloadLeaderboardEntries", [&w](const std::string& id, const std::string& req, void*) {
+        bindjson::ArgReader args(req);
+        std::string name, type;
+        int32_t start = 0, end = 0, maxDetails = 0;
+        if (args.read(name) && args.read(type) && args.read(start) && args.read(end) && args.optional(maxDetails)) {
+            SteamworksManager::DownloadLeaderboardEntries(name, detail::parseLeaderboardRequest(type), start, end, maxDetails,
+                [&w, id, maxDetails](std::shared_ptr<const LeaderboardPage> page) {
+                    w.resolve(id, 0, detail::leaderboardPageJson(*page, maxDetails > 0));
+                });
+            return;
         }
-    });
+        w.resolve(id, 0, "null");
+    }, nullptr);
     
-    // DLC
-    w.bind("steamIsDlcInstalled", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") return json(false).dump();
-            json j = json::parse(req);
-            if (!j.is_array() || j.size() < 1) return json(false).dump();
-            uint32_t appId = j[0].get<uint32_t>();
-            bool installed = SteamworksManager::IsDlcInstalled(appId);
-            return json(installed).dump();
-        } catch (...) {
-            return json(false).dump();
+    #ifndef NDEBUG
+    std::cout << " Steamworks bindings: READY (accessible via window.Gemcore.Steam)" << std::endl;
+    #endif
+}
+
+/**
+ * Binary Steam Cloud transfers over the local HTTP server:
+ *   PUT /__gemcore/cloud/<file>  (body = file contents)  -> 204, or 500 on failure
+ *   GET /__gemcore/cloud/<file>                          -> 200 with the bytes, or 404
+ * The body is read on a server worker and the Steam I/O worker sends the reply,
+ * so saves never pass through the webview bridge or the UI thread.
+ * Register before the server starts; replies 503 while Steam is not initialized.
+ */
+inline void registerCloudRoutes(gemcore::http::HTTPServer& server) {
+    using gemcore::http::ApiRequest;
+    using gemcore::http::ApiResponder;
+    
+    server.setApiRoute("/__gemcore/cloud/", [](ApiRequest&& request, ApiResponder responder) {
+        if (!SteamworksManager::IsInitialized()) {
+            responder.send(503);
+        } else if (request.path.empty()) {
+            responder.send(400);
+        } else if (request.method == "PUT" || request.method == "POST") {
+            SteamworksManager::FileWriteAsync(request.path, std::move(request.body), [responder](bool success) {
+                responder.send(success ? 204 : 500);
+            });
+        } else if (request.method == "GET") {
+            SteamworksManager::FileReadAsync(request.path, [responder](bool success, std::vector<uint8_t> data) {
+                if (success) {
+                    responder.send(200, "application/octet-stream", data.data(), data.size());
+                } else {
+                    responder.send(404);
+                }
+            });
+        } else {
+            responder.send(405);
         }
     });
+}
+
+/**
+ * Steam Input state as a long-poll over the local HTTP server:
+ *   GET /__gemcore/input/<sequence>  -> 200 with the InputLayout buffer as soon
+ *                                       as its sequence differs from <sequence>
+ * The poller thread answers parked requests directly when the state changes,
+ * so a button press reaches JS without waiting for the webview's gamepad
+ * polling or the UI thread. 503 while the poller is not running, 500 if
+ * Steam Input failed to initialize (steamInputConfigure retries).
+ */
+inline void registerInputRoutes(gemcore::http::HTTPServer& server) {
+    using gemcore::http::ApiRequest;
+    using gemcore::http::ApiResponder;
     
-    w.bind("steamGetDLCCount", [](const std::string& req) -> std::string {
-        try {
-            int32_t count = SteamworksManager::GetDLCCount();
-            return json(count).dump();
-        } catch (...) {
-            return json(0).dump();
-        }
+    SteamworksManager::SetInputChangedHandler([](uint32_t) {
+        detail::wakeInputWaiters();
     });
     
-    // Friends
-    w.bind("steamGetFriendCount", [](const std::string& req) -> std::string {
-        try {
-            int32_t count = SteamworksManager::GetFriendCount();
-            return json(count).dump();
-        } catch (...) {
-            return json(0).dump();
+    server.setApiRoute("/__gemcore/input/", [](ApiRequest&& request, ApiResponder responder) {
+        if (request.method != "GET") {
+            responder.send(405);
+            return;
         }
-    });
-    
-    w.bind("steamGetFriendPersonaName", [](const std::string& req) -> std::string {
-        try {
-            if (req.empty() || req == "[]") {
-                return json("").dump();
-            }
-            
-            json j = json::parse(req);
-            
-            if (!j.is_array() || j.size() < 1) {
-                return json("").dump();
-            }
-            
-            int32_t friendIndex = j[0].get<int32_t>();
-            if (friendIndex < 0) {
-                return json("").dump();
+        uint32_t known = static_cast<uint32_t>(std::strtoul(request.path.c_str(), nullptr, 10));
+        uint8_t state[InputLayout::SIZE];
+        
+        detail::InputWaiters& waiters = detail::inputWaiters();
+        std::unique_lock<std::mutex> lock(waiters.mutex);
+        uint32_t sequence = SteamworksManager::GetInputState(state);
+        if (SteamworksManager::InputFailed()) {
+            lock.unlock();
+            responder.send(500);
+        } else if (!SteamworksManager::IsInitialized() || sequence == 0) {
+            lock.unlock();
+            responder.send(503);
+        } else if (sequence != known) {
+            lock.unlock();
+            responder.send(200, "application/octet-stream", state, sizeof(state));
+        } else {
+            if (waiters.responders.size() >= detail::InputWaiters::MAX) {
+                waiters.responders.front().send(200, "application/octet-stream", state, sizeof(state));
+                waiters.responders.erase(waiters.responders.begin());
             }
-            
-            std::string name = SteamworksManager::GetFriendPersonaName(friendIndex);
-            return json(name).dump();
-        } catch (...) {
-            return json("").dump();
-        }
-    });
-    
-    // Screenshots
-    w.bind("steamTriggerScreenshot", [](const std::string& req) -> std::string {
-        try {
-            SteamworksManager::TriggerScreenshot();
-            return json(true).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
-    
-    // App Info
-    w.bind("steamGetCurrentGameLanguage", [](const std::string& req) -> std::string {
-        try {
-            std::string lang = SteamworksManager::GetCurrentGameLanguage();
-            return json(lang).dump();
-        } catch (...) {
-            return json("english").dump();
-        }
-    });
-    
-    w.bind("steamGetAvailableGameLanguages", [](const std::string& req) -> std::string {
-        try {
-            std::string langs = SteamworksManager::GetAvailableGameLanguages();
-            return json(langs).dump();
-        } catch (...) {
-            return json("").dump();
+            waiters.responders.push_back(std::move(responder));
         }
     });
-    
-    w.bind("steamIsSteamInBigPictureMode", [](const std::string& req) -> std::string {
-        try {
-            bool bigPicture = SteamworksManager::IsSteamInBigPictureMode();
-            return json(bigPicture).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
-    
-    w.bind("steamIsSteamDeck", [](const std::string& req) -> std::string {
-        try {
-            bool isDeck = SteamworksManager::IsSteamDeck();
-            return json(isDeck).dump();
-        } catch (...) {
-            return json(false).dump();
-        }
-    });
-    
-    #ifndef NDEBUG
-    std::cout << " Steamworks bindings: READY (accessible via window.Gemcore.Steam)" << std::endl;
-    #endif
 }
 
 /**
- * Run Steamworks callbacks in a background thread
- * Call this after w.run() to keep Steam API updated
+ * Run Steamworks callbacks on the calling thread until `running` is cleared
+ * (CallbackSchedule intervals; prefer SteamworksManager::StartCallbackPump)
  */
 inline void runSteamworksCallbacks(std::atomic<bool>& running) {
+    CallbackSchedule schedule;
     while (running) {
         SteamworksManager::RunCallbacks();
-        std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+        uint32_t interval = schedule.next(SteamworksManager::PendingAsyncCalls());
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
     }
 }
 
+#ifdef WEBVIEW_GTK
+namespace detail {
+
+struct GtkPump {
+    CallbackSchedule schedule;
+    guint source = 0;
+};
+
+inline GtkPump& gtkPump() {
+    static GtkPump pump;
+    return pump;
+}
+
+inline gboolean gtkPumpTick(gpointer) {
+    GtkPump& pump = gtkPump();
+    SteamworksManager::RunCallbacks();
+    pump.source = g_timeout_add(pump.schedule.next(SteamworksManager::PendingAsyncCalls()), gtkPumpTick, nullptr);
+    return G_SOURCE_REMOVE;
+}
+
+// Runs on the main loop (g_idle_add): replace the pending timeout with an immediate tick
+inline gboolean gtkPumpKick(gpointer) {
+    GtkPump& pump = gtkPump();
+    if (!pump.source) return G_SOURCE_REMOVE;  // Stopped
+    g_source_remove(pump.source);
+    pump.schedule.reset();
+    return gtkPumpTick(nullptr);
+}
+
+} // namespace detail
+
+/**
+ * Pump Steam callbacks from the GTK main loop instead of a thread (one timeout
+ * source, rescheduled on a CallbackSchedule). Callbacks and call results then
+ * run on the UI thread, serialized with the webview bind callbacks.
+ * Call on the main thread before w.run(); stop after it returns.
+ */
+inline void startGtkCallbackPump() {
+    if (!SteamworksManager::IsInitialized() || detail::gtkPump().source) return;
+    SteamworksManager::SetPumpWakeup([] {
+        g_idle_add(detail::gtkPumpKick, nullptr);
+    });
+    detail::gtkPump().source = g_timeout_add(0, detail::gtkPumpTick, nullptr);
+}
+
+inline void stopGtkCallbackPump() {
+    SteamworksManager::SetPumpWakeup(nullptr);
+    detail::GtkPump& pump = detail::gtkPump();
+    if (pump.source) {
+        g_source_remove(pump.source);
+        pump.source = 0;
+    }
+}
+#endif
+
 /**
  * Shutdown Steamworks
  * Call this before app exits
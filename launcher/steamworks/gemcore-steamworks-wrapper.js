@@ -34,6 +34,187 @@
         return window.Gemcore && window.Gemcore.steam === true;
     }
     
+    // Steam Cloud bytes and Steam Input states go over the local server
+    // (/__gemcore/cloud/, /__gemcore/input/), not the JSON bridge: binary-safe,
+    // and the launcher's UI thread never touches them
+    function hasApiRoutes() {
+        return !!window.Gemcore.apiToken;
+    }
+    
+    function cloudRequest(fileName, init) {
+        init.headers = { 'X-Gemcore-Token': window.Gemcore.apiToken };
+        return fetch('/__gemcore/cloud/' + encodeURIComponent(fileName), init);
+    }
+    
+    // Calls made in the same microtask go to the launcher as one steamBatch
+    // round-trip instead of one bridge hop (and JSON parse/dump) each
+    let pendingCalls = [];
+    
+    function flushCalls() {
+        const calls = pendingCalls;
+        pendingCalls = [];
+        
+        if (calls.length === 1 || typeof window.steamBatch !== 'function') {
+            for (const c of calls) {
+                window[c.name](...c.args).then(c.resolve, c.reject);
+            }
+            return;
+        }
+        
+        window.steamBatch(calls.map((c) => [c.name, c.args])).then((results) => {
+            results = parseSteamResponse(results);
+            calls.forEach((c, i) => c.resolve(results[i]));
+        }, (e) => {
+            for (const c of calls) c.reject(e);
+        });
+    }
+    
+    function call(name, ...args) {
+        return new Promise((resolve, reject) => {
+            if (pendingCalls.length === 0) queueMicrotask(flushCalls);
+            pendingCalls.push({ name, args, resolve, reject });
+        });
+    }
+    
+    // Steam Input state (InputLayout in gemcore-steamworks.h), long-polled from
+    // /__gemcore/input/<sequence>: the launcher answers as soon as the poller
+    // sees a change, so the game reads it without waiting for the Gamepad API
+    const INPUT_HEADER_SIZE = 16;
+    const INPUT_CONTROLLER_SIZE = 4 + 8 * 8;
+    const INPUT_SIZE = INPUT_HEADER_SIZE + 4 * INPUT_CONTROLLER_SIZE;
+    
+    const inputState = {
+        running: false,
+        sequence: 0,
+        error: null,
+        digital: [],
+        analog: [],
+        bytes: new Uint8Array(INPUT_SIZE)
+    };
+    const inputView = new DataView(inputState.bytes.buffer);
+    
+    async function pollInput() {
+        while (inputState.running) {
+            try {
+                const response = await fetch('/__gemcore/input/' + inputState.sequence, {
+                    headers: { 'X-Gemcore-Token': window.Gemcore.apiToken }
+                });
+                if (response.status === 500) {
+                    // Steam Input did not initialize; configure() again to retry
+                    inputState.running = false;
+                    inputState.error = 'Steam Input failed to initialize';
+                    window.dispatchEvent(new CustomEvent('gemcore-steam-input', {
+                        detail: { sequence: inputState.sequence, error: inputState.error }
+                    }));
+                    break;
+                }
+                if (!response.ok) throw new Error('input poll failed: ' + response.status);
+                const bytes = new Uint8Array(await response.arrayBuffer());
+                if (!inputState.running) break;
+                inputState.bytes.set(bytes.subarray(0, INPUT_SIZE));
+                inputState.sequence = inputView.getUint32(0, true);
+                window.dispatchEvent(new CustomEvent('gemcore-steam-input', {
+                    detail: { sequence: inputState.sequence }
+                }));
+            } catch (e) {
+                await new Promise((resolve) => setTimeout(resolve, 250));
+            }
+        }
+    }
+    
+    function controllerOffset(controller) {
+        return INPUT_HEADER_SIZE + controller * INPUT_CONTROLLER_SIZE;
+    }
+    
+    const steamInput = {
+        /**
+         * Start polling Steam Input actions in the launcher
+         * State updates fire the 'gemcore-steam-input' window event; read them
+         * with pressed()/analog() (or the raw `buffer`) in your game loop.
+         * @param {{actionSet: string, digital: string[], analog: string[], rateHz?: number}} options
+         *   up to 32 digital and 8 analog actions; rateHz 10-1000 (default 250)
+         * @returns {Promise<boolean>}
+         */
+        async configure({ actionSet = '', digital = [], analog = [], rateHz = 250 } = {}) {
+            if (!isAvailable() || !hasApiRoutes()) return false;
+            const ok = parseSteamResponse(await window.steamInputConfigure(actionSet, digital, analog, rateHz)) === true;
+            if (!ok) return false;
+            inputState.error = null;
+            inputState.digital = digital.slice(0, 32);
+            inputState.analog = analog.slice(0, 8);
+            if (!inputState.running) {
+                inputState.running = true;
+                pollInput();
+            }
+            return true;
+        },
+        
+        /**
+         * Stop the launcher's poller
+         * @returns {Promise<boolean>}
+         */
+        async stop() {
+            inputState.running = false;
+            if (!isAvailable()) return false;
+            return parseSteamResponse(await window.steamInputStop()) === true;
+        },
+        
+        /**
+         * Raw state (layout documented in gemcore-steamworks.h); updated in place
+         * @type {Uint8Array}
+         */
+        buffer: inputState.bytes,
+        
+        /** Why the launcher's poller stopped ('Steam Input failed to initialize'), else null */
+        get error() {
+            return inputState.error;
+        },
+        
+        /** Sequence number of the current state (0 before the first update) */
+        get sequence() {
+            return inputState.sequence;
+        },
+        
+        /** Number of connected controllers (at most 4) */
+        get controllers() {
+            return inputView.getUint32(4, true);
+        },
+        
+        /**
+         * Is a digital action held?
+         * @param {string} name
+         * @param {number} controller
+         * @returns {boolean}
+         */
+        pressed(name, controller = 0) {
+            const index = inputState.digital.indexOf(name);
+            if (index < 0 || controller >= this.controllers) return false;
+            return (inputView.getUint32(controllerOffset(controller), true) & (1 << index)) !== 0;
+        },
+        
+        /**
+         * Position of an analog action (-1..1 for sticks)
+         * @param {string} name
+         * @param {number} controller
+         * @returns {{x: number, y: number}}
+         */
+        analog(name, controller = 0) {
+            const index = inputState.analog.indexOf(name);
+            if (index < 0 || controller >= this.controllers) return { x: 0, y: 0 };
+            const offset = controllerOffset(controller) + 4 + index * 8;
+            return {
+                x: inputView.getFloat32(offset, true),
+                y: inputView.getFloat32(offset + 4, true)
+            };
+        }
+    };
+    
+    // Friends snapshot, kept until the launcher reports a persona change
+    let friendsSnapshot = null;
+    window.addEventListener('gemcore-steam-friends-changed', () => {
+        friendsSnapshot = null;
+    });
+    
     // Steam API Wrapper
     window.Steam = {
         /**
@@ -51,7 +232,7 @@
          */
         async getSteamID() {
             if (!isAvailable()) return '0';
-            const result = await window.steamGetSteamID();
+            const result = await call('steamGetSteamID');
             return parseSteamResponse(result);
         },
         
@@ -61,7 +242,7 @@
          */
         async getPersonaName() {
             if (!isAvailable()) return '';
-            const result = await window.steamGetPersonaName();
+            const result = await call('steamGetPersonaName');
             return parseSteamResponse(result);
         },
         
@@ -71,7 +252,7 @@
          */
         async getAppID() {
             if (!isAvailable()) return 0;
-            const result = await window.steamGetAppID();
+            const result = await call('steamGetAppID');
             return parseInt(parseSteamResponse(result));
         },
         
@@ -86,7 +267,7 @@
          */
         async unlockAchievement(achievementId) {
             if (!isAvailable()) return false;
-            const result = await window.steamUnlockAchievement(achievementId);
+            const result = await call('steamUnlockAchievement', achievementId);
             return parseSteamResponse(result) === true;
         },
         
@@ -97,7 +278,7 @@
          */
         async getAchievement(achievementId) {
             if (!isAvailable()) return false;
-            const result = await window.steamGetAchievement(achievementId);
+            const result = await call('steamGetAchievement', achievementId);
             return parseSteamResponse(result) === true;
         },
         
@@ -107,7 +288,7 @@
          */
         async storeStats() {
             if (!isAvailable()) return false;
-            const result = await window.steamStoreStats();
+            const result = await call('steamStoreStats');
             return parseSteamResponse(result) === true;
         },
         
@@ -123,7 +304,7 @@
          */
         async setStatInt(statName, value) {
             if (!isAvailable()) return false;
-            const result = await window.steamSetStatInt(statName, value);
+            const result = await call('steamSetStatInt', statName, value);
             return parseSteamResponse(result) === true;
         },
         
@@ -134,7 +315,7 @@
          */
         async getStatInt(statName) {
             if (!isAvailable()) return 0;
-            const result = await window.steamGetStatInt(statName);
+            const result = await call('steamGetStatInt', statName);
             return parseInt(parseSteamResponse(result));
         },
         
@@ -144,27 +325,66 @@
         
         /**
          * Write file to Steam Cloud
+         * Strings are stored as UTF-8; ArrayBuffer, typed arrays and Blobs as-is.
          * @param {string} fileName
-         * @param {string} data
+         * @param {string|ArrayBuffer|ArrayBufferView|Blob} data
          * @returns {Promise<boolean>}
          */
         async fileWrite(fileName, data) {
             if (!isAvailable()) return false;
+            if (hasApiRoutes()) {
+                try {
+                    const response = await cloudRequest(fileName, { method: 'PUT', body: data });
+                    return response.ok;
+                } catch (e) {
+                    return false;
+                }
+            }
+            if (typeof data !== 'string') {
+                data = data instanceof Blob ? await data.text() : new TextDecoder().decode(data);
+            }
             const result = await window.steamFileWrite(fileName, data);
             return parseSteamResponse(result) === true;
         },
         
         /**
-         * Read file from Steam Cloud
+         * Read file from Steam Cloud as text (UTF-8)
          * @param {string} fileName
-         * @returns {Promise<string>}
+         * @returns {Promise<string>} '' if the file does not exist
          */
         async fileRead(fileName) {
             if (!isAvailable()) return '';
+            if (hasApiRoutes()) {
+                try {
+                    const response = await cloudRequest(fileName, { method: 'GET' });
+                    return response.ok ? await response.text() : '';
+                } catch (e) {
+                    return '';
+                }
+            }
             const result = await window.steamFileRead(fileName);
             return parseSteamResponse(result) || '';
         },
         
+        /**
+         * Read file from Steam Cloud as bytes
+         * @param {string} fileName
+         * @returns {Promise<Uint8Array|null>} null if the file does not exist
+         */
+        async fileReadBytes(fileName) {
+            if (!isAvailable()) return null;
+            if (hasApiRoutes()) {
+                try {
+                    const response = await cloudRequest(fileName, { method: 'GET' });
+                    return response.ok ? new Uint8Array(await response.arrayBuffer()) : null;
+                } catch (e) {
+                    return null;
+                }
+            }
+            const text = parseSteamResponse(await window.steamFileRead(fileName));
+            return text ? new TextEncoder().encode(text) : null;
+        },
+        
         /**
          * Check if file exists in Steam Cloud
          * @param {string} fileName
@@ -172,7 +392,7 @@
          */
         async fileExists(fileName) {
             if (!isAvailable()) return false;
-            const result = await window.steamFileExists(fileName);
+            const result = await call('steamFileExists', fileName);
             return parseSteamResponse(result) === true;
         },
         
@@ -188,7 +408,7 @@
          */
         async setRichPresence(key, value) {
             if (!isAvailable()) return false;
-            const result = await window.steamSetRichPresence(key, value);
+            const result = await call('steamSetRichPresence', key, value);
             return parseSteamResponse(result) === true;
         },
         
@@ -202,7 +422,7 @@
          */
         async isOverlayEnabled() {
             if (!isAvailable()) return false;
-            const result = await window.steamIsOverlayEnabled();
+            const result = await call('steamIsOverlayEnabled');
             return parseSteamResponse(result) === true;
         },
         
@@ -213,7 +433,7 @@
          */
         async activateOverlay(dialog) {
             if (!isAvailable()) return false;
-            const result = await window.steamActivateOverlay(dialog);
+            const result = await call('steamActivateOverlay', dialog);
             return parseSteamResponse(result) === true;
         },
         
@@ -228,7 +448,7 @@
          */
         async isDlcInstalled(appId) {
             if (!isAvailable()) return false;
-            const result = await window.steamIsDlcInstalled(appId);
+            const result = await call('steamIsDlcInstalled', appId);
             return parseSteamResponse(result) === true;
         },
         
@@ -238,7 +458,7 @@
          */
         async getDLCCount() {
             if (!isAvailable()) return 0;
-            const result = await window.steamGetDLCCount();
+            const result = await call('steamGetDLCCount');
             return parseInt(parseSteamResponse(result));
         },
         
@@ -252,7 +472,7 @@
          */
         async getFriendCount() {
             if (!isAvailable()) return 0;
-            const result = await window.steamGetFriendCount();
+            const result = await call('steamGetFriendCount');
             return parseInt(parseSteamResponse(result));
         },
         
@@ -263,30 +483,118 @@
          */
         async getFriendPersonaName(friendIndex) {
             if (!isAvailable()) return '';
-            const result = await window.steamGetFriendPersonaName(friendIndex);
+            const result = await call('steamGetFriendPersonaName', friendIndex);
             return parseSteamResponse(result) || '';
         },
         
         /**
-         * Get all friends (up to max)
+         * Get the whole friends list in one call
+         * Cached until a friend's name, status or game changes; listen for the
+         * 'gemcore-steam-friends-changed' window event to re-render.
+         * @returns {Promise<{steamId: string, name: string, personaState: number, gameAppId: number}[]>}
+         *   personaState: 0 offline, 1 online, 2 busy, 3 away, 4 snooze, 5 trade, 6 play
+         */
+        async getFriendsSnapshot() {
+            if (!isAvailable()) return [];
+            if (!friendsSnapshot) {
+                friendsSnapshot = call('steamGetFriends').then((result) =>
+                    (parseSteamResponse(result) || []).map(([steamId, name, personaState, gameAppId]) =>
+                        ({ steamId, name, personaState, gameAppId })));
+                friendsSnapshot.catch(() => { friendsSnapshot = null; });
+            }
+            return friendsSnapshot;
+        },
+        
+        /**
+         * Get all friends' names (up to max)
          * @param {number} max - Maximum number of friends to return (default: 100)
          * @returns {Promise<string[]>}
          */
         async getFriends(max = 100) {
             if (!isAvailable()) return [];
-            
-            const count = await this.getFriendCount();
-            const friends = [];
-            const limit = Math.min(count, max);
-            
-            for (let i = 0; i < limit; i++) {
-                const name = await this.getFriendPersonaName(i);
-                if (name) friends.push(name);
-            }
-            
-            return friends;
+            const friends = await this.getFriendsSnapshot();
+            return friends.slice(0, max).map((f) => f.name).filter((name) => name);
         },
         
+        // 
+        // Leaderboards
+        // 
+        
+        /**
+         * Look up a leaderboard
+         * @param {string} name
+         * @returns {Promise<{name: string, entryCount: number}|null>} null if it does not exist
+         */
+        async findLeaderboard(name) {
+            if (!isAvailable()) return null;
+            const entryCount = parseSteamResponse(await window.steamFindLeaderboard(name));
+            return typeof entryCount === 'number' ? { name, entryCount } : null;
+        },
+        
+        /**
+         * Upload a score
+         * @param {string} name
+         * @param {number} score
+         * @param {{keepBest?: boolean, details?: number[]}} options
+         *   keepBest (default true) keeps the user's better score; up to 64 int details
+         * @returns {Promise<{changed: boolean, score: number, globalRankNew: number, globalRankPrevious: number}|null>}
+         */
+        async uploadLeaderboardScore(name, score, { keepBest = true, details = [] } = {}) {
+            if (!isAvailable()) return null;
+            const result = parseSteamResponse(await window.steamUploadLeaderboardScore(name, score, keepBest, details));
+            if (!Array.isArray(result)) return null;
+            const [changed, uploadedScore, globalRankNew, globalRankPrevious] = result;
+            return { changed, score: uploadedScore, globalRankNew, globalRankPrevious };
+        },
+        
+        /**
+         * Download leaderboard entries start..end (at most 100 per call)
+         * Decoded and cached briefly by the launcher (steamworks.leaderboardCacheMs),
+         * so re-rendering a scoreboard page does not go back to Steam.
+         * @param {string} name
+         * @param {{type?: 'global'|'aroundUser'|'friends', start?: number, end?: number, details?: number}} options
+         *   global: ranks start..end (1-based); aroundUser: relative to the user's
+         *   rank (e.g. -4..5); friends: positions start..end in the friends list;
+         *   details: how many score details to return per entry (default 0)
+         * @returns {Promise<{totalEntries: number, entries: {steamId: string, globalRank: number, score: number, name: string, details?: number[]}[]}|null>}
+         */
+        async downloadLeaderboardEntries(name, { type = 'global', start = 1, end = 10, details = 0 } = {}) {
+            if (!isAvailable()) return null;
+            const result = parseSteamResponse(await window.steamDownloadLeaderboardEntries(name, type, start, end, details));
+            if (!Array.isArray(result)) return null;
+            const [totalEntries, rows] = result;
+            return {
+                totalEntries,
+                entries: rows.map(([steamId, globalRank, score, playerName, entryDetails]) =>
+                    (entryDetails ? { steamId, globalRank, score, name: playerName, details: entryDetails }
+                                  : { steamId, globalRank, score, name: playerName }))
+            };
+        },
+        
+        /**
+         * One page of a scoreboard (page 0 = the top `pageSize` entries)
+         * @param {string} name
+         * @param {number} page
+         * @param {{pageSize?: number, friends?: boolean}} options
+         */
+        async getLeaderboardPage(name, page = 0, { pageSize = 10, friends = false } = {}) {
+            const start = page * pageSize + 1;
+            return this.downloadLeaderboardEntries(name, {
+                type: friends ? 'friends' : 'global',
+                start,
+                end: start + pageSize - 1
+            });
+        },
+        
+        // 
+        // Steam Input
+        // 
+        
+        /**
+         * Native Steam Input: configure(), pressed(), analog(), stop()
+         */
+        input: steamInput,
+        
         // 
         // Screenshots
         // 
@@ -297,7 +605,7 @@
          */
         async triggerScreenshot() {
             if (!isAvailable()) return false;
-            const result = await window.steamTriggerScreenshot();
+            const result = await call('steamTriggerScreenshot');
             return parseSteamResponse(result) === true;
         },
         
@@ -311,7 +619,7 @@
          */
         async getCurrentGameLanguage() {
             if (!isAvailable()) return 'english';
-            const result = await window.steamGetCurrentGameLanguage();
+            const result = await call('steamGetCurrentGameLanguage');
             return parseSteamResponse(result) || 'english';
         },
         
@@ -321,7 +629,7 @@
          */
         async getAvailableGameLanguages() {
             if (!isAvailable()) return '';
-            const result = await window.steamGetAvailableGameLanguages();
+            const result = await call('steamGetAvailableGameLanguages');
             return parseSteamResponse(result) || '';
         },
         
@@ -331,7 +639,7 @@
          */
         async isSteamInBigPictureMode() {
             if (!isAvailable()) return false;
-            const result = await window.steamIsSteamInBigPictureMode();
+            const result = await call('steamIsSteamInBigPictureMode');
             return parseSteamResponse(result) === true;
         },
         
@@ -341,7 +649,7 @@
          */
         async isSteamDeck() {
             if (!isAvailable()) return false;
-            const result = await window.steamIsSteamDeck();
+            const result = await call('steamIsSteamDeck');
             return parseSteamResponse(result) === true;
         }
     };
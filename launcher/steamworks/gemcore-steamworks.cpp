@@ -10,6 +10,21 @@
 #include "steam/steam_api_flat.h"  // C API for ABI compatibility!
 
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <type_traits>
+#include <chrono>
+#include <atomic>
+#include <array>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+#include "gemcore-trace.h"
 
 // Platform-specific includes for sleep
 #ifdef _WIN32
@@ -24,6 +39,1122 @@ namespace steamworks {
 // Static initialization
 bool SteamworksManager::s_initialized = false;
 
+// 
+// Steam I/O worker
+// 
+
+namespace {
+
+/**
+ * Steam I/O worker: issues FileWriteAsync/FileReadAsync and polls their results
+ * (ISteamUtils::IsAPICallCompleted), so neither the UI thread nor the callback
+ * pump waits for Steam Cloud disk I/O. Started on first use, idle on a
+ * condition variable, polling every millisecond only while calls are in flight.
+ */
+class CloudWorker {
+public:
+    struct Request {
+        bool write = false;
+        std::string fileName;
+        std::vector<uint8_t> data;  // Write payload or read buffer, kept until Steam completes
+        std::function<void(bool)> writeDone;
+        std::function<void(bool, std::vector<uint8_t>)> readDone;
+        SteamAPICall_t call = k_uAPICallInvalid;
+    };
+    
+    ~CloudWorker() {
+        stop();
+    }
+    
+    void submit(Request&& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!thread_.joinable()) {
+                stopping_ = false;
+                thread_ = std::thread(&CloudWorker::run, this);
+            }
+            queue_.push_back(std::move(request));
+            wake_ = true;
+        }
+        cv_.notify_one();
+    }
+    
+    /**
+     * Finish every queued request, then stop the thread
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!thread_.joinable()) return;
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request> queue_;
+    bool wake_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+    
+    void run() {
+        gemcore::trace::setThreadName("steam-io");
+        std::vector<Request> inFlight;
+        
+        for (;;) {
+            std::vector<Request> ready;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (inFlight.empty() && queue_.empty()) {
+                    cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                    if (queue_.empty()) return;  // Stopping, nothing left
+                } else if (!inFlight.empty()) {
+                    // Steam signals completion only through polling or RunCallbacks
+                    cv_.wait_for(lock, std::chrono::milliseconds(1), [this] { return wake_; });
+                }
+                wake_ = false;
+                
+                // Requests for a file that is in flight wait their turn (write/read order)
+                for (auto it = queue_.begin(); it != queue_.end();) {
+                    if (isBusy(inFlight, it->fileName) || isBusy(ready, it->fileName)) {
+                        ++it;
+                        continue;
+                    }
+                    ready.push_back(std::move(*it));
+                    it = queue_.erase(it);
+                }
+            }
+            
+            for (auto& request : ready) {
+                if (start(request)) inFlight.push_back(std::move(request));
+            }
+            
+            for (size_t i = 0; i < inFlight.size();) {
+                if (poll(inFlight[i])) {
+                    inFlight.erase(inFlight.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+        }
+    }
+    
+    static bool isBusy(const std::vector<Request>& requests, const std::string& fileName) {
+        for (const auto& request : requests) {
+            if (request.fileName == fileName) return true;
+        }
+        return false;
+    }
+    
+    /**
+     * Issue the Steam call; false if the request already completed (failure, empty file)
+     */
+    static bool start(Request& request) {
+        ISteamRemoteStorage* storage = SteamRemoteStorage();
+        if (storage && request.write) {
+            request.call = storage->FileWriteAsync(request.fileName.c_str(), request.data.data(),
+                                                   static_cast<uint32>(request.data.size()));
+        } else if (storage && storage->FileExists(request.fileName.c_str())) {
+            int32 fileSize = storage->GetFileSize(request.fileName.c_str());
+            if (fileSize == 0) {
+                complete(request, true);
+                return false;
+            }
+            if (fileSize > 0) {
+                request.data.resize(fileSize);
+                request.call = storage->FileReadAsync(request.fileName.c_str(), 0, static_cast<uint32>(fileSize));
+            }
+        }
+        
+        if (request.call != k_uAPICallInvalid) return true;
+        complete(request, false);
+        return false;
+    }
+    
+    /**
+     * Check an in-flight call; true once it completed and the callback ran
+     */
+    static bool poll(Request& request) {
+        ISteamUtils* utils = SteamUtils();
+        bool failed = true;
+        if (utils && !utils->IsAPICallCompleted(request.call, &failed)) return false;
+        
+        bool ok = false;
+        if (utils && !failed) {
+            if (request.write) {
+                RemoteStorageFileWriteAsyncComplete_t result{};
+                ok = utils->GetAPICallResult(request.call, &result, sizeof(result),
+                                             RemoteStorageFileWriteAsyncComplete_t::k_iCallback, &failed) &&
+                     !failed && result.m_eResult == k_EResultOK;
+            } else {
+                RemoteStorageFileReadAsyncComplete_t result{};
+                ok = utils->GetAPICallResult(request.call, &result, sizeof(result),
+                                             RemoteStorageFileReadAsyncComplete_t::k_iCallback, &failed) &&
+                     !failed && result.m_eResult == k_EResultOK &&
+                     result.m_cubRead <= request.data.size() &&
+                     SteamRemoteStorage()->FileReadAsyncComplete(request.call, request.data.data(), result.m_cubRead);
+                if (ok) request.data.resize(result.m_cubRead);
+            }
+        }
+        
+        complete(request, ok);
+        return true;
+    }
+    
+    static void complete(Request& request, bool ok) {
+        if (request.write) {
+            if (request.writeDone) request.writeDone(ok);
+        } else if (request.readDone) {
+            if (!ok) request.data.clear();
+            request.readDone(ok, std::move(request.data));
+        }
+    }
+};
+
+CloudWorker& cloudWorker() {
+    static CloudWorker worker;
+    return worker;
+}
+
+// 
+// Callback pump
+// 
+
+std::atomic<int> g_pendingCalls{0};
+std::mutex g_wakeupMutex;
+std::function<void()> g_pumpWakeup;
+
+/**
+ * RunCallbacks thread: sleeps on a condition variable for the scheduled
+ * interval, woken early when an async call starts or on stop
+ */
+class CallbackPump {
+public:
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (thread_.joinable()) return;
+        stopping_ = false;
+        kicked_ = false;
+        thread_ = std::thread(&CallbackPump::run, this);
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!thread_.joinable()) return;
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+    
+    void kick() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            kicked_ = true;
+        }
+        cv_.notify_one();
+    }
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stopping_ = false;
+    bool kicked_ = false;
+    
+    void run() {
+        gemcore::trace::setThreadName("steam-callbacks");
+        CallbackSchedule schedule;
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            lock.unlock();
+            SteamAPI_RunCallbacks();
+            auto interval = std::chrono::milliseconds(schedule.next(g_pendingCalls.load(std::memory_order_relaxed)));
+            lock.lock();
+            
+            cv_.wait_for(lock, interval, [this] { return stopping_ || kicked_; });
+            if (kicked_) {
+                kicked_ = false;
+                schedule.reset();
+            }
+        }
+    }
+};
+
+CallbackPump& callbackPump() {
+    static CallbackPump pump;
+    return pump;
+}
+
+// 
+// Stats and achievements
+// 
+
+/**
+ * Write-behind mirror of stats and achievements
+ * Reads are answered from the mirror (the first read or write of a name asks
+ * Steam once, which also validates the name and type); writes only update it.
+ * Changes reach Steam as one batch of SetStat/SetAchievement calls plus a single
+ * StoreStats, at most once per store delay after the first StoreStats request,
+ * right away when a new unlock is waiting, and on shutdown.
+ */
+class StatsMirror {
+public:
+    ~StatsMirror() {
+        stop();
+    }
+    
+    void setDelay(uint32_t ms) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        delay_ = std::chrono::milliseconds(ms);
+    }
+    
+    template<typename T>
+    bool setStat(const std::string& name, T value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stat* stat = findStat<T>(name);
+        if (!stat) return false;
+        if (stat->get<T>() != value) {
+            stat->set(value);
+            stat->dirty = true;
+        }
+        return true;
+    }
+    
+    template<typename T>
+    bool getStat(const std::string& name, T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stat* stat = findStat<T>(name);
+        if (!stat) return false;
+        value = stat->get<T>();
+        return true;
+    }
+    
+    bool setAchievement(const std::string& name, bool achieved) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Achievement* achievement = findAchievement(name);
+        if (!achievement) return false;
+        if (achievement->achieved != achieved) {
+            achievement->achieved = achieved;
+            achievement->dirty = true;
+            if (achieved) newUnlock_ = true;
+        }
+        return true;
+    }
+    
+    bool getAchievement(const std::string& name, bool& achieved) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Achievement* achievement = findAchievement(name);
+        if (!achievement) return false;
+        achieved = achievement->achieved;
+        return true;
+    }
+    
+    void requestStore() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Already scheduled: this call is folded into it (unless an unlock is waiting)
+            if (storePending_ && !newUnlock_) return;
+            if (!storePending_) {
+                storePending_ = true;
+                deadline_ = std::chrono::steady_clock::now() + delay_;
+            }
+            if (!thread_.joinable()) {
+                stopping_ = false;
+                thread_ = std::thread(&StatsMirror::run, this);
+            }
+        }
+        cv_.notify_one();
+    }
+    
+    /**
+     * Stop the store thread and push everything still pending to Steam
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) thread_.join();
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (storePending_ || hasDirty()) flushLocked();
+        stats_.clear();
+        achievements_.clear();
+    }
+    
+private:
+    struct Stat {
+        bool isFloat = false;
+        int32_t i = 0;
+        float f = 0;
+        bool dirty = false;
+        
+        template<typename T> T get() const;
+        void set(int32_t value) { i = value; }
+        void set(float value) { f = value; }
+    };
+    
+    struct Achievement {
+        bool achieved = false;
+        bool dirty = false;
+    };
+    
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    std::unordered_map<std::string, Stat> stats_;
+    std::unordered_map<std::string, Achievement> achievements_;
+    std::chrono::milliseconds delay_{1000};
+    std::chrono::steady_clock::time_point deadline_;
+    bool storePending_ = false;
+    bool newUnlock_ = false;
+    bool stopping_ = false;
+    
+    template<typename T>
+    Stat* findStat(const std::string& name) {
+        auto it = stats_.find(name);
+        if (it != stats_.end()) {
+            return it->second.isFloat == std::is_same<T, float>::value ? &it->second : nullptr;
+        }
+        
+        ISteamUserStats* steamUserStats = SteamUserStats();
+        T value{};
+        if (!steamUserStats || !steamUserStats->GetStat(name.c_str(), &value)) return nullptr;
+        
+        Stat& stat = stats_[name];
+        stat.isFloat = std::is_same<T, float>::value;
+        stat.set(value);
+        return &stat;
+    }
+    
+    Achievement* findAchievement(const std::string& name) {
+        auto it = achievements_.find(name);
+        if (it != achievements_.end()) return &it->second;
+        
+        ISteamUserStats* steamUserStats = SteamUserStats();
+        bool achieved = false;
+        if (!steamUserStats || !steamUserStats->GetAchievement(name.c_str(), &achieved)) return nullptr;
+        
+        Achievement& achievement = achievements_[name];
+        achievement.achieved = achieved;
+        return &achievement;
+    }
+    
+    bool hasDirty() const {
+        for (const auto& entry : stats_) {
+            if (entry.second.dirty) return true;
+        }
+        for (const auto& entry : achievements_) {
+            if (entry.second.dirty) return true;
+        }
+        return false;
+    }
+    
+    void flushLocked() {
+        storePending_ = false;
+        newUnlock_ = false;
+        
+        ISteamUserStats* steamUserStats = SteamUserStats();
+        if (!steamUserStats) return;
+        
+        bool changed = false;
+        for (auto& entry : stats_) {
+            Stat& stat = entry.second;
+            if (!stat.dirty) continue;
+            changed = true;
+            if (stat.isFloat) {
+                steamUserStats->SetStat(entry.first.c_str(), stat.f);
+            } else {
+                steamUserStats->SetStat(entry.first.c_str(), stat.i);
+            }
+            stat.dirty = false;
+        }
+        for (auto& entry : achievements_) {
+            Achievement& achievement = entry.second;
+            if (!achievement.dirty) continue;
+            changed = true;
+            if (achievement.achieved) {
+                steamUserStats->SetAchievement(entry.first.c_str());
+            } else {
+                steamUserStats->ClearAchievement(entry.first.c_str());
+            }
+            achievement.dirty = false;
+        }
+        
+        // Nothing changed since the last store: Steam has it all already
+        if (changed) steamUserStats->StoreStats();
+    }
+    
+    void run() {
+        gemcore::trace::setThreadName("steam-stats");
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            cv_.wait(lock, [this] { return stopping_ || storePending_; });
+            if (stopping_) break;
+            
+            // Unlocks are stored without waiting (the player expects the popup)
+            cv_.wait_until(lock, deadline_, [this] { return stopping_ || newUnlock_; });
+            if (stopping_) break;
+            
+            GEMCORE_TRACE_SCOPE("steam.storeStats");
+            flushLocked();
+        }
+    }
+};
+
+template<> int32_t StatsMirror::Stat::get<int32_t>() const { return i; }
+template<> float StatsMirror::Stat::get<float>() const { return f; }
+
+StatsMirror& statsMirror() {
+    static StatsMirror mirror;
+    return mirror;
+}
+
+// 
+// Friends snapshot
+// 
+
+/**
+ * Caches the friends snapshot between PersonaStateChange_t callbacks, so a
+ * friend list is one call and no Steam queries while nothing changes.
+ * Uses the flat API for the per-friend queries (CSteamID ABI, see
+ * GetFriendPersonaName).
+ */
+class FriendsCache {
+public:
+    void start() {
+        callback_.Register(this, &FriendsCache::onPersonaStateChange);
+    }
+    
+    // Call with no thread running callbacks
+    void stop() {
+        callback_.Unregister();
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_.reset();
+        changedHandler_ = nullptr;
+    }
+    
+    void setChangedHandler(std::function<void()> handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        changedHandler_ = std::move(handler);
+    }
+    
+    std::shared_ptr<const std::vector<FriendInfo>> get() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!snapshot_) snapshot_ = build();
+        return snapshot_;
+    }
+    
+private:
+    std::mutex mutex_;
+    std::shared_ptr<const std::vector<FriendInfo>> snapshot_;
+    std::function<void()> changedHandler_;
+    
+    STEAM_CALLBACK_MANUAL(FriendsCache, onPersonaStateChange, PersonaStateChange_t, callback_);
+    
+    static std::shared_ptr<const std::vector<FriendInfo>> build() {
+        GEMCORE_TRACE_SCOPE("steam.friendsSnapshot");
+        auto friends = std::make_shared<std::vector<FriendInfo>>();
+        ISteamFriends* steamFriends = SteamAPI_SteamFriends_v018();
+        if (!steamFriends) return friends;
+        
+        int count = SteamAPI_ISteamFriends_GetFriendCount(steamFriends, k_EFriendFlagImmediate);
+        friends->reserve(count > 0 ? count : 0);
+        for (int i = 0; i < count; i++) {
+            uint64 friendID = SteamAPI_ISteamFriends_GetFriendByIndex(steamFriends, i, k_EFriendFlagImmediate);
+            if (friendID == 0) continue;
+            
+            FriendInfo info;
+            info.steamId = friendID;
+            const char* name = SteamAPI_ISteamFriends_GetFriendPersonaName(steamFriends, friendID);
+            if (name) info.name = name;
+            info.personaState = SteamAPI_ISteamFriends_GetFriendPersonaState(steamFriends, friendID);
+            FriendGameInfo_t game;
+            if (SteamAPI_ISteamFriends_GetFriendGamePlayed(steamFriends, friendID, &game)) {
+                info.gameAppId = game.m_gameID.AppID();
+            }
+            friends->push_back(std::move(info));
+        }
+        return friends;
+    }
+};
+
+void FriendsCache::onPersonaStateChange(PersonaStateChange_t*) {
+    std::function<void()> handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // A burst of changes (friends list download at startup) notifies once
+        if (!snapshot_) return;
+        snapshot_.reset();
+        handler = changedHandler_;
+    }
+    if (handler) handler();
+}
+
+FriendsCache& friendsCache() {
+    static FriendsCache cache;
+    return cache;
+}
+
+// 
+// Leaderboards
+// 
+
+/**
+ * Leaderboard calls through CCallResult (run by the callback pump), with the
+ * name -> handle lookups kept and downloaded pages decoded once and cached
+ * for a short TTL. Concurrent lookups of a name, or downloads of the same
+ * page, share one Steam call.
+ */
+class Leaderboards {
+public:
+    using PageDone = std::function<void(std::shared_ptr<const LeaderboardPage>)>;
+    
+    void setTtl(uint32_t ttlMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ttl_ = std::chrono::milliseconds(ttlMs);
+    }
+    
+    /**
+     * `done(handle)` with handle 0 if the leaderboard does not exist or the
+     * lookup failed (not remembered, so a later call asks again)
+     */
+    void find(const std::string& name, std::function<void(SteamLeaderboard_t)> done) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            Board& board = boards_[name];
+            if (board.handle) {
+                SteamLeaderboard_t handle = board.handle;
+                lock.unlock();
+                done(handle);
+                return;
+            }
+            board.waiting.push_back(std::move(done));
+            if (board.waiting.size() > 1) return;
+        }
+        
+        ISteamUserStats* stats = SteamUserStats();
+        SteamAPICall_t call = stats ? stats->FindLeaderboard(name.c_str()) : k_uAPICallInvalid;
+        CallResult<LeaderboardFindResult_t>::start(*this, call, [this, name](const LeaderboardFindResult_t* result) {
+            SteamLeaderboard_t handle = result && result->m_bLeaderboardFound ? result->m_hSteamLeaderboard : 0;
+            std::vector<std::function<void(SteamLeaderboard_t)>> waiting;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                Board& board = boards_[name];
+                if (handle) board.handle = handle;
+                waiting.swap(board.waiting);
+            }
+            for (auto& done : waiting) done(handle);
+        });
+    }
+    
+    void upload(SteamLeaderboard_t handle, int32_t score, bool keepBest, const std::vector<int32_t>& details,
+                std::function<void(const LeaderboardUpload&)> done) {
+        ISteamUserStats* stats = SteamUserStats();
+        int count = static_cast<int>(std::min<size_t>(details.size(), k_cLeaderboardDetailsMax));
+        SteamAPICall_t call = stats
+            ? stats->UploadLeaderboardScore(handle, keepBest ? k_ELeaderboardUploadScoreMethodKeepBest : k_ELeaderboardUploadScoreMethodForceUpdate,
+                                            score, details.data(), count)
+            : k_uAPICallInvalid;
+        CallResult<LeaderboardScoreUploaded_t>::start(*this, call, [this, handle, done](const LeaderboardScoreUploaded_t* result) {
+            LeaderboardUpload upload;
+            if (result && result->m_bSuccess) {
+                upload.ok = true;
+                upload.changed = result->m_bScoreChanged != 0;
+                upload.score = result->m_nScore;
+                upload.globalRankNew = result->m_nGlobalRankNew;
+                upload.globalRankPrevious = result->m_nGlobalRankPrevious;
+                if (upload.changed) dropPages(handle);
+            }
+            done(upload);
+        });
+    }
+    
+    void download(SteamLeaderboard_t handle, LeaderboardRequest request, int32_t start, int32_t end,
+                  int32_t maxDetails, PageDone done) {
+        maxDetails = std::min<int32_t>(std::max<int32_t>(maxDetails, 0), k_cLeaderboardDetailsMax);
+        if (request == LeaderboardRequest::Friends) {
+            // Steam returns the whole friends list; page it here
+            PageKey key{handle, request, 0, 0, maxDetails};
+            fetch(key, [start, end, done](std::shared_ptr<const LeaderboardPage> all) {
+                done(slice(std::move(all), start, end));
+            });
+            return;
+        }
+        if (end < start) end = start;
+        end = std::min(end, start + static_cast<int32_t>(MAX_PAGE) - 1);
+        fetch(PageKey{handle, request, start, end, maxDetails}, std::move(done));
+    }
+    
+    /**
+     * Fail the calls still in flight and forget everything (Shutdown; call
+     * with no thread running callbacks)
+     */
+    void stop() {
+        std::unordered_set<PendingCall*> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending.swap(pending_);
+        }
+        for (PendingCall* call : pending) call->cancel();
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        boards_.clear();
+        pages_.clear();
+    }
+    
+private:
+    static constexpr size_t MAX_PAGE = 100;
+    using Clock = std::chrono::steady_clock;
+    
+    /**
+     * A Steam call in flight; runs `done` once (nullptr on failure) and deletes itself
+     */
+    class PendingCall {
+    public:
+        virtual ~PendingCall() = default;
+        virtual void cancel() = 0;
+    };
+    
+    template<typename Result>
+    class CallResult final : public PendingCall {
+    public:
+        static void start(Leaderboards& owner, SteamAPICall_t call, std::function<void(const Result*)> done) {
+            if (call == k_uAPICallInvalid) {
+                done(nullptr);
+                return;
+            }
+            auto* pending = new CallResult(owner, std::move(done));
+            {
+                std::lock_guard<std::mutex> lock(owner.mutex_);
+                owner.pending_.insert(pending);
+            }
+            SteamworksManager::BeginAsyncCall();
+            pending->result_.Set(call, pending, &CallResult::onResult);
+        }
+        
+        void cancel() override {
+            result_.Cancel();
+            finish(nullptr);
+        }
+        
+    private:
+        Leaderboards& owner_;
+        std::function<void(const Result*)> done_;
+        CCallResult<CallResult, Result> result_;
+        
+        CallResult(Leaderboards& owner, std::function<void(const Result*)> done)
+            : owner_(owner), done_(std::move(done)) {}
+        
+        void onResult(Result* result, bool ioFailure) {
+            {
+                std::lock_guard<std::mutex> lock(owner_.mutex_);
+                owner_.pending_.erase(this);
+            }
+            finish(ioFailure ? nullptr : result);
+        }
+        
+        // CCallResult::Run does not touch the object after calling onResult
+        void finish(const Result* result) {
+            SteamworksManager::EndAsyncCall();
+            auto done = std::move(done_);
+            delete this;
+            done(result);
+        }
+    };
+    
+    struct Board {
+        SteamLeaderboard_t handle = 0;
+        std::vector<std::function<void(SteamLeaderboard_t)>> waiting;
+    };
+    
+    struct PageKey {
+        SteamLeaderboard_t handle;
+        LeaderboardRequest request;
+        int32_t start;
+        int32_t end;
+        int32_t maxDetails;
+        
+        bool operator<(const PageKey& other) const {
+            return std::tie(handle, request, start, end, maxDetails) <
+                   std::tie(other.handle, other.request, other.start, other.end, other.maxDetails);
+        }
+    };
+    
+    struct PageSlot {
+        std::shared_ptr<const LeaderboardPage> page;
+        Clock::time_point expires;
+        std::vector<PageDone> waiting;
+    };
+    
+    std::mutex mutex_;
+    std::chrono::milliseconds ttl_{10000};
+    std::unordered_map<std::string, Board> boards_;
+    std::map<PageKey, PageSlot> pages_;
+    std::unordered_set<PendingCall*> pending_;
+    
+    void fetch(const PageKey& key, PageDone done) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            for (auto it = pages_.begin(); it != pages_.end();) {
+                bool expired = it->second.page && it->second.expires <= now && it->second.waiting.empty();
+                it = expired ? pages_.erase(it) : std::next(it);
+            }
+            PageSlot& slot = pages_[key];
+            if (slot.page) {
+                auto page = slot.page;
+                lock.unlock();
+                done(std::move(page));
+                return;
+            }
+            slot.waiting.push_back(std::move(done));
+            if (slot.waiting.size() > 1) return;
+        }
+        
+        static const ELeaderboardDataRequest kRequests[] = {
+            k_ELeaderboardDataRequestGlobal,
+            k_ELeaderboardDataRequestGlobalAroundUser,
+            k_ELeaderboardDataRequestFriends
+        };
+        ISteamUserStats* stats = SteamUserStats();
+        SteamAPICall_t call = stats
+            ? stats->DownloadLeaderboardEntries(key.handle, kRequests[static_cast<int>(key.request)], key.start, key.end)
+            : k_uAPICallInvalid;
+        CallResult<LeaderboardScoresDownloaded_t>::start(*this, call, [this, key](const LeaderboardScoresDownloaded_t* result) {
+            std::shared_ptr<const LeaderboardPage> page = decode(result, key);
+            std::vector<PageDone> waiting;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = pages_.find(key);
+                if (it != pages_.end()) {
+                    waiting.swap(it->second.waiting);
+                    if (page->ok && ttl_.count() > 0) {
+                        it->second.page = page;
+                        it->second.expires = Clock::now() + ttl_;
+                    } else {
+                        pages_.erase(it);
+                    }
+                }
+            }
+            for (auto& done : waiting) done(page);
+        });
+    }
+    
+    // Cached pages of a leaderboard whose scores changed (downloads in flight still complete)
+    void dropPages(SteamLeaderboard_t handle) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = pages_.begin(); it != pages_.end();) {
+            if (it->first.handle == handle && it->second.waiting.empty()) {
+                it = pages_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    static std::shared_ptr<const LeaderboardPage> decode(const LeaderboardScoresDownloaded_t* result, const PageKey& key) {
+        GEMCORE_TRACE_SCOPE("steam.leaderboardPage");
+        auto page = std::make_shared<LeaderboardPage>();
+        ISteamUserStats* stats = SteamUserStats();
+        if (!result || !stats) return page;
+        
+        ISteamFriends* steamFriends = SteamAPI_SteamFriends_v018();
+        int32 details[k_cLeaderboardDetailsMax];
+        page->ok = true;
+        page->entries.reserve(result->m_cEntryCount > 0 ? result->m_cEntryCount : 0);
+        for (int i = 0; i < result->m_cEntryCount; i++) {
+            LeaderboardEntry_t raw;
+            if (!stats->GetDownloadedLeaderboardEntry(result->m_hSteamLeaderboardEntries, i, &raw,
+                                                      key.maxDetails ? details : nullptr, key.maxDetails)) {
+                continue;
+            }
+            LeaderboardEntry entry;
+            entry.steamId = raw.m_steamIDUser.ConvertToUint64();
+            entry.globalRank = raw.m_nGlobalRank;
+            entry.score = raw.m_nScore;
+            const char* name = steamFriends ? SteamAPI_ISteamFriends_GetFriendPersonaName(steamFriends, entry.steamId) : nullptr;
+            if (name) entry.name = name;
+            entry.details.assign(details, details + std::min(raw.m_cDetails, key.maxDetails));
+            page->entries.push_back(std::move(entry));
+        }
+        page->totalEntries = key.request == LeaderboardRequest::Friends
+            ? static_cast<int32_t>(page->entries.size())
+            : stats->GetLeaderboardEntryCount(key.handle);
+        return page;
+    }
+    
+    // Positions start..end (1-based) of a whole downloaded list
+    static std::shared_ptr<const LeaderboardPage> slice(std::shared_ptr<const LeaderboardPage> all, int32_t start, int32_t end) {
+        int32_t size = static_cast<int32_t>(all->entries.size());
+        start = std::max(start, 1);
+        end = std::min(end, std::min(size, start + static_cast<int32_t>(MAX_PAGE) - 1));
+        if (!all->ok || (start == 1 && end == size)) return all;
+        
+        auto page = std::make_shared<LeaderboardPage>();
+        page->ok = true;
+        page->totalEntries = all->totalEntries;
+        if (start <= end) page->entries.assign(all->entries.begin() + (start - 1), all->entries.begin() + end);
+        return page;
+    }
+};
+
+Leaderboards& leaderboards() {
+    static Leaderboards boards;
+    return boards;
+}
+
+// 
+// Steam Input
+// 
+
+/**
+ * Steam Input poller: samples the configured actions on its own thread at a
+ * fixed rate, independent of the webview's frame and gamepad polling, and
+ * publishes changed states as an InputLayout buffer. Action handles that are
+ * still 0 (Steam has not loaded the input config yet) are looked up again
+ * about once a second. If ISteamInput::Init fails the thread exits and
+ * failed() stays set until the next configure() (which retries) or stop().
+ */
+class InputPoller {
+public:
+    void configure(const std::string& actionSet, std::vector<std::string> digital,
+                   std::vector<std::string> analog, uint32_t rateHz) {
+        if (digital.size() > InputLayout::MAX_DIGITAL) digital.resize(InputLayout::MAX_DIGITAL);
+        if (analog.size() > InputLayout::MAX_ANALOG) analog.resize(InputLayout::MAX_ANALOG);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.actionSet = actionSet;
+            config_.digital = std::move(digital);
+            config_.analog = std::move(analog);
+            config_.rateHz = std::min<uint32_t>(std::max<uint32_t>(rateHz, 10), 1000);
+            configVersion_++;
+            if (failed_) {
+                thread_.join();  // Exited right after setting failed_
+                failed_ = false;
+            }
+            if (!thread_.joinable()) {
+                stopping_ = false;
+                thread_ = std::thread(&InputPoller::run, this);
+            }
+        }
+        cv_.notify_one();
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!thread_.joinable()) return;
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = false;
+        }
+        
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        state_.fill(0);
+        sequence_ = 0;
+    }
+    
+    bool failed() const {
+        return failed_;
+    }
+    
+    uint32_t state(uint8_t* out) {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        std::memcpy(out, state_.data(), state_.size());
+        return sequence_;
+    }
+    
+    void setChangedHandler(std::function<void(uint32_t)> handler) {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        changedHandler_ = std::move(handler);
+    }
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    using Buffer = std::array<uint8_t, InputLayout::SIZE>;
+    
+    struct Config {
+        std::string actionSet;
+        std::vector<std::string> digital;
+        std::vector<std::string> analog;
+        uint32_t rateHz = 250;
+    };
+    
+    struct Handles {
+        InputActionSetHandle_t actionSet = 0;
+        std::vector<InputDigitalActionHandle_t> digital;
+        std::vector<InputAnalogActionHandle_t> analog;
+        bool complete = false;
+    };
+    
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stopping_ = false;
+    // Init failed; thread_ has exited but is not joined yet. Written under mutex_,
+    // read without it (the route asks from inside the changed handler)
+    std::atomic<bool> failed_{false};
+    Config config_;
+    uint64_t configVersion_ = 0;
+    
+    std::mutex stateMutex_;
+    Buffer state_{};
+    uint32_t sequence_ = 0;
+    std::function<void(uint32_t)> changedHandler_;
+    
+    static void putU32(uint8_t* at, uint32_t value) {
+        for (int i = 0; i < 4; i++) at[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    
+    static void putF32(uint8_t* at, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(at, bits);
+    }
+    
+    static Handles resolve(ISteamInput* input, const Config& config) {
+        Handles handles;
+        handles.complete = true;
+        if (!config.actionSet.empty()) {
+            handles.actionSet = input->GetActionSetHandle(config.actionSet.c_str());
+            handles.complete &= handles.actionSet != 0;
+        }
+        for (const auto& name : config.digital) {
+            handles.digital.push_back(input->GetDigitalActionHandle(name.c_str()));
+            handles.complete &= handles.digital.back() != 0;
+        }
+        for (const auto& name : config.analog) {
+            handles.analog.push_back(input->GetAnalogActionHandle(name.c_str()));
+            handles.complete &= handles.analog.back() != 0;
+        }
+        return handles;
+    }
+    
+    static void sample(ISteamInput* input, const Handles& handles, Buffer& out) {
+        out.fill(0);
+        InputHandle_t controllers[STEAM_INPUT_MAX_COUNT];
+        int connected = input->GetConnectedControllers(controllers);
+        uint32_t count = std::min<uint32_t>(connected > 0 ? connected : 0, InputLayout::MAX_CONTROLLERS);
+        putU32(&out[4], count);
+        putU32(&out[8], static_cast<uint32_t>(handles.digital.size()));
+        putU32(&out[12], static_cast<uint32_t>(handles.analog.size()));
+        
+        for (uint32_t c = 0; c < count; c++) {
+            if (handles.actionSet) input->ActivateActionSet(controllers[c], handles.actionSet);
+            uint8_t* block = &out[InputLayout::HEADER_SIZE + c * InputLayout::CONTROLLER_SIZE];
+            
+            uint32_t pressed = 0;
+            for (size_t i = 0; i < handles.digital.size(); i++) {
+                if (!handles.digital[i]) continue;
+                InputDigitalActionData_t data = input->GetDigitalActionData(controllers[c], handles.digital[i]);
+                if (data.bActive && data.bState) pressed |= 1u << i;
+            }
+            putU32(block, pressed);
+            
+            for (size_t i = 0; i < handles.analog.size(); i++) {
+                if (!handles.analog[i]) continue;
+                InputAnalogActionData_t data = input->GetAnalogActionData(controllers[c], handles.analog[i]);
+                if (!data.bActive) continue;
+                putF32(block + 4 + i * 8, data.x);
+                putF32(block + 8 + i * 8, data.y);
+            }
+        }
+    }
+    
+    void publish(const Buffer& next) {
+        std::function<void(uint32_t)> handler;
+        uint32_t sequence;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            // Compare everything but the sequence number
+            if (sequence_ != 0 && std::memcmp(&state_[4], &next[4], state_.size() - 4) == 0) return;
+            state_ = next;
+            sequence = ++sequence_;
+            if (sequence == 0) sequence = ++sequence_;  // 0 means "not running"
+            putU32(&state_[0], sequence);
+            handler = changedHandler_;
+        }
+        if (handler) handler(sequence);
+    }
+    
+    void run() {
+        gemcore::trace::setThreadName("steam-input");
+        ISteamInput* input = SteamInput();
+        if (!input || !input->Init(true)) {
+            // Always log errors (even in release mode)
+            std::cerr << " Steam Input: init failed, controller input disabled" << std::endl;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                failed_ = true;
+            }
+            // Sequence 0: parked polls get the error instead of waiting for a change
+            std::function<void(uint32_t)> handler;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                handler = changedHandler_;
+            }
+            if (handler) handler(0);
+            return;
+        }
+        
+        Config config;
+        Handles handles;
+        uint64_t version = 0;
+        Clock::time_point resolvedAt;
+        Buffer next{};
+        auto wakeAt = Clock::now();
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            bool reconfigured = version != configVersion_;
+            if (reconfigured) {
+                config = config_;
+                version = configVersion_;
+            }
+            lock.unlock();
+            
+            input->RunFrame(true);
+            auto now = Clock::now();
+            if (reconfigured || (!handles.complete && now - resolvedAt > std::chrono::seconds(1))) {
+                handles = resolve(input, config);
+                resolvedAt = now;
+            }
+            sample(input, handles, next);
+            publish(next);
+            
+            // Fixed rate; after a stall, resume from now instead of catching up
+            auto period = std::chrono::microseconds(1000000 / config.rateHz);
+            wakeAt += period;
+            if (wakeAt < now) wakeAt = now + period;
+            
+            lock.lock();
+            cv_.wait_until(lock, wakeAt, [&] { return stopping_ || version != configVersion_; });
+        }
+        lock.unlock();
+        input->Shutdown();
+    }
+};
+
+InputPoller& inputPoller() {
+    static InputPoller poller;
+    return poller;
+}
+
+} // namespace
+
 // 
 // Core API
 // 
@@ -40,11 +1171,14 @@ bool SteamworksManager::Init() {
     return false;
     #endif
     
+    if (!LoadSteamApi()) return false;
+    
     // Initialize Steam API
     // This will look for steam_appid.txt in the current directory
     // or use the app ID from the Steam client if running through Steam
     if (SteamAPI_Init()) {
         s_initialized = true;
+        friendsCache().start();
         
         #ifndef NDEBUG
         std::cout << " Steamworks initialized successfully!" << std::endl;
@@ -53,15 +1187,12 @@ bool SteamworksManager::Init() {
         std::cout << "   App ID: " << GetAppID() << std::endl;
         #endif
         
-        // Request friends list to be downloaded
+        #ifndef NDEBUG
         ISteamFriends* steamFriends = SteamFriends();
         if (steamFriends) {
-            int friendCount = steamFriends->GetFriendCount(k_EFriendFlagAll);
-            
-            #ifndef NDEBUG
-            std::cout << "   Friends: " << friendCount << " total" << std::endl;
-            #endif
+            std::cout << "   Friends: " << steamFriends->GetFriendCount(k_EFriendFlagAll) << " total" << std::endl;
         }
+        #endif
         
         return true;
     }
@@ -77,6 +1208,14 @@ bool SteamworksManager::Init() {
 void SteamworksManager::Shutdown() {
     if (!s_initialized) return;
     
+    // Pending stats and queued saves must reach Steam before the API goes away
+    statsMirror().stop();
+    cloudWorker().stop();
+    inputPoller().stop();
+    StopCallbackPump();
+    friendsCache().stop();
+    leaderboards().stop();
+    
     SteamAPI_Shutdown();
     s_initialized = false;
     
@@ -94,6 +1233,41 @@ bool SteamworksManager::IsInitialized() {
     return s_initialized;
 }
 
+// 
+// Callback pump
+// 
+
+void SteamworksManager::StartCallbackPump() {
+    if (!s_initialized) return;
+    SetPumpWakeup([] { callbackPump().kick(); });
+    callbackPump().start();
+}
+
+void SteamworksManager::StopCallbackPump() {
+    callbackPump().stop();
+    SetPumpWakeup(nullptr);
+}
+
+void SteamworksManager::BeginAsyncCall() {
+    if (g_pendingCalls.fetch_add(1, std::memory_order_relaxed) == 0) {
+        std::lock_guard<std::mutex> lock(g_wakeupMutex);
+        if (g_pumpWakeup) g_pumpWakeup();
+    }
+}
+
+void SteamworksManager::EndAsyncCall() {
+    g_pendingCalls.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int SteamworksManager::PendingAsyncCalls() {
+    return g_pendingCalls.load(std::memory_order_relaxed);
+}
+
+void SteamworksManager::SetPumpWakeup(std::function<void()> wakeup) {
+    std::lock_guard<std::mutex> lock(g_wakeupMutex);
+    g_pumpWakeup = std::move(wakeup);
+}
+
 // 
 // User Info
 // 
@@ -133,10 +1307,7 @@ uint32_t SteamworksManager::GetAppID() {
 bool SteamworksManager::UnlockAchievement(const std::string& achievementId) {
     if (!s_initialized) return false;
     
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    bool success = steamUserStats->SetAchievement(achievementId.c_str());
+    bool success = statsMirror().setAchievement(achievementId, true);
     
     #ifndef NDEBUG
     if (success) {
@@ -149,29 +1320,22 @@ bool SteamworksManager::UnlockAchievement(const std::string& achievementId) {
 
 bool SteamworksManager::GetAchievement(const std::string& achievementId, bool& achieved) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->GetAchievement(achievementId.c_str(), &achieved);
+    return statsMirror().getAchievement(achievementId, achieved);
 }
 
 bool SteamworksManager::ClearAchievement(const std::string& achievementId) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->ClearAchievement(achievementId.c_str());
+    return statsMirror().setAchievement(achievementId, false);
 }
 
 bool SteamworksManager::StoreStats() {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->StoreStats();
+    statsMirror().requestStore();
+    return true;
+}
+
+void SteamworksManager::SetStoreStatsDelay(uint32_t delayMs) {
+    statsMirror().setDelay(delayMs);
 }
 
 // 
@@ -180,38 +1344,22 @@ bool SteamworksManager::StoreStats() {
 
 bool SteamworksManager::SetStatInt(const std::string& statName, int32_t value) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->SetStat(statName.c_str(), value);
+    return statsMirror().setStat(statName, value);
 }
 
 bool SteamworksManager::GetStatInt(const std::string& statName, int32_t& value) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->GetStat(statName.c_str(), &value);
+    return statsMirror().getStat(statName, value);
 }
 
 bool SteamworksManager::SetStatFloat(const std::string& statName, float value) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->SetStat(statName.c_str(), value);
+    return statsMirror().setStat(statName, value);
 }
 
 bool SteamworksManager::GetStatFloat(const std::string& statName, float& value) {
     if (!s_initialized) return false;
-    
-    ISteamUserStats* steamUserStats = SteamUserStats();
-    if (!steamUserStats) return false;
-    
-    return steamUserStats->GetStat(statName.c_str(), &value);
+    return statsMirror().getStat(statName, value);
 }
 
 // 
@@ -290,6 +1438,34 @@ int32_t SteamworksManager::FileGetSize(const std::string& fileName) {
     return steamRemoteStorage->GetFileSize(fileName.c_str());
 }
 
+void SteamworksManager::FileWriteAsync(const std::string& fileName, std::vector<uint8_t> data,
+                                       std::function<void(bool)> done) {
+    if (!s_initialized) {
+        if (done) done(false);
+        return;
+    }
+    
+    CloudWorker::Request request;
+    request.write = true;
+    request.fileName = fileName;
+    request.data = std::move(data);
+    request.writeDone = std::move(done);
+    cloudWorker().submit(std::move(request));
+}
+
+void SteamworksManager::FileReadAsync(const std::string& fileName,
+                                      std::function<void(bool, std::vector<uint8_t>)> done) {
+    if (!s_initialized) {
+        if (done) done(false, {});
+        return;
+    }
+    
+    CloudWorker::Request request;
+    request.fileName = fileName;
+    request.readDone = std::move(done);
+    cloudWorker().submit(std::move(request));
+}
+
 // 
 // Rich Presence
 // 
@@ -409,6 +1585,95 @@ std::string SteamworksManager::GetFriendPersonaName(int32_t friendIndex) {
     return name;
 }
 
+std::shared_ptr<const std::vector<FriendInfo>> SteamworksManager::GetFriendsSnapshot() {
+    if (!s_initialized) return std::make_shared<const std::vector<FriendInfo>>();
+    return friendsCache().get();
+}
+
+void SteamworksManager::SetFriendsChangedHandler(std::function<void()> handler) {
+    friendsCache().setChangedHandler(std::move(handler));
+}
+
+// 
+// Leaderboards
+// 
+
+void SteamworksManager::FindLeaderboard(const std::string& name, std::function<void(bool, int32_t)> done) {
+    if (!s_initialized) {
+        done(false, 0);
+        return;
+    }
+    leaderboards().find(name, [done](SteamLeaderboard_t handle) {
+        ISteamUserStats* stats = SteamUserStats();
+        done(handle != 0, handle && stats ? stats->GetLeaderboardEntryCount(handle) : 0);
+    });
+}
+
+void SteamworksManager::UploadLeaderboardScore(const std::string& name, int32_t score, bool keepBest,
+                                               const std::vector<int32_t>& details,
+                                               std::function<void(const LeaderboardUpload&)> done) {
+    if (!s_initialized) {
+        done(LeaderboardUpload{});
+        return;
+    }
+    leaderboards().find(name, [score, keepBest, details, done](SteamLeaderboard_t handle) {
+        if (!handle) {
+            done(LeaderboardUpload{});
+            return;
+        }
+        leaderboards().upload(handle, score, keepBest, details, done);
+    });
+}
+
+void SteamworksManager::DownloadLeaderboardEntries(const std::string& name, LeaderboardRequest request,
+                                                   int32_t start, int32_t end, int32_t maxDetails,
+                                                   std::function<void(std::shared_ptr<const LeaderboardPage>)> done) {
+    if (!s_initialized) {
+        done(std::make_shared<LeaderboardPage>());
+        return;
+    }
+    leaderboards().find(name, [request, start, end, maxDetails, done](SteamLeaderboard_t handle) {
+        if (!handle) {
+            done(std::make_shared<LeaderboardPage>());
+            return;
+        }
+        leaderboards().download(handle, request, start, end, maxDetails, done);
+    });
+}
+
+void SteamworksManager::SetLeaderboardCacheTtl(uint32_t ttlMs) {
+    leaderboards().setTtl(ttlMs);
+}
+
+// 
+// Steam Input
+// 
+
+bool SteamworksManager::ConfigureInput(const std::string& actionSet,
+                                       const std::vector<std::string>& digitalActions,
+                                       const std::vector<std::string>& analogActions,
+                                       uint32_t rateHz) {
+    if (!s_initialized) return false;
+    inputPoller().configure(actionSet, digitalActions, analogActions, rateHz);
+    return true;
+}
+
+void SteamworksManager::StopInput() {
+    inputPoller().stop();
+}
+
+bool SteamworksManager::InputFailed() {
+    return inputPoller().failed();
+}
+
+uint32_t SteamworksManager::GetInputState(uint8_t* out) {
+    return inputPoller().state(out);
+}
+
+void SteamworksManager::SetInputChangedHandler(std::function<void(uint32_t)> handler) {
+    inputPoller().setChangedHandler(std::move(handler));
+}
+
 // 
 // Screenshots
 // 
@@ -13,7 +13,10 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <cstdint>
+#include <functional>
+#include <algorithm>
 
 // Forward declare Steam API types
 // Note: We include the actual Steam headers in the .cpp file
@@ -23,6 +26,105 @@ typedef uint32_t AppId_t;
 namespace gemcore {
 namespace steamworks {
 
+/**
+ * One friend in a friends snapshot
+ */
+struct FriendInfo {
+    uint64_t steamId = 0;
+    std::string name;
+    int32_t personaState = 0;   // EPersonaState (0 = offline)
+    uint32_t gameAppId = 0;     // App the friend is playing, 0 if none
+};
+
+/**
+ * Adaptive RunCallbacks interval for the callback pump
+ * BUSY_MS while async calls are pending; when idle the interval doubles from
+ * IDLE_MIN_MS up to IDLE_MAX_MS, so an idle game wakes about 10 times a second.
+ */
+class CallbackSchedule {
+public:
+    static constexpr uint32_t BUSY_MS = 2;
+    static constexpr uint32_t IDLE_MIN_MS = 16;
+    static constexpr uint32_t IDLE_MAX_MS = 100;
+    
+    uint32_t next(int pendingCalls) {
+        if (pendingCalls > 0) {
+            idle_ = IDLE_MIN_MS;
+            return BUSY_MS;
+        }
+        uint32_t interval = idle_;
+        idle_ = std::min(idle_ * 2, IDLE_MAX_MS);
+        return interval;
+    }
+    
+    void reset() {
+        idle_ = IDLE_MIN_MS;
+    }
+    
+private:
+    uint32_t idle_ = IDLE_MIN_MS;
+};
+
+/**
+ * One downloaded leaderboard entry
+ */
+struct LeaderboardEntry {
+    uint64_t steamId = 0;
+    int32_t globalRank = 0;
+    int32_t score = 0;
+    std::string name;              // Persona name, empty if Steam does not know it yet
+    std::vector<int32_t> details;  // Up to the requested maxDetails
+};
+
+/**
+ * Which entries a leaderboard download covers
+ *   Global      ranks start..end
+ *   AroundUser  start..end relative to the user's rank (e.g. -4..5)
+ *   Friends     the user and their friends, positions start..end of that list
+ */
+enum class LeaderboardRequest {
+    Global,
+    AroundUser,
+    Friends
+};
+
+/**
+ * One page of a leaderboard download
+ */
+struct LeaderboardPage {
+    bool ok = false;
+    int32_t totalEntries = 0;  // Whole leaderboard (Global/AroundUser) or friends list
+    std::vector<LeaderboardEntry> entries;
+};
+
+/**
+ * Result of a score upload
+ */
+struct LeaderboardUpload {
+    bool ok = false;
+    bool changed = false;         // False if a kept best score was not beaten
+    int32_t score = 0;
+    int32_t globalRankNew = 0;
+    int32_t globalRankPrevious = 0;
+};
+
+/**
+ * Steam Input state buffer layout (little-endian)
+ *   header   u32 sequence (bumped on every change), u32 connected controllers,
+ *            u32 digital action count, u32 analog action count
+ *   then MAX_CONTROLLERS blocks of
+ *            u32 pressed bits (bit i = digital action i), f32 x, f32 y per analog action
+ * Actions keep the order they were configured in.
+ */
+struct InputLayout {
+    static constexpr uint32_t MAX_CONTROLLERS = 4;
+    static constexpr uint32_t MAX_DIGITAL = 32;
+    static constexpr uint32_t MAX_ANALOG = 8;
+    static constexpr uint32_t HEADER_SIZE = 16;
+    static constexpr uint32_t CONTROLLER_SIZE = 4 + MAX_ANALOG * 8;
+    static constexpr uint32_t SIZE = HEADER_SIZE + MAX_CONTROLLERS * CONTROLLER_SIZE;
+};
+
 /**
  * Steamworks Manager - Singleton wrapper around Steam API
  * Handles initialization, callbacks, and all Steam features
@@ -33,6 +135,13 @@ public:
     // Core API
     // 
     
+    /**
+     * Load libsteam_api and resolve its entry points (steam-api-stubs.cpp)
+     * Runs once; later calls return the first result. Init() calls it, so
+     * only games with Steamworks enabled ever open the library.
+     */
+    static bool LoadSteamApi();
+    
     /**
      * Initialize Steamworks API
      * Must be called before any other Steam functions
@@ -42,7 +151,7 @@ public:
     
     /**
      * Shutdown Steamworks API
-     * Call before app exits
+     * Call before app exits (finishes queued Steam Cloud requests first)
      */
     static void Shutdown();
     
@@ -58,6 +167,38 @@ public:
      */
     static bool IsInitialized();
     
+    // 
+    // Callback pump
+    // 
+    
+    /**
+     * Run RunCallbacks on a background thread on a CallbackSchedule
+     * Steam callbacks and call results then run on that thread: handlers that
+     * touch the webview must go through dispatch()/resolve().
+     */
+    static void StartCallbackPump();
+    
+    /**
+     * Stop the callback pump thread (before Shutdown)
+     */
+    static void StopCallbackPump();
+    
+    /**
+     * Track an async call whose result arrives through RunCallbacks (CCallResult,
+     * callbacks such as UserStatsStored_t). The pump polls every
+     * CallbackSchedule::BUSY_MS while any are pending and is woken at once
+     * when the first one starts.
+     */
+    static void BeginAsyncCall();
+    static void EndAsyncCall();
+    static int PendingAsyncCalls();
+    
+    /**
+     * Wakeup for a pump driven by another loop (GTK main loop); called from
+     * any thread when the pending count rises from zero. nullptr clears it.
+     */
+    static void SetPumpWakeup(std::function<void()> wakeup);
+    
     // 
     // User Info
     // 
@@ -79,6 +220,8 @@ public:
     
     // 
     // Achievements
+    // Stats and achievements are served from a native mirror: reads do not call
+    // into Steam after the first one per name, writes are applied on StoreStats.
     // 
     
     /**
@@ -101,11 +244,18 @@ public:
     
     /**
      * Store stats and achievements
-     * Must be called after setting stats/achievements to persist them
-     * Returns: true if successful
+     * Must be called after setting stats/achievements to persist them.
+     * Coalesced: the changes go to Steam with one StoreStats once the store
+     * delay has passed (at once for new unlocks, and always on Shutdown).
+     * Returns: true if Steamworks is initialized
      */
     static bool StoreStats();
     
+    /**
+     * Store delay for StoreStats (config steamworks.storeStatsDelayMs, default 1000)
+     */
+    static void SetStoreStatsDelay(uint32_t delayMs);
+    
     // 
     // Stats
     // 
@@ -159,6 +309,25 @@ public:
      */
     static int32_t FileGetSize(const std::string& fileName);
     
+    // 
+    // Cloud Storage (asynchronous)
+    // 
+    
+    /**
+     * Queue a Steam Cloud write on the Steam I/O worker (FileWriteAsync)
+     * `done` runs on the worker thread once Steam reports the result.
+     * Requests for the same file complete in submission order.
+     */
+    static void FileWriteAsync(const std::string& fileName, std::vector<uint8_t> data,
+                               std::function<void(bool)> done);
+    
+    /**
+     * Queue a Steam Cloud read on the Steam I/O worker (FileReadAsync)
+     * `done` runs on the worker thread; false for missing files and failed reads.
+     */
+    static void FileReadAsync(const std::string& fileName,
+                              std::function<void(bool, std::vector<uint8_t>)> done);
+    
     // 
     // Rich Presence
     // 
@@ -224,6 +393,94 @@ public:
      */
     static std::string GetFriendPersonaName(int32_t friendIndex);
     
+    /**
+     * All friends (k_EFriendFlagImmediate) in one snapshot
+     * Built on first use and cached until a PersonaStateChange_t arrives.
+     */
+    static std::shared_ptr<const std::vector<FriendInfo>> GetFriendsSnapshot();
+    
+    /**
+     * Called when the cached snapshot goes stale, on the thread running
+     * callbacks; at most once per snapshot handed out. nullptr clears it.
+     */
+    static void SetFriendsChangedHandler(std::function<void()> handler);
+    
+    // 
+    // Leaderboards
+    // Asynchronous: results arrive through RunCallbacks (CCallResult), so
+    // `done` runs on the thread running callbacks, with ok = false on failure
+    // or while Steam is not initialized.
+    // 
+    
+    /**
+     * Look up a leaderboard by name; the handle is kept for later calls
+     * `done(found, entryCount)`
+     */
+    static void FindLeaderboard(const std::string& name, std::function<void(bool, int32_t)> done);
+    
+    /**
+     * Upload a score (keepBest keeps the better of the old and new score)
+     * A changed score drops the leaderboard's cached pages.
+     */
+    static void UploadLeaderboardScore(const std::string& name, int32_t score, bool keepBest,
+                                       const std::vector<int32_t>& details,
+                                       std::function<void(const LeaderboardUpload&)> done);
+    
+    /**
+     * Download entries start..end (at most 100 per page; see LeaderboardRequest)
+     * Pages are decoded into LeaderboardEntry lists and cached for the
+     * leaderboard cache TTL; identical requests in flight share one download.
+     * Friends lists are downloaded once and paged natively.
+     */
+    static void DownloadLeaderboardEntries(const std::string& name, LeaderboardRequest request,
+                                           int32_t start, int32_t end, int32_t maxDetails,
+                                           std::function<void(std::shared_ptr<const LeaderboardPage>)> done);
+    
+    /**
+     * How long downloaded pages are reused (config steamworks.leaderboardCacheMs,
+     * default 10000; 0 disables the cache)
+     */
+    static void SetLeaderboardCacheTtl(uint32_t ttlMs);
+    
+    // 
+    // Steam Input
+    // 
+    
+    /**
+     * Start (or reconfigure) the Steam Input poller
+     * A "steam-input" thread activates `actionSet` on every controller and
+     * samples the given actions `rateHz` times a second (10-1000) into an
+     * InputLayout buffer. Extra actions beyond MAX_DIGITAL/MAX_ANALOG are ignored.
+     */
+    static bool ConfigureInput(const std::string& actionSet,
+                               const std::vector<std::string>& digitalActions,
+                               const std::vector<std::string>& analogActions,
+                               uint32_t rateHz);
+    
+    /**
+     * Stop the poller and shut Steam Input down (Shutdown does this too)
+     */
+    static void StopInput();
+    
+    /**
+     * True once Steam Input failed to initialize on the poller thread
+     * The poller is not running then; ConfigureInput() retries, StopInput() clears it.
+     */
+    static bool InputFailed();
+    
+    /**
+     * Copy the latest input state (InputLayout::SIZE bytes) into `out`
+     * Returns: its sequence number, 0 while the poller is not running
+     */
+    static uint32_t GetInputState(uint8_t* out);
+    
+    /**
+     * Called on the poller thread with the new sequence number whenever the
+     * input state changes, and with 0 if Steam Input fails to initialize.
+     * nullptr clears it.
+     */
+    static void SetInputChangedHandler(std::function<void(uint32_t)> handler);
+    
     // 
     // Screenshots
     // 
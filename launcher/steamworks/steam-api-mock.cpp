@@ -0,0 +1,1510 @@
+/**
+ *  Gemcore Steam API Mock
+ * In-process libsteam_api replacement for offline tests and benchmarks (see
+ * steam-api-mock.h). Written against the SDK in deps/steamworks: a newer SDK
+ * may add interface methods, which then need an override in the "not used by
+ * Gemcore" block of their class.
+ */
+
+#include "steam-api-mock.h"
+#include "gemcore-steamworks.h"
+
+#include "steam/steam_api.h"
+#include "steam/steam_api_flat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Named friend of CCallbackBase: sets the registration flag and callback id
+ * the same way the real SteamAPI_RegisterCallback does
+ */
+class CCallbackMgr {
+public:
+    static void setRegistered(CCallbackBase* callback, int callbackId, bool registered) {
+        if (registered) {
+            callback->m_nCallbackFlags |= CCallbackBase::k_ECallbackFlagsRegistered;
+            callback->m_iCallback = callbackId;
+        } else {
+            callback->m_nCallbackFlags &= ~CCallbackBase::k_ECallbackFlagsRegistered;
+        }
+    }
+};
+
+namespace gemcore {
+namespace steammock {
+
+namespace {
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+struct Method {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<double> failure{0.0};
+};
+
+struct Friend {
+    uint64_t steamId;
+    std::string name;
+    EPersonaState state;
+    uint32_t gameAppId;
+};
+
+struct InputAction {
+    bool pressed = false;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+const uint64_t kUserSteamId = 76561197960265729ull;
+
+struct LeaderboardRow {
+    uint64_t steamId;
+    int32 score;
+    std::vector<int32> details;
+};
+
+struct Leaderboard {
+    std::string name;
+    std::vector<LeaderboardRow> rows;  // Best score first
+};
+
+struct Stat {
+    bool isFloat;
+    int32 i;
+    float f;
+};
+
+struct AsyncCall {
+    Clock::time_point due;
+    int callbackId;
+    std::vector<uint8_t> result;    // The call result struct
+    std::vector<uint8_t> payload;   // FileReadAsync data until FileReadAsyncComplete
+    bool ioFailure = false;
+    CCallbackBase* callResult = nullptr;
+};
+
+struct QueuedCallback {
+    Clock::time_point due;
+    int callbackId;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Shared state behind all mock interfaces. `mutex` guards everything except
+ * the per-method counters.
+ */
+struct Backend {
+    std::mutex mutex;
+    Settings settings;
+    bool initialized = false;
+    uintptr_t contextCounter = 1;
+    std::mt19937 random{1};
+    
+    std::mutex methodsMutex;
+    std::map<std::string, std::unique_ptr<Method>> methods;
+    
+    std::vector<Friend> friends;
+    std::unordered_map<std::string, Stat> stats;
+    std::unordered_map<std::string, bool> achievements;
+    std::vector<std::string> cloudListing;  // GetFileNameAndSize keeps returned names alive
+    
+    // Leaderboard handle - 1 indexes leaderboards; downloads keep (rank, row) until evicted
+    std::vector<Leaderboard> leaderboards;
+    std::map<SteamLeaderboardEntries_t, std::vector<std::pair<int, LeaderboardRow>>> downloads;
+    SteamLeaderboardEntries_t nextDownload = 1;
+    
+    // Steam Input: handle - 1 indexes inputNames (action sets and actions alike);
+    // the control API writes inputStaged, RunFrame publishes it as inputFrame
+    std::vector<std::string> inputNames;
+    std::map<std::pair<uint32_t, std::string>, InputAction> inputStaged;
+    std::map<std::pair<uint32_t, std::string>, InputAction> inputFrame;
+    
+    SteamAPICall_t nextCall = 1;
+    std::map<SteamAPICall_t, AsyncCall> calls;
+    std::deque<QueuedCallback> callbacks;
+    std::multimap<int, CCallbackBase*> listeners;
+    
+    Method& method(const std::string& name) {
+        std::lock_guard<std::mutex> lock(methodsMutex);
+        auto& entry = methods[name];
+        if (!entry) entry.reset(new Method());
+        return *entry;
+    }
+    
+    /**
+     * Count the call, add the configured latency and draw an injected failure;
+     * false means the call fails
+     */
+    bool enter(Method& m) {
+        m.calls.fetch_add(1, std::memory_order_relaxed);
+        uint32_t latencyUs;
+        bool fail = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            latencyUs = settings.callLatencyUs;
+            double failure = m.failure.load(std::memory_order_relaxed);
+            if (failure > 0.0) fail = std::uniform_real_distribution<double>(0.0, 1.0)(random) < failure;
+        }
+        if (latencyUs) {
+            // sleep_for alone overshoots short delays by tens of microseconds
+            auto until = Clock::now() + std::chrono::microseconds(latencyUs);
+            if (latencyUs > 1000) std::this_thread::sleep_until(until - std::chrono::microseconds(500));
+            while (Clock::now() < until) {}
+        }
+        return !fail;
+    }
+    
+    Clock::time_point asyncDue() {
+        return Clock::now() + std::chrono::milliseconds(settings.asyncLatencyMs);
+    }
+    
+    template<typename T>
+    SteamAPICall_t startCall(const T& result, bool ioFailure, std::vector<uint8_t> payload = {}) {
+        AsyncCall call;
+        call.due = asyncDue();
+        call.callbackId = T::k_iCallback;
+        call.result.assign(reinterpret_cast<const uint8_t*>(&result), reinterpret_cast<const uint8_t*>(&result) + sizeof(T));
+        call.payload = std::move(payload);
+        call.ioFailure = ioFailure;
+        SteamAPICall_t handle = nextCall++;
+        calls.emplace(handle, std::move(call));
+        return handle;
+    }
+    
+    template<typename T>
+    void post(const T& data) {
+        QueuedCallback callback;
+        callback.due = asyncDue();
+        callback.callbackId = T::k_iCallback;
+        callback.data.assign(reinterpret_cast<const uint8_t*>(&data), reinterpret_cast<const uint8_t*>(&data) + sizeof(T));
+        callbacks.push_back(std::move(callback));
+    }
+    
+    void makeFriends() {
+        friends.clear();
+        for (uint32_t i = 0; i < settings.friendCount; i++) {
+            // Every third friend online, every fifth of those in this game
+            EPersonaState state = i % 3 == 0 ? k_EPersonaStateOnline : k_EPersonaStateOffline;
+            uint32_t game = (i % 15 == 0) ? settings.appId : 0;
+            friends.push_back({76561198000000000ull + i, "Mock Friend " + std::to_string(i + 1), state, game});
+        }
+    }
+    
+    Leaderboard* findLeaderboard(SteamLeaderboard_t handle) {
+        return handle > 0 && handle <= leaderboards.size() ? &leaderboards[handle - 1] : nullptr;
+    }
+    
+    SteamLeaderboard_t leaderboardHandle(const char* name) {
+        for (size_t i = 0; i < leaderboards.size(); i++) {
+            if (leaderboards[i].name == name) return i + 1;
+        }
+        Leaderboard board;
+        board.name = name;
+        for (uint32_t i = 0; i < settings.leaderboardEntries; i++) {
+            uint64_t steamId = i % 25 == 0 && i / 25 < friends.size() ? friends[i / 25].steamId : 76561198100000000ull + i;
+            board.rows.push_back({steamId, static_cast<int32>((settings.leaderboardEntries - i) * 10), {static_cast<int32>(i)}});
+        }
+        leaderboards.push_back(std::move(board));
+        return leaderboards.size();
+    }
+    
+    uint64_t inputHandle(const char* name) {
+        auto it = std::find(inputNames.begin(), inputNames.end(), name);
+        if (it == inputNames.end()) it = inputNames.insert(it, name);
+        return static_cast<uint64_t>(it - inputNames.begin()) + 1;
+    }
+    
+    // Controllers are 0x100 + index
+    const InputAction* findInputAction(InputHandle_t controller, uint64_t action) const {
+        if (controller < 0x100 || controller >= 0x100 + settings.controllerCount) return nullptr;
+        if (action == 0 || action > inputNames.size()) return nullptr;
+        auto it = inputFrame.find({static_cast<uint32_t>(controller - 0x100), inputNames[action - 1]});
+        return it == inputFrame.end() ? nullptr : &it->second;
+    }
+    
+    const Friend* findFriend(uint64_t steamId) const {
+        for (const Friend& f : friends) {
+            if (f.steamId == steamId) return &f;
+        }
+        return nullptr;
+    }
+    
+    // Steam file names may contain anything; keep the files flat inside cloudDir
+    fs::path cloudPath(const char* file) const {
+        static const char hex[] = "0123456789abcdef";
+        std::string encoded;
+        for (const char* p = file; *p; p++) {
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (isalnum(c) || c == '-' || c == '_' || (c == '.' && p != file)) {
+                encoded += static_cast<char>(c);
+            } else {
+                encoded += '%';
+                encoded += hex[c >> 4];
+                encoded += hex[c & 15];
+            }
+        }
+        return fs::path(settings.cloudDir) / encoded;
+    }
+    
+    static std::string decodeCloudName(const std::string& encoded) {
+        std::string name;
+        for (size_t i = 0; i < encoded.size(); i++) {
+            if (encoded[i] == '%' && i + 2 < encoded.size()) {
+                name += static_cast<char>(std::stoi(encoded.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            } else {
+                name += encoded[i];
+            }
+        }
+        return name;
+    }
+    
+    bool writeFile(const char* file, const void* data, size_t size) {
+        std::error_code ec;
+        fs::create_directories(settings.cloudDir, ec);
+        fs::path target = cloudPath(file);
+        fs::path temp = target;
+        temp += ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!out) return false;
+        }
+        fs::rename(temp, target, ec);
+        return !ec;
+    }
+    
+    bool readFile(const char* file, uint64_t offset, uint64_t maxBytes, std::vector<uint8_t>& out) const {
+        std::ifstream in(cloudPath(file), std::ios::binary);
+        if (!in) return false;
+        in.seekg(static_cast<std::streamoff>(offset));
+        out.resize(maxBytes);
+        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(maxBytes));
+        out.resize(static_cast<size_t>(in.gcount()));
+        return true;
+    }
+};
+
+Backend& backend() {
+    static Backend instance;
+    return instance;
+}
+
+#define MOCK_ENTER(name) \
+    static Method& mockMethod_ = backend().method(name); \
+    const bool mockOk_ = backend().enter(mockMethod_); \
+    (void)mockOk_
+
+// 
+// ISteamUser
+// 
+
+class MockUser final : public ISteamUser {
+public:
+    CSteamID GetSteamID() override {
+        MOCK_ENTER("GetSteamID");
+        return mockOk_ ? CSteamID(uint64(kUserSteamId)) : CSteamID();
+    }
+    
+    // Not used by Gemcore
+    HSteamUser GetHSteamUser() override { return {}; }
+    bool BLoggedOn() override { return {}; }
+    int InitiateGameConnection_DEPRECATED(void *, int, CSteamID, uint32, uint16, bool) override { return {}; }
+    void TerminateGameConnection_DEPRECATED(uint32, uint16) override {}
+    void TrackAppUsageEvent(CGameID, int, const char *) override {}
+    bool GetUserDataFolder(char *, int) override { return {}; }
+    void StartVoiceRecording() override {}
+    void StopVoiceRecording() override {}
+    EVoiceResult GetAvailableVoice(uint32 *, uint32 *, uint32) override { return {}; }
+    EVoiceResult GetVoice(bool, void *, uint32, uint32 *, bool, void *, uint32, uint32 *, uint32) override { return {}; }
+    EVoiceResult DecompressVoice(const void *, uint32, void *, uint32, uint32 *, uint32) override { return {}; }
+    uint32 GetVoiceOptimalSampleRate() override { return {}; }
+    HAuthTicket GetAuthSessionTicket(void *, int, uint32 *, const SteamNetworkingIdentity *) override { return {}; }
+    HAuthTicket GetAuthTicketForWebApi(const char *) override { return {}; }
+    EBeginAuthSessionResult BeginAuthSession(const void *, int, CSteamID) override { return {}; }
+    void EndAuthSession(CSteamID) override {}
+    void CancelAuthTicket(HAuthTicket) override {}
+    EUserHasLicenseForAppResult UserHasLicenseForApp(CSteamID, AppId_t) override { return {}; }
+    bool BIsBehindNAT() override { return {}; }
+    void AdvertiseGame(CSteamID, uint32, uint16) override {}
+    SteamAPICall_t RequestEncryptedAppTicket(void *, int) override { return {}; }
+    bool GetEncryptedAppTicket(void *, int, uint32 *) override { return {}; }
+    int GetGameBadgeLevel(int, bool) override { return {}; }
+    int GetPlayerSteamLevel() override { return {}; }
+    SteamAPICall_t RequestStoreAuthURL(const char *) override { return {}; }
+    bool BIsPhoneVerified() override { return {}; }
+    bool BIsTwoFactorEnabled() override { return {}; }
+    bool BIsPhoneIdentifying() override { return {}; }
+    bool BIsPhoneRequiringVerification() override { return {}; }
+    SteamAPICall_t GetMarketEligibility() override { return {}; }
+    SteamAPICall_t GetDurationControl() override { return {}; }
+    bool BSetDurationControlOnlineState(EDurationControlOnlineState) override { return {}; }
+};
+
+// 
+// ISteamFriends
+// 
+
+class MockFriends final : public ISteamFriends {
+public:
+    const char* GetPersonaName() override {
+        MOCK_ENTER("GetPersonaName");
+        return mockOk_ ? "Mock Player" : "";
+    }
+    
+    int GetFriendCount(int) override {
+        MOCK_ENTER("GetFriendCount");
+        if (!mockOk_) return 0;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return static_cast<int>(backend().friends.size());
+    }
+    
+    CSteamID GetFriendByIndex(int iFriend, int) override {
+        MOCK_ENTER("GetFriendByIndex");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        const auto& friends = backend().friends;
+        if (!mockOk_ || iFriend < 0 || iFriend >= static_cast<int>(friends.size())) return CSteamID();
+        return CSteamID(uint64(friends[iFriend].steamId));
+    }
+    
+    EPersonaState GetFriendPersonaState(CSteamID steamIDFriend) override {
+        MOCK_ENTER("GetFriendPersonaState");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        const Friend* f = backend().findFriend(steamIDFriend.ConvertToUint64());
+        return mockOk_ && f ? f->state : k_EPersonaStateOffline;
+    }
+    
+    const char* GetFriendPersonaName(CSteamID steamIDFriend) override {
+        MOCK_ENTER("GetFriendPersonaName");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        const Friend* f = backend().findFriend(steamIDFriend.ConvertToUint64());
+        return mockOk_ && f ? f->name.c_str() : "";
+    }
+    
+    bool GetFriendGamePlayed(CSteamID steamIDFriend, FriendGameInfo_t* pFriendGameInfo) override {
+        MOCK_ENTER("GetFriendGamePlayed");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        const Friend* f = backend().findFriend(steamIDFriend.ConvertToUint64());
+        if (!mockOk_ || !f || !f->gameAppId) return false;
+        if (pFriendGameInfo) {
+            *pFriendGameInfo = FriendGameInfo_t{};
+            pFriendGameInfo->m_gameID = CGameID(AppId_t(f->gameAppId));
+        }
+        return true;
+    }
+    
+    void ActivateGameOverlay(const char*) override {
+        MOCK_ENTER("ActivateGameOverlay");
+    }
+    
+    void ActivateGameOverlayToWebPage(const char*, EActivateGameOverlayToWebPageMode) override {
+        MOCK_ENTER("ActivateGameOverlayToWebPage");
+    }
+    
+    bool SetRichPresence(const char*, const char*) override {
+        MOCK_ENTER("SetRichPresence");
+        return mockOk_;
+    }
+    
+    void ClearRichPresence() override {
+        MOCK_ENTER("ClearRichPresence");
+    }
+    
+    // Not used by Gemcore
+    EPersonaState GetPersonaState() override { return {}; }
+    EFriendRelationship GetFriendRelationship(CSteamID) override { return {}; }
+    const char * GetFriendPersonaNameHistory(CSteamID, int) override { return {}; }
+    int GetFriendSteamLevel(CSteamID) override { return {}; }
+    const char * GetPlayerNickname(CSteamID) override { return {}; }
+    int GetFriendsGroupCount() override { return {}; }
+    FriendsGroupID_t GetFriendsGroupIDByIndex(int) override { return {}; }
+    const char * GetFriendsGroupName(FriendsGroupID_t) override { return {}; }
+    int GetFriendsGroupMembersCount(FriendsGroupID_t) override { return {}; }
+    void GetFriendsGroupMembersList(FriendsGroupID_t, CSteamID *, int) override {}
+    bool HasFriend(CSteamID, int) override { return {}; }
+    int GetClanCount() override { return {}; }
+    CSteamID GetClanByIndex(int) override { return {}; }
+    const char * GetClanName(CSteamID) override { return {}; }
+    const char * GetClanTag(CSteamID) override { return {}; }
+    bool GetClanActivityCounts(CSteamID, int *, int *, int *) override { return {}; }
+    SteamAPICall_t DownloadClanActivityCounts(CSteamID *, int) override { return {}; }
+    int GetFriendCountFromSource(CSteamID) override { return {}; }
+    CSteamID GetFriendFromSourceByIndex(CSteamID, int) override { return {}; }
+    bool IsUserInSource(CSteamID, CSteamID) override { return {}; }
+    void SetInGameVoiceSpeaking(CSteamID, bool) override {}
+    void ActivateGameOverlayToUser(const char *, CSteamID) override {}
+    void ActivateGameOverlayToStore(AppId_t, EOverlayToStoreFlag) override {}
+    void SetPlayedWith(CSteamID) override {}
+    void ActivateGameOverlayInviteDialog(CSteamID) override {}
+    int GetSmallFriendAvatar(CSteamID) override { return {}; }
+    int GetMediumFriendAvatar(CSteamID) override { return {}; }
+    int GetLargeFriendAvatar(CSteamID) override { return {}; }
+    bool RequestUserInformation(CSteamID, bool) override { return {}; }
+    SteamAPICall_t RequestClanOfficerList(CSteamID) override { return {}; }
+    CSteamID GetClanOwner(CSteamID) override { return {}; }
+    int GetClanOfficerCount(CSteamID) override { return {}; }
+    CSteamID GetClanOfficerByIndex(CSteamID, int) override { return {}; }
+    const char * GetFriendRichPresence(CSteamID, const char *) override { return {}; }
+    int GetFriendRichPresenceKeyCount(CSteamID) override { return {}; }
+    const char * GetFriendRichPresenceKeyByIndex(CSteamID, int) override { return {}; }
+    void RequestFriendRichPresence(CSteamID) override {}
+    bool InviteUserToGame(CSteamID, const char *) override { return {}; }
+    int GetCoplayFriendCount() override { return {}; }
+    CSteamID GetCoplayFriend(int) override { return {}; }
+    int GetFriendCoplayTime(CSteamID) override { return {}; }
+    AppId_t GetFriendCoplayGame(CSteamID) override { return {}; }
+    SteamAPICall_t JoinClanChatRoom(CSteamID) override { return {}; }
+    bool LeaveClanChatRoom(CSteamID) override { return {}; }
+    int GetClanChatMemberCount(CSteamID) override { return {}; }
+    CSteamID GetChatMemberByIndex(CSteamID, int) override { return {}; }
+    bool SendClanChatMessage(CSteamID, const char *) override { return {}; }
+    int GetClanChatMessage(CSteamID, int, void *, int, EChatEntryType *, CSteamID *) override { return {}; }
+    bool IsClanChatAdmin(CSteamID, CSteamID) override { return {}; }
+    bool IsClanChatWindowOpenInSteam(CSteamID) override { return {}; }
+    bool OpenClanChatWindowInSteam(CSteamID) override { return {}; }
+    bool CloseClanChatWindowInSteam(CSteamID) override { return {}; }
+    bool SetListenForFriendsMessages(bool) override { return {}; }
+    bool ReplyToFriendMessage(CSteamID, const char *) override { return {}; }
+    int GetFriendMessage(CSteamID, int, void *, int, EChatEntryType *) override { return {}; }
+    SteamAPICall_t GetFollowerCount(CSteamID) override { return {}; }
+    SteamAPICall_t IsFollowing(CSteamID) override { return {}; }
+    SteamAPICall_t EnumerateFollowingList(uint32) override { return {}; }
+    bool IsClanPublic(CSteamID) override { return {}; }
+    bool IsClanOfficialGameGroup(CSteamID) override { return {}; }
+    int GetNumChatsWithUnreadPriorityMessages() override { return {}; }
+    void ActivateGameOverlayRemotePlayTogetherInviteDialog(CSteamID) override {}
+    bool RegisterProtocolInOverlayBrowser(const char *) override { return {}; }
+    void ActivateGameOverlayInviteDialogConnectString(const char *) override {}
+    SteamAPICall_t RequestEquippedProfileItems(CSteamID) override { return {}; }
+    bool BHasEquippedProfileItem(CSteamID, ECommunityProfileItemType) override { return {}; }
+    const char * GetProfileItemPropertyString(CSteamID, ECommunityProfileItemType, ECommunityProfileItemProperty) override { return {}; }
+    uint32 GetProfileItemPropertyUint(CSteamID, ECommunityProfileItemType, ECommunityProfileItemProperty) override { return {}; }
+};
+
+// 
+// ISteamUtils
+// 
+
+class MockUtils final : public ISteamUtils {
+public:
+    uint32 GetAppID() override {
+        MOCK_ENTER("GetAppID");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return mockOk_ ? backend().settings.appId : 0;
+    }
+    
+    bool IsAPICallCompleted(SteamAPICall_t hSteamAPICall, bool* pbFailed) override {
+        MOCK_ENTER("IsAPICallCompleted");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto it = backend().calls.find(hSteamAPICall);
+        if (it == backend().calls.end()) {
+            if (pbFailed) *pbFailed = true;
+            return false;
+        }
+        if (Clock::now() < it->second.due) return false;
+        if (pbFailed) *pbFailed = it->second.ioFailure || !mockOk_;
+        return true;
+    }
+    
+    ESteamAPICallFailure GetAPICallFailureReason(SteamAPICall_t hSteamAPICall) override {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto it = backend().calls.find(hSteamAPICall);
+        if (it == backend().calls.end()) return k_ESteamAPICallFailureInvalidHandle;
+        return it->second.ioFailure ? k_ESteamAPICallFailureNetworkFailure : k_ESteamAPICallFailureNone;
+    }
+    
+    bool GetAPICallResult(SteamAPICall_t hSteamAPICall, void* pCallback, int cubCallback,
+                          int iCallbackExpected, bool* pbFailed) override {
+        MOCK_ENTER("GetAPICallResult");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto it = backend().calls.find(hSteamAPICall);
+        if (pbFailed) *pbFailed = true;
+        if (it == backend().calls.end() || Clock::now() < it->second.due) return false;
+        
+        AsyncCall& call = it->second;
+        bool ok = mockOk_ && !call.ioFailure && call.callbackId == iCallbackExpected &&
+                  static_cast<size_t>(cubCallback) == call.result.size();
+        if (ok) {
+            std::memcpy(pCallback, call.result.data(), call.result.size());
+            if (pbFailed) *pbFailed = false;
+        }
+        // Read data stays until FileReadAsyncComplete collects it
+        if (!ok || call.payload.empty()) backend().calls.erase(it);
+        return ok;
+    }
+    
+    bool IsOverlayEnabled() override {
+        MOCK_ENTER("IsOverlayEnabled");
+        return false;
+    }
+    
+    bool IsSteamInBigPictureMode() override {
+        MOCK_ENTER("IsSteamInBigPictureMode");
+        return false;
+    }
+    
+    bool IsSteamRunningOnSteamDeck() override {
+        MOCK_ENTER("IsSteamRunningOnSteamDeck");
+        return false;
+    }
+    
+    // Not used by Gemcore
+    uint32 GetSecondsSinceAppActive() override { return {}; }
+    uint32 GetSecondsSinceComputerActive() override { return {}; }
+    EUniverse GetConnectedUniverse() override { return {}; }
+    uint32 GetServerRealTime() override { return {}; }
+    const char * GetIPCountry() override { return {}; }
+    bool GetImageSize(int, uint32 *, uint32 *) override { return {}; }
+    bool GetImageRGBA(int, uint8 *, int) override { return {}; }
+    bool GetCSERIPPort(uint32 *, uint16 *) override { return {}; }
+    uint8 GetCurrentBatteryPower() override { return {}; }
+    void SetOverlayNotificationPosition(ENotificationPosition) override {}
+    void RunFrame() override {}
+    uint32 GetIPCCallCount() override { return {}; }
+    void SetWarningMessageHook(SteamAPIWarningMessageHook_t) override {}
+    bool BOverlayNeedsPresent() override { return {}; }
+    SteamAPICall_t CheckFileSignature(const char *) override { return {}; }
+    bool ShowGamepadTextInput(EGamepadTextInputMode, EGamepadTextInputLineMode, const char *, uint32, const char *) override { return {}; }
+    uint32 GetEnteredGamepadTextLength() override { return {}; }
+    bool GetEnteredGamepadTextInput(char *, uint32) override { return {}; }
+    const char * GetSteamUILanguage() override { return {}; }
+    bool IsSteamRunningInVR() override { return {}; }
+    void SetOverlayNotificationInset(int, int) override {}
+    void StartVRDashboard() override {}
+    bool IsVRHeadsetStreamingEnabled() override { return {}; }
+    void SetVRHeadsetStreamingEnabled(bool) override {}
+    bool IsSteamChinaLauncher() override { return {}; }
+    bool InitFilterText(uint32) override { return {}; }
+    int FilterText(ETextFilteringContext, CSteamID, const char *, char *, uint32) override { return {}; }
+    ESteamIPv6ConnectivityState GetIPv6ConnectivityState(ESteamIPv6ConnectivityProtocol) override { return {}; }
+    bool ShowFloatingGamepadTextInput(EFloatingGamepadTextInputMode, int, int, int, int) override { return {}; }
+    void SetGameLauncherMode(bool) override {}
+    bool DismissFloatingGamepadTextInput() override { return {}; }
+    bool DismissGamepadTextInput() override { return {}; }
+};
+
+// 
+// ISteamUserStats
+// 
+
+class MockUserStats final : public ISteamUserStats {
+public:
+    bool GetStat(const char* pchName, int32* pData) override {
+        MOCK_ENTER("GetStat");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Stat* stat = find(pchName, false);
+        if (!mockOk_ || !stat) return false;
+        *pData = stat->i;
+        return true;
+    }
+    
+    bool GetStat(const char* pchName, float* pData) override {
+        MOCK_ENTER("GetStat");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Stat* stat = find(pchName, true);
+        if (!mockOk_ || !stat) return false;
+        *pData = stat->f;
+        return true;
+    }
+    
+    bool SetStat(const char* pchName, int32 nData) override {
+        MOCK_ENTER("SetStat");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Stat* stat = find(pchName, false);
+        if (!mockOk_ || !stat) return false;
+        stat->i = nData;
+        return true;
+    }
+    
+    bool SetStat(const char* pchName, float fData) override {
+        MOCK_ENTER("SetStat");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Stat* stat = find(pchName, true);
+        if (!mockOk_ || !stat) return false;
+        stat->f = fData;
+        return true;
+    }
+    
+    bool GetAchievement(const char* pchName, bool* pbAchieved) override {
+        MOCK_ENTER("GetAchievement");
+        if (!mockOk_) return false;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        *pbAchieved = backend().achievements[pchName];
+        return true;
+    }
+    
+    bool SetAchievement(const char* pchName) override {
+        MOCK_ENTER("SetAchievement");
+        if (!mockOk_) return false;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        backend().achievements[pchName] = true;
+        return true;
+    }
+    
+    bool ClearAchievement(const char* pchName) override {
+        MOCK_ENTER("ClearAchievement");
+        if (!mockOk_) return false;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        backend().achievements[pchName] = false;
+        return true;
+    }
+    
+    bool StoreStats() override {
+        MOCK_ENTER("StoreStats");
+        if (!mockOk_) return false;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        UserStatsStored_t stored{};
+        stored.m_nGameID = backend().settings.appId;
+        stored.m_eResult = k_EResultOK;
+        backend().post(stored);
+        return true;
+    }
+    
+    SteamAPICall_t FindLeaderboard(const char* pchLeaderboardName) override {
+        MOCK_ENTER("FindLeaderboard");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        LeaderboardFindResult_t result{};
+        result.m_hSteamLeaderboard = backend().leaderboardHandle(pchLeaderboardName);
+        result.m_bLeaderboardFound = 1;
+        return backend().startCall(result, !mockOk_);
+    }
+    
+    SteamAPICall_t FindOrCreateLeaderboard(const char* pchLeaderboardName, ELeaderboardSortMethod, ELeaderboardDisplayType) override {
+        return FindLeaderboard(pchLeaderboardName);
+    }
+    
+    const char* GetLeaderboardName(SteamLeaderboard_t hSteamLeaderboard) override {
+        MOCK_ENTER("GetLeaderboardName");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Leaderboard* board = backend().findLeaderboard(hSteamLeaderboard);
+        return mockOk_ && board ? board->name.c_str() : "";
+    }
+    
+    int GetLeaderboardEntryCount(SteamLeaderboard_t hSteamLeaderboard) override {
+        MOCK_ENTER("GetLeaderboardEntryCount");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Leaderboard* board = backend().findLeaderboard(hSteamLeaderboard);
+        return mockOk_ && board ? static_cast<int>(board->rows.size()) : 0;
+    }
+    
+    ELeaderboardSortMethod GetLeaderboardSortMethod(SteamLeaderboard_t) override {
+        return k_ELeaderboardSortMethodDescending;
+    }
+    
+    ELeaderboardDisplayType GetLeaderboardDisplayType(SteamLeaderboard_t) override {
+        return k_ELeaderboardDisplayTypeNumeric;
+    }
+    
+    SteamAPICall_t DownloadLeaderboardEntries(SteamLeaderboard_t hSteamLeaderboard, ELeaderboardDataRequest eLeaderboardDataRequest,
+                                              int nRangeStart, int nRangeEnd) override {
+        MOCK_ENTER("DownloadLeaderboardEntries");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Leaderboard* board = backend().findLeaderboard(hSteamLeaderboard);
+        if (!board) return k_uAPICallInvalid;
+        
+        const auto& rows = board->rows;
+        int first = 0;
+        int last = -1;
+        if (eLeaderboardDataRequest == k_ELeaderboardDataRequestGlobal) {
+            first = nRangeStart - 1;
+            last = nRangeEnd - 1;
+        } else if (eLeaderboardDataRequest == k_ELeaderboardDataRequestGlobalAroundUser) {
+            // No entries at all while the user has no score, like Steam
+            for (size_t i = 0; i < rows.size(); i++) {
+                if (rows[i].steamId != kUserSteamId) continue;
+                first = static_cast<int>(i) + nRangeStart;
+                last = static_cast<int>(i) + nRangeEnd;
+            }
+        }
+        std::vector<std::pair<int, LeaderboardRow>> entries;
+        for (int i = 0; i < static_cast<int>(rows.size()); i++) {
+            bool wanted = eLeaderboardDataRequest == k_ELeaderboardDataRequestFriends
+                ? rows[i].steamId == kUserSteamId || backend().findFriend(rows[i].steamId)
+                : i >= first && i <= last;
+            if (wanted) entries.emplace_back(i + 1, rows[i]);
+        }
+        
+        LeaderboardScoresDownloaded_t result{};
+        result.m_hSteamLeaderboard = hSteamLeaderboard;
+        result.m_hSteamLeaderboardEntries = backend().nextDownload++;
+        result.m_cEntryCount = static_cast<int>(entries.size());
+        auto& downloads = backend().downloads;
+        downloads[result.m_hSteamLeaderboardEntries] = std::move(entries);
+        if (downloads.size() > 64) downloads.erase(downloads.begin());
+        return backend().startCall(result, !mockOk_);
+    }
+    
+    bool GetDownloadedLeaderboardEntry(SteamLeaderboardEntries_t hSteamLeaderboardEntries, int index,
+                                       LeaderboardEntry_t* pLeaderboardEntry, int32* pDetails, int cDetailsMax) override {
+        MOCK_ENTER("GetDownloadedLeaderboardEntry");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto it = backend().downloads.find(hSteamLeaderboardEntries);
+        if (!mockOk_ || it == backend().downloads.end() || index < 0 || index >= static_cast<int>(it->second.size())) return false;
+        
+        const auto& entry = it->second[index];
+        *pLeaderboardEntry = LeaderboardEntry_t{};
+        pLeaderboardEntry->m_steamIDUser = CSteamID(uint64(entry.second.steamId));
+        pLeaderboardEntry->m_nGlobalRank = entry.first;
+        pLeaderboardEntry->m_nScore = entry.second.score;
+        pLeaderboardEntry->m_cDetails = static_cast<int32>(entry.second.details.size());
+        pLeaderboardEntry->m_hUGC = k_UGCHandleInvalid;
+        for (int i = 0; pDetails && i < cDetailsMax && i < static_cast<int>(entry.second.details.size()); i++) {
+            pDetails[i] = entry.second.details[i];
+        }
+        return true;
+    }
+    
+    SteamAPICall_t UploadLeaderboardScore(SteamLeaderboard_t hSteamLeaderboard, ELeaderboardUploadScoreMethod eLeaderboardUploadScoreMethod,
+                                          int32 nScore, const int32* pScoreDetails, int cScoreDetailsCount) override {
+        MOCK_ENTER("UploadLeaderboardScore");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        Leaderboard* board = backend().findLeaderboard(hSteamLeaderboard);
+        if (!board) return k_uAPICallInvalid;
+        
+        LeaderboardScoreUploaded_t result{};
+        result.m_bSuccess = 1;
+        result.m_hSteamLeaderboard = hSteamLeaderboard;
+        result.m_nScore = nScore;
+        
+        auto& rows = board->rows;
+        auto user = std::find_if(rows.begin(), rows.end(), [](const LeaderboardRow& row) { return row.steamId == kUserSteamId; });
+        result.m_nGlobalRankPrevious = user == rows.end() ? 0 : static_cast<int>(user - rows.begin()) + 1;
+        bool keep = user != rows.end() && eLeaderboardUploadScoreMethod == k_ELeaderboardUploadScoreMethodKeepBest && user->score >= nScore;
+        if (mockOk_ && !keep) {
+            if (user != rows.end()) rows.erase(user);
+            LeaderboardRow row{kUserSteamId, nScore, std::vector<int32>(pScoreDetails, pScoreDetails + std::max(cScoreDetailsCount, 0))};
+            auto at = std::find_if(rows.begin(), rows.end(), [nScore](const LeaderboardRow& other) { return other.score < nScore; });
+            result.m_nGlobalRankNew = static_cast<int>(rows.insert(at, std::move(row)) - rows.begin()) + 1;
+            result.m_bScoreChanged = 1;
+        } else {
+            result.m_nGlobalRankNew = result.m_nGlobalRankPrevious;
+        }
+        return backend().startCall(result, !mockOk_);
+    }
+    
+    // Not used by Gemcore
+    bool UpdateAvgRateStat(const char *, float, double) override { return {}; }
+    bool GetAchievementAndUnlockTime(const char *, bool *, uint32 *) override { return {}; }
+    int GetAchievementIcon(const char *) override { return {}; }
+    const char * GetAchievementDisplayAttribute(const char *, const char *) override { return {}; }
+    bool IndicateAchievementProgress(const char *, uint32, uint32) override { return {}; }
+    uint32 GetNumAchievements() override { return {}; }
+    const char * GetAchievementName(uint32) override { return {}; }
+    SteamAPICall_t RequestUserStats(CSteamID) override { return {}; }
+    bool GetUserStat(CSteamID, const char *, int32 *) override { return {}; }
+    bool GetUserStat(CSteamID, const char *, float *) override { return {}; }
+    bool GetUserAchievement(CSteamID, const char *, bool *) override { return {}; }
+    bool GetUserAchievementAndUnlockTime(CSteamID, const char *, bool *, uint32 *) override { return {}; }
+    bool ResetAllStats(bool) override { return {}; }
+    SteamAPICall_t DownloadLeaderboardEntriesForUsers(SteamLeaderboard_t, CSteamID *, int) override { return {}; }
+    SteamAPICall_t AttachLeaderboardUGC(SteamLeaderboard_t, UGCHandle_t) override { return {}; }
+    SteamAPICall_t GetNumberOfCurrentPlayers() override { return {}; }
+    SteamAPICall_t RequestGlobalAchievementPercentages() override { return {}; }
+    int GetMostAchievedAchievementInfo(char *, uint32, float *, bool *) override { return {}; }
+    int GetNextMostAchievedAchievementInfo(int, char *, uint32, float *, bool *) override { return {}; }
+    bool GetAchievementAchievedPercent(const char *, float *) override { return {}; }
+    SteamAPICall_t RequestGlobalStats(int) override { return {}; }
+    bool GetGlobalStat(const char *, int64 *) override { return {}; }
+    bool GetGlobalStat(const char *, double *) override { return {}; }
+    int32 GetGlobalStatHistory(const char *, int64 *, uint32) override { return {}; }
+    int32 GetGlobalStatHistory(const char *, double *, uint32) override { return {}; }
+    bool GetAchievementProgressLimits(const char *, int32 *, int32 *) override { return {}; }
+    bool GetAchievementProgressLimits(const char *, float *, float *) override { return {}; }
+
+private:
+    // A stat exists from its first access on, with that access's type
+    static Stat* find(const char* name, bool isFloat) {
+        auto it = backend().stats.emplace(name, Stat{isFloat, 0, 0.0f}).first;
+        return it->second.isFloat == isFloat ? &it->second : nullptr;
+    }
+};
+
+// 
+// ISteamRemoteStorage (files in Settings::cloudDir)
+// 
+
+class MockRemoteStorage final : public ISteamRemoteStorage {
+public:
+    bool FileWrite(const char* pchFile, const void* pvData, int32 cubData) override {
+        MOCK_ENTER("FileWrite");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return mockOk_ && cubData >= 0 && backend().writeFile(pchFile, pvData, static_cast<size_t>(cubData));
+    }
+    
+    int32 FileRead(const char* pchFile, void* pvData, int32 cubDataToRead) override {
+        MOCK_ENTER("FileRead");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::vector<uint8_t> data;
+        if (!mockOk_ || cubDataToRead <= 0 || !backend().readFile(pchFile, 0, static_cast<uint64_t>(cubDataToRead), data)) return 0;
+        std::memcpy(pvData, data.data(), data.size());
+        return static_cast<int32>(data.size());
+    }
+    
+    SteamAPICall_t FileWriteAsync(const char* pchFile, const void* pvData, uint32 cubData) override {
+        MOCK_ENTER("FileWriteAsync");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        RemoteStorageFileWriteAsyncComplete_t result{};
+        bool written = mockOk_ && backend().writeFile(pchFile, pvData, cubData);
+        result.m_eResult = written ? k_EResultOK : k_EResultIOFailure;
+        return backend().startCall(result, !mockOk_);
+    }
+    
+    SteamAPICall_t FileReadAsync(const char* pchFile, uint32 nOffset, uint32 cubToRead) override {
+        MOCK_ENTER("FileReadAsync");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::vector<uint8_t> data;
+        if (mockOk_ && !backend().readFile(pchFile, nOffset, cubToRead, data)) return k_uAPICallInvalid;
+        
+        RemoteStorageFileReadAsyncComplete_t result{};
+        result.m_hFileReadAsync = backend().nextCall;
+        result.m_eResult = k_EResultOK;
+        result.m_nOffset = nOffset;
+        result.m_cubRead = static_cast<uint32>(data.size());
+        return backend().startCall(result, !mockOk_, std::move(data));
+    }
+    
+    bool FileReadAsyncComplete(SteamAPICall_t hReadCall, void* pvBuffer, uint32 cubToRead) override {
+        MOCK_ENTER("FileReadAsyncComplete");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto it = backend().calls.find(hReadCall);
+        if (it == backend().calls.end()) return false;
+        std::vector<uint8_t> data = std::move(it->second.payload);
+        backend().calls.erase(it);
+        if (!mockOk_ || cubToRead > data.size()) return false;
+        std::memcpy(pvBuffer, data.data(), cubToRead);
+        return true;
+    }
+    
+    bool FileForget(const char* pchFile) override {
+        MOCK_ENTER("FileForget");
+        return mockOk_ && FileExists(pchFile);
+    }
+    
+    bool FileDelete(const char* pchFile) override {
+        MOCK_ENTER("FileDelete");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::error_code ec;
+        return mockOk_ && fs::remove(backend().cloudPath(pchFile), ec);
+    }
+    
+    bool FileExists(const char* pchFile) override {
+        MOCK_ENTER("FileExists");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::error_code ec;
+        return mockOk_ && fs::is_regular_file(backend().cloudPath(pchFile), ec);
+    }
+    
+    bool FilePersisted(const char* pchFile) override {
+        MOCK_ENTER("FilePersisted");
+        return mockOk_ && FileExists(pchFile);
+    }
+    
+    int32 GetFileSize(const char* pchFile) override {
+        MOCK_ENTER("GetFileSize");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::error_code ec;
+        auto size = fs::file_size(backend().cloudPath(pchFile), ec);
+        return mockOk_ && !ec ? static_cast<int32>(size) : 0;
+    }
+    
+    int64 GetFileTimestamp(const char* pchFile) override {
+        MOCK_ENTER("GetFileTimestamp");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        std::error_code ec;
+        auto written = fs::last_write_time(backend().cloudPath(pchFile), ec);
+        if (!mockOk_ || ec) return 0;
+        auto age = fs::file_time_type::clock::now() - written;
+        auto when = std::chrono::system_clock::now() - std::chrono::duration_cast<std::chrono::system_clock::duration>(age);
+        return std::chrono::duration_cast<std::chrono::seconds>(when.time_since_epoch()).count();
+    }
+    
+    int32 GetFileCount() override {
+        MOCK_ENTER("GetFileCount");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto& listing = backend().cloudListing;
+        listing.clear();
+        std::error_code ec;
+        for (fs::directory_iterator it(backend().settings.cloudDir, ec), end; !ec && it != end; it.increment(ec)) {
+            std::string name = it->path().filename().string();
+            if (it->is_regular_file() && name.size() > 4 && name.compare(name.size() - 4, 4, ".tmp") == 0) continue;
+            if (it->is_regular_file()) listing.push_back(name);
+        }
+        std::sort(listing.begin(), listing.end());
+        return mockOk_ ? static_cast<int32>(listing.size()) : 0;
+    }
+    
+    const char* GetFileNameAndSize(int iFile, int32* pnFileSizeInBytes) override {
+        MOCK_ENTER("GetFileNameAndSize");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        static thread_local std::string name;
+        auto& listing = backend().cloudListing;
+        *pnFileSizeInBytes = 0;
+        if (!mockOk_ || iFile < 0 || iFile >= static_cast<int>(listing.size())) return "";
+        std::error_code ec;
+        *pnFileSizeInBytes = static_cast<int32>(fs::file_size(fs::path(backend().settings.cloudDir) / listing[iFile], ec));
+        name = Backend::decodeCloudName(listing[iFile]);
+        return name.c_str();
+    }
+    
+    bool IsCloudEnabledForAccount() override {
+        MOCK_ENTER("IsCloudEnabledForAccount");
+        return mockOk_;
+    }
+    
+    bool IsCloudEnabledForApp() override {
+        MOCK_ENTER("IsCloudEnabledForApp");
+        return mockOk_;
+    }
+    
+    // Not used by Gemcore
+    SteamAPICall_t FileShare(const char *) override { return {}; }
+    bool SetSyncPlatforms(const char *, ERemoteStoragePlatform) override { return {}; }
+    UGCFileWriteStreamHandle_t FileWriteStreamOpen(const char *) override { return {}; }
+    bool FileWriteStreamWriteChunk(UGCFileWriteStreamHandle_t, const void *, int32) override { return {}; }
+    bool FileWriteStreamClose(UGCFileWriteStreamHandle_t) override { return {}; }
+    bool FileWriteStreamCancel(UGCFileWriteStreamHandle_t) override { return {}; }
+    ERemoteStoragePlatform GetSyncPlatforms(const char *) override { return {}; }
+    bool GetQuota(uint64 *, uint64 *) override { return {}; }
+    void SetCloudEnabledForApp(bool) override {}
+    SteamAPICall_t UGCDownload(UGCHandle_t, uint32) override { return {}; }
+    bool GetUGCDownloadProgress(UGCHandle_t, int32 *, int32 *) override { return {}; }
+    bool GetUGCDetails(UGCHandle_t, AppId_t *, char **, int32 *, CSteamID *) override { return {}; }
+    int32 UGCRead(UGCHandle_t, void *, int32, uint32, EUGCReadAction) override { return {}; }
+    int32 GetCachedUGCCount() override { return {}; }
+    UGCHandle_t GetCachedUGCHandle(int32) override { return {}; }
+    SteamAPICall_t PublishWorkshopFile(const char *, const char *, AppId_t, const char *, const char *, ERemoteStoragePublishedFileVisibility, SteamParamStringArray_t *, EWorkshopFileType) override { return {}; }
+    PublishedFileUpdateHandle_t CreatePublishedFileUpdateRequest(PublishedFileId_t) override { return {}; }
+    bool UpdatePublishedFileFile(PublishedFileUpdateHandle_t, const char *) override { return {}; }
+    bool UpdatePublishedFilePreviewFile(PublishedFileUpdateHandle_t, const char *) override { return {}; }
+    bool UpdatePublishedFileTitle(PublishedFileUpdateHandle_t, const char *) override { return {}; }
+    bool UpdatePublishedFileDescription(PublishedFileUpdateHandle_t, const char *) override { return {}; }
+    bool UpdatePublishedFileVisibility(PublishedFileUpdateHandle_t, ERemoteStoragePublishedFileVisibility) override { return {}; }
+    bool UpdatePublishedFileTags(PublishedFileUpdateHandle_t, SteamParamStringArray_t *) override { return {}; }
+    SteamAPICall_t CommitPublishedFileUpdate(PublishedFileUpdateHandle_t) override { return {}; }
+    SteamAPICall_t GetPublishedFileDetails(PublishedFileId_t, uint32) override { return {}; }
+    SteamAPICall_t DeletePublishedFile(PublishedFileId_t) override { return {}; }
+    SteamAPICall_t EnumerateUserPublishedFiles(uint32) override { return {}; }
+    SteamAPICall_t SubscribePublishedFile(PublishedFileId_t) override { return {}; }
+    SteamAPICall_t EnumerateUserSubscribedFiles(uint32) override { return {}; }
+    SteamAPICall_t UnsubscribePublishedFile(PublishedFileId_t) override { return {}; }
+    bool UpdatePublishedFileSetChangeDescription(PublishedFileUpdateHandle_t, const char *) override { return {}; }
+    SteamAPICall_t GetPublishedItemVoteDetails(PublishedFileId_t) override { return {}; }
+    SteamAPICall_t UpdateUserPublishedItemVote(PublishedFileId_t, bool) override { return {}; }
+    SteamAPICall_t GetUserPublishedItemVoteDetails(PublishedFileId_t) override { return {}; }
+    SteamAPICall_t EnumerateUserSharedWorkshopFiles(CSteamID, uint32, SteamParamStringArray_t *, SteamParamStringArray_t *) override { return {}; }
+    SteamAPICall_t PublishVideo(EWorkshopVideoProvider, const char *, const char *, const char *, AppId_t, const char *, const char *, ERemoteStoragePublishedFileVisibility, SteamParamStringArray_t *) override { return {}; }
+    SteamAPICall_t SetUserPublishedFileAction(PublishedFileId_t, EWorkshopFileAction) override { return {}; }
+    SteamAPICall_t EnumeratePublishedFilesByUserAction(EWorkshopFileAction, uint32) override { return {}; }
+    SteamAPICall_t EnumeratePublishedWorkshopFiles(EWorkshopEnumerationType, uint32, uint32, uint32, SteamParamStringArray_t *, SteamParamStringArray_t *) override { return {}; }
+    SteamAPICall_t UGCDownloadToLocation(UGCHandle_t, const char *, uint32) override { return {}; }
+    int32 GetLocalFileChangeCount() override { return {}; }
+    const char * GetLocalFileChange(int, ERemoteStorageLocalFileChange *, ERemoteStorageFilePathType *) override { return {}; }
+    bool BeginFileWriteBatch() override { return {}; }
+    bool EndFileWriteBatch() override { return {}; }
+};
+
+// 
+// ISteamApps
+// 
+
+class MockApps final : public ISteamApps {
+public:
+    bool BIsSubscribed() override {
+        MOCK_ENTER("BIsSubscribed");
+        return mockOk_;
+    }
+    
+    const char* GetCurrentGameLanguage() override {
+        MOCK_ENTER("GetCurrentGameLanguage");
+        return "english";
+    }
+    
+    const char* GetAvailableGameLanguages() override {
+        MOCK_ENTER("GetAvailableGameLanguages");
+        return "english,german";
+    }
+    
+    bool BIsDlcInstalled(AppId_t) override {
+        MOCK_ENTER("BIsDlcInstalled");
+        return false;
+    }
+    
+    int GetDLCCount() override {
+        MOCK_ENTER("GetDLCCount");
+        return 0;
+    }
+    
+    // Not used by Gemcore
+    bool BIsLowViolence() override { return {}; }
+    bool BIsCybercafe() override { return {}; }
+    bool BIsVACBanned() override { return {}; }
+    bool BIsSubscribedApp(AppId_t) override { return {}; }
+    uint32 GetEarliestPurchaseUnixTime(AppId_t) override { return {}; }
+    bool BIsSubscribedFromFreeWeekend() override { return {}; }
+    bool BGetDLCDataByIndex(int, AppId_t *, bool *, char *, int) override { return {}; }
+    void InstallDLC(AppId_t) override {}
+    void UninstallDLC(AppId_t) override {}
+    void RequestAppProofOfPurchaseKey(AppId_t) override {}
+    bool GetCurrentBetaName(char *, int) override { return {}; }
+    bool MarkContentCorrupt(bool) override { return {}; }
+    uint32 GetInstalledDepots(AppId_t, DepotId_t *, uint32) override { return {}; }
+    uint32 GetAppInstallDir(AppId_t, char *, uint32) override { return {}; }
+    bool BIsAppInstalled(AppId_t) override { return {}; }
+    CSteamID GetAppOwner() override { return {}; }
+    const char * GetLaunchQueryParam(const char *) override { return {}; }
+    bool GetDlcDownloadProgress(AppId_t, uint64 *, uint64 *) override { return {}; }
+    int GetAppBuildId() override { return {}; }
+    void RequestAllProofOfPurchaseKeys() override {}
+    SteamAPICall_t GetFileDetails(const char*) override { return {}; }
+    int GetLaunchCommandLine(char *, int) override { return {}; }
+    bool BIsSubscribedFromFamilySharing() override { return {}; }
+    bool BIsTimedTrial(uint32*, uint32*) override { return {}; }
+    bool SetDlcContext(AppId_t) override { return {}; }
+    int GetNumBetas(int *, int *) override { return {}; }
+    bool GetBetaInfo(int, uint32 *, uint32 *, char *, int, char *, int) override { return {}; }
+    bool SetActiveBeta(const char *) override { return {}; }
+};
+
+// 
+// ISteamScreenshots
+// 
+
+class MockScreenshots final : public ISteamScreenshots {
+public:
+    void TriggerScreenshot() override {
+        MOCK_ENTER("TriggerScreenshot");
+    }
+    
+    // Not used by Gemcore
+    ScreenshotHandle WriteScreenshot(void *, uint32, int, int) override { return {}; }
+    ScreenshotHandle AddScreenshotToLibrary(const char *, const char *, int, int) override { return {}; }
+    void HookScreenshots(bool) override {}
+    bool SetLocation(ScreenshotHandle, const char *) override { return {}; }
+    bool TagUser(ScreenshotHandle, CSteamID) override { return {}; }
+    bool TagPublishedFile(ScreenshotHandle, PublishedFileId_t) override { return {}; }
+    bool IsScreenshotsHooked() override { return {}; }
+    ScreenshotHandle AddVRScreenshotToLibrary(EVRScreenshotType, const char *, const char *) override { return {}; }
+};
+
+// 
+// ISteamInput
+// 
+
+class MockInput final : public ISteamInput {
+public:
+    bool Init(bool) override {
+        MOCK_ENTER("InputInit");
+        return mockOk_;
+    }
+    
+    bool Shutdown() override {
+        MOCK_ENTER("InputShutdown");
+        return true;
+    }
+    
+    void RunFrame(bool) override {
+        MOCK_ENTER("RunFrame");
+        if (!mockOk_) return;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        backend().inputFrame = backend().inputStaged;
+    }
+    
+    int GetConnectedControllers(InputHandle_t* handlesOut) override {
+        MOCK_ENTER("GetConnectedControllers");
+        if (!mockOk_) return 0;
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        uint32_t count = std::min<uint32_t>(backend().settings.controllerCount, STEAM_INPUT_MAX_COUNT);
+        for (uint32_t i = 0; i < count; i++) handlesOut[i] = 0x100 + i;
+        return static_cast<int>(count);
+    }
+    
+    InputActionSetHandle_t GetActionSetHandle(const char* pszActionSetName) override {
+        MOCK_ENTER("GetActionSetHandle");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return mockOk_ ? backend().inputHandle(pszActionSetName) : 0;
+    }
+    
+    void ActivateActionSet(InputHandle_t, InputActionSetHandle_t) override {
+        MOCK_ENTER("ActivateActionSet");
+    }
+    
+    InputDigitalActionHandle_t GetDigitalActionHandle(const char* pszActionName) override {
+        MOCK_ENTER("GetDigitalActionHandle");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return mockOk_ ? backend().inputHandle(pszActionName) : 0;
+    }
+    
+    InputDigitalActionData_t GetDigitalActionData(InputHandle_t inputHandle, InputDigitalActionHandle_t digitalActionHandle) override {
+        MOCK_ENTER("GetDigitalActionData");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        InputDigitalActionData_t data{};
+        const InputAction* action = backend().findInputAction(inputHandle, digitalActionHandle);
+        data.bActive = mockOk_;
+        data.bState = mockOk_ && action && action->pressed;
+        return data;
+    }
+    
+    InputAnalogActionHandle_t GetAnalogActionHandle(const char* pszActionName) override {
+        MOCK_ENTER("GetAnalogActionHandle");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        return mockOk_ ? backend().inputHandle(pszActionName) : 0;
+    }
+    
+    InputAnalogActionData_t GetAnalogActionData(InputHandle_t inputHandle, InputAnalogActionHandle_t analogActionHandle) override {
+        MOCK_ENTER("GetAnalogActionData");
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        InputAnalogActionData_t data{};
+        const InputAction* action = backend().findInputAction(inputHandle, analogActionHandle);
+        data.eMode = k_EInputSourceMode_JoystickMove;
+        data.bActive = mockOk_;
+        if (mockOk_ && action) {
+            data.x = action->x;
+            data.y = action->y;
+        }
+        return data;
+    }
+    
+    // Not used by Gemcore
+    bool SetInputActionManifestFilePath(const char *) override { return {}; }
+    bool BWaitForData(bool, uint32) override { return {}; }
+    bool BNewDataAvailable() override { return {}; }
+    void EnableDeviceCallbacks() override {}
+    void EnableActionEventCallbacks(SteamInputActionEventCallbackPointer) override {}
+    InputActionSetHandle_t GetCurrentActionSet(InputHandle_t) override { return {}; }
+    void ActivateActionSetLayer(InputHandle_t, InputActionSetHandle_t) override {}
+    void DeactivateActionSetLayer(InputHandle_t, InputActionSetHandle_t) override {}
+    void DeactivateAllActionSetLayers(InputHandle_t) override {}
+    int GetActiveActionSetLayers(InputHandle_t, InputActionSetHandle_t *) override { return {}; }
+    int GetDigitalActionOrigins(InputHandle_t, InputActionSetHandle_t, InputDigitalActionHandle_t, EInputActionOrigin *) override { return {}; }
+    const char * GetStringForDigitalActionName(InputDigitalActionHandle_t) override { return {}; }
+    int GetAnalogActionOrigins(InputHandle_t, InputActionSetHandle_t, InputAnalogActionHandle_t, EInputActionOrigin *) override { return {}; }
+    const char * GetGlyphPNGForActionOrigin(EInputActionOrigin, ESteamInputGlyphSize, uint32) override { return {}; }
+    const char * GetGlyphSVGForActionOrigin(EInputActionOrigin, uint32) override { return {}; }
+    const char * GetGlyphForActionOrigin_Legacy(EInputActionOrigin) override { return {}; }
+    const char * GetStringForActionOrigin(EInputActionOrigin) override { return {}; }
+    const char * GetStringForAnalogActionName(InputAnalogActionHandle_t) override { return {}; }
+    void StopAnalogActionMomentum(InputHandle_t, InputAnalogActionHandle_t) override {}
+    InputMotionData_t GetMotionData(InputHandle_t) override { return {}; }
+    void TriggerVibration(InputHandle_t, unsigned short, unsigned short) override {}
+    void TriggerVibrationExtended(InputHandle_t, unsigned short, unsigned short, unsigned short, unsigned short) override {}
+    void TriggerSimpleHapticEvent(InputHandle_t, EControllerHapticLocation, uint8, char, uint8, char) override {}
+    void SetLEDColor(InputHandle_t, uint8, uint8, uint8, unsigned int) override {}
+    void Legacy_TriggerHapticPulse(InputHandle_t, ESteamControllerPad, unsigned short) override {}
+    void Legacy_TriggerRepeatedHapticPulse(InputHandle_t, ESteamControllerPad, unsigned short, unsigned short, unsigned short, unsigned int) override {}
+    bool ShowBindingPanel(InputHandle_t) override { return {}; }
+    ESteamInputType GetInputTypeForHandle(InputHandle_t) override { return {}; }
+    InputHandle_t GetControllerForGamepadIndex(int) override { return {}; }
+    int GetGamepadIndexForController(InputHandle_t) override { return {}; }
+    const char * GetStringForXboxOrigin(EXboxOrigin) override { return {}; }
+    const char * GetGlyphForXboxOrigin(EXboxOrigin) override { return {}; }
+    EInputActionOrigin GetActionOriginFromXboxOrigin(InputHandle_t, EXboxOrigin) override { return {}; }
+    EInputActionOrigin TranslateActionOrigin(ESteamInputType, EInputActionOrigin) override { return {}; }
+    bool GetDeviceBindingRevision(InputHandle_t, int *, int *) override { return {}; }
+    uint32 GetRemotePlaySessionID(InputHandle_t) override { return {}; }
+    uint16 GetSessionInputConfigurationSettings() override { return {}; }
+    void SetDualSenseTriggerEffect(InputHandle_t, const ScePadTriggerEffectParam *) override {}
+};
+
+MockUser g_user;
+MockFriends g_friends;
+MockUtils g_utils;
+MockUserStats g_userStats;
+MockRemoteStorage g_remoteStorage;
+MockApps g_apps;
+MockScreenshots g_screenshots;
+MockInput g_input;
+
+uint32_t envNumber(const char* name, uint32_t fallback) {
+    const char* value = getenv(name);
+    return value && *value ? static_cast<uint32_t>(strtoul(value, nullptr, 10)) : fallback;
+}
+
+/**
+ * GEMCORE_STEAM_MOCK_FAIL="FileWriteAsync:0.25,StoreStats"
+ */
+void applyFailureSpec(const char* spec) {
+    std::string rest = spec ? spec : "";
+    while (!rest.empty()) {
+        size_t comma = rest.find(',');
+        std::string item = rest.substr(0, comma);
+        rest = comma == std::string::npos ? "" : rest.substr(comma + 1);
+        size_t colon = item.find(':');
+        std::string name = item.substr(0, colon);
+        double probability = colon == std::string::npos ? 1.0 : atof(item.c_str() + colon + 1);
+        if (!name.empty()) setFailure(name, probability);
+    }
+}
+
+} // namespace
+
+// 
+// Control API (steam-api-mock.h)
+// 
+
+Settings settings() {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    return backend().settings;
+}
+
+void configure(const Settings& settings) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().settings = settings;
+    backend().makeFriends();
+    backend().leaderboards.clear();  // Recreated with the new friends and size
+}
+
+void setFailure(const std::string& method, double probability) {
+    backend().method(method).failure.store(probability, std::memory_order_relaxed);
+}
+
+uint64_t callCount(const std::string& method) {
+    return backend().method(method).calls.load(std::memory_order_relaxed);
+}
+
+void resetCallCounts() {
+    std::lock_guard<std::mutex> lock(backend().methodsMutex);
+    for (auto& entry : backend().methods) {
+        entry.second->calls.store(0, std::memory_order_relaxed);
+    }
+}
+
+void setFriend(uint32_t index, int32_t personaState, uint32_t gameAppId) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    auto& friends = backend().friends;
+    if (index >= friends.size()) return;
+    friends[index].state = static_cast<EPersonaState>(personaState);
+    friends[index].gameAppId = gameAppId;
+    
+    PersonaStateChange_t change{};
+    change.m_ulSteamID = friends[index].steamId;
+    change.m_nChangeFlags = k_EPersonaChangeStatus | k_EPersonaChangeGamePlayed;
+    backend().post(change);
+}
+
+void setDigitalAction(uint32_t controller, const std::string& action, bool pressed) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().inputStaged[{controller, action}].pressed = pressed;
+}
+
+void setAnalogAction(uint32_t controller, const std::string& action, float x, float y) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    InputAction& state = backend().inputStaged[{controller, action}];
+    state.x = x;
+    state.y = y;
+}
+
+} // namespace steammock
+
+namespace steamworks {
+
+// The mock is linked in; there is no library to open
+bool SteamworksManager::LoadSteamApi() {
+    return true;
+}
+
+} // namespace steamworks
+} // namespace gemcore
+
+// 
+// libsteam_api exports
+// 
+
+using gemcore::steammock::backend;
+
+S_API ESteamAPIInitResult S_CALLTYPE SteamInternal_SteamAPI_Init(const char*, SteamErrMsg* pOutErrMsg) {
+    using namespace gemcore::steammock;
+    
+    Settings fresh;
+    fresh.callLatencyUs = envNumber("GEMCORE_STEAM_MOCK_LATENCY_US", 0);
+    fresh.asyncLatencyMs = envNumber("GEMCORE_STEAM_MOCK_ASYNC_MS", 0);
+    fresh.friendCount = envNumber("GEMCORE_STEAM_MOCK_FRIENDS", fresh.friendCount);
+    fresh.controllerCount = envNumber("GEMCORE_STEAM_MOCK_CONTROLLERS", fresh.controllerCount);
+    fresh.leaderboardEntries = envNumber("GEMCORE_STEAM_MOCK_LEADERBOARD", fresh.leaderboardEntries);
+    fresh.appId = envNumber("SteamAppId", fresh.appId);
+    const char* cloudDir = getenv("GEMCORE_STEAM_MOCK_CLOUD_DIR");
+    if (cloudDir && *cloudDir) fresh.cloudDir = cloudDir;
+    configure(fresh);
+    applyFailureSpec(getenv("GEMCORE_STEAM_MOCK_FAIL"));
+    
+    static Method& initMethod = backend().method("Init");
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().random.seed(envNumber("GEMCORE_STEAM_MOCK_SEED", 1));
+    initMethod.calls.fetch_add(1, std::memory_order_relaxed);
+    double failure = initMethod.failure.load(std::memory_order_relaxed);
+    if (failure > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(backend().random) < failure) {
+        if (pOutErrMsg) snprintf(*pOutErrMsg, sizeof(SteamErrMsg), "Steam mock: injected Init failure");
+        return k_ESteamAPIInitResult_NoSteamClient;
+    }
+    backend().initialized = true;
+    backend().contextCounter++;
+    return k_ESteamAPIInitResult_OK;
+}
+
+S_API void S_CALLTYPE SteamAPI_Shutdown() {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().initialized = false;
+    backend().contextCounter++;
+    backend().calls.clear();
+    backend().callbacks.clear();
+}
+
+S_API bool S_CALLTYPE SteamAPI_IsSteamRunning() {
+    return true;
+}
+
+S_API bool S_CALLTYPE SteamAPI_RestartAppIfNecessary(uint32) {
+    return false;
+}
+
+S_API HSteamUser S_CALLTYPE SteamAPI_GetHSteamUser() {
+    return 1;
+}
+
+S_API HSteamPipe S_CALLTYPE SteamAPI_GetHSteamPipe() {
+    return 1;
+}
+
+S_API void* S_CALLTYPE SteamInternal_ContextInit(void* pContextInitData) {
+    // { void (*init)(void* slot); uintptr_t counter; void* slot }, refreshed after Init/Shutdown
+    struct Context {
+        void (*init)(void*);
+        uintptr_t counter;
+        void* slot;
+    };
+    Context* context = static_cast<Context*>(pContextInitData);
+    uintptr_t counter;
+    {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        counter = backend().contextCounter;
+    }
+    if (context->counter != counter) {
+        context->init(&context->slot);
+        context->counter = counter;
+    }
+    return &context->slot;
+}
+
+S_API void* S_CALLTYPE SteamInternal_FindOrCreateUserInterface(HSteamUser, const char* pszVersion) {
+    {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        if (!backend().initialized) return nullptr;
+    }
+    if (!strcmp(pszVersion, STEAMUSER_INTERFACE_VERSION)) return &gemcore::steammock::g_user;
+    if (!strcmp(pszVersion, STEAMFRIENDS_INTERFACE_VERSION)) return &gemcore::steammock::g_friends;
+    if (!strcmp(pszVersion, STEAMUTILS_INTERFACE_VERSION)) return &gemcore::steammock::g_utils;
+    if (!strcmp(pszVersion, STEAMUSERSTATS_INTERFACE_VERSION)) return &gemcore::steammock::g_userStats;
+    if (!strcmp(pszVersion, STEAMREMOTESTORAGE_INTERFACE_VERSION)) return &gemcore::steammock::g_remoteStorage;
+    if (!strcmp(pszVersion, STEAMAPPS_INTERFACE_VERSION)) return &gemcore::steammock::g_apps;
+    if (!strcmp(pszVersion, STEAMSCREENSHOTS_INTERFACE_VERSION)) return &gemcore::steammock::g_screenshots;
+    if (!strcmp(pszVersion, STEAMINPUT_INTERFACE_VERSION)) return &gemcore::steammock::g_input;
+    return nullptr;
+}
+
+S_API void S_CALLTYPE SteamAPI_RegisterCallback(CCallbackBase* pCallback, int iCallback) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    CCallbackMgr::setRegistered(pCallback, iCallback, true);
+    backend().listeners.emplace(iCallback, pCallback);
+}
+
+S_API void S_CALLTYPE SteamAPI_UnregisterCallback(CCallbackBase* pCallback) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    auto& listeners = backend().listeners;
+    for (auto it = listeners.begin(); it != listeners.end();) {
+        it = it->second == pCallback ? listeners.erase(it) : std::next(it);
+    }
+    CCallbackMgr::setRegistered(pCallback, 0, false);
+}
+
+S_API void S_CALLTYPE SteamAPI_RegisterCallResult(CCallbackBase* pCallback, SteamAPICall_t hAPICall) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    auto it = backend().calls.find(hAPICall);
+    if (it != backend().calls.end()) it->second.callResult = pCallback;
+}
+
+S_API void S_CALLTYPE SteamAPI_UnregisterCallResult(CCallbackBase* pCallback, SteamAPICall_t hAPICall) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    auto it = backend().calls.find(hAPICall);
+    if (it != backend().calls.end() && it->second.callResult == pCallback) it->second.callResult = nullptr;
+}
+
+/**
+ * Deliver due callbacks to their listeners and due call results to their
+ * CCallResult, outside the lock (handlers may call back into the mock)
+ */
+S_API void S_CALLTYPE SteamAPI_RunCallbacks() {
+    using gemcore::steammock::AsyncCall;
+    using gemcore::steammock::QueuedCallback;
+    
+    std::vector<std::pair<CCallbackBase*, std::vector<uint8_t>>> callbacks;
+    std::vector<std::pair<SteamAPICall_t, AsyncCall>> results;
+    {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        auto now = gemcore::steammock::Clock::now();
+        auto& queue = backend().callbacks;
+        while (!queue.empty() && queue.front().due <= now) {
+            QueuedCallback& callback = queue.front();
+            auto range = backend().listeners.equal_range(callback.callbackId);
+            for (auto it = range.first; it != range.second; ++it) {
+                callbacks.emplace_back(it->second, callback.data);
+            }
+            queue.pop_front();
+        }
+        auto& calls = backend().calls;
+        for (auto it = calls.begin(); it != calls.end();) {
+            if (it->second.callResult && it->second.due <= now) {
+                results.emplace_back(it->first, std::move(it->second));
+                it = calls.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& callback : callbacks) {
+        callback.first->Run(callback.second.data());
+    }
+    for (auto& result : results) {
+        result.second.callResult->Run(result.second.result.data(), result.second.ioFailure, result.first);
+    }
+}
+
+// Flat API used for ABI-safe friend queries (see GetFriendPersonaName)
+S_API ISteamFriends* SteamAPI_SteamFriends_v018() {
+    return static_cast<ISteamFriends*>(SteamInternal_FindOrCreateUserInterface(1, STEAMFRIENDS_INTERFACE_VERSION));
+}
+
+S_API int SteamAPI_ISteamFriends_GetFriendCount(ISteamFriends* self, int iFriendFlags) {
+    return self->GetFriendCount(iFriendFlags);
+}
+
+S_API uint64_steamid SteamAPI_ISteamFriends_GetFriendByIndex(ISteamFriends* self, int iFriend, int iFriendFlags) {
+    return self->GetFriendByIndex(iFriend, iFriendFlags).ConvertToUint64();
+}
+
+S_API EPersonaState SteamAPI_ISteamFriends_GetFriendPersonaState(ISteamFriends* self, uint64_steamid steamIDFriend) {
+    return self->GetFriendPersonaState(CSteamID(steamIDFriend));
+}
+
+S_API const char* SteamAPI_ISteamFriends_GetFriendPersonaName(ISteamFriends* self, uint64_steamid steamIDFriend) {
+    return self->GetFriendPersonaName(CSteamID(steamIDFriend));
+}
+
+S_API bool SteamAPI_ISteamFriends_GetFriendGamePlayed(ISteamFriends* self, uint64_steamid steamIDFriend, FriendGameInfo_t* pFriendGameInfo) {
+    return self->GetFriendGamePlayed(CSteamID(steamIDFriend), pFriendGameInfo);
+}
@@ -0,0 +1,85 @@
+/**
+ *  Gemcore Steam API Mock
+ * In-process stand-in for libsteam_api, linked instead of the runtime loader
+ * (steam-api-stubs.cpp) when building with -DGEMCORE_STEAM_MOCK=ON. Covers the
+ * interfaces Gemcore uses (user stats, remote storage, friends, apps, utils,
+ * user, screenshots, input) plus callbacks and call results, so the Steam bindings,
+ * caches and async workers run on machines without a Steam client (CI,
+ * benchmarks).
+ *
+ * Settings are read from the environment at SteamAPI_Init:
+ *   GEMCORE_STEAM_MOCK_LATENCY_US  added to every interface call (default 0)
+ *   GEMCORE_STEAM_MOCK_ASYNC_MS    until async results and callbacks arrive (default 0)
+ *   GEMCORE_STEAM_MOCK_FAIL        failure injection, "method[:probability],...",
+ *                                  e.g. "FileWriteAsync:0.25,StoreStats" ("Init" fails init)
+ *   GEMCORE_STEAM_MOCK_SEED        seed for the failure draws (default 1)
+ *   GEMCORE_STEAM_MOCK_CLOUD_DIR   remote storage directory (default ./steam-mock-cloud)
+ *   GEMCORE_STEAM_MOCK_FRIENDS     number of friends (default 8)
+ *   GEMCORE_STEAM_MOCK_CONTROLLERS connected Steam Input controllers (default 1)
+ *   GEMCORE_STEAM_MOCK_LEADERBOARD entries of each leaderboard (default 1000)
+ *   SteamAppId                     app id (default 480)
+ *
+ * A failed call returns false / 0 / k_uAPICallInvalid, or completes its async
+ * call with an I/O failure. Stats and achievements accept any name; a stat
+ * keeps the type (int or float) of its first access. So do leaderboards: the
+ * first FindLeaderboard of a name creates it with generated scores (every 25th
+ * entry belongs to a friend), sorted descending; the user has no entry until
+ * they upload one.
+ */
+
+#ifndef GEMCORE_STEAM_API_MOCK_H
+#define GEMCORE_STEAM_API_MOCK_H
+
+#include <string>
+#include <cstdint>
+
+namespace gemcore {
+namespace steammock {
+
+struct Settings {
+    uint32_t callLatencyUs = 0;
+    uint32_t asyncLatencyMs = 0;
+    std::string cloudDir = "steam-mock-cloud";
+    uint32_t friendCount = 8;
+    uint32_t controllerCount = 1;
+    uint32_t leaderboardEntries = 1000;
+    uint32_t appId = 480;
+};
+
+/**
+ * Current settings; configure() replaces them (friends and leaderboards are
+ * regenerated)
+ */
+Settings settings();
+void configure(const Settings& settings);
+
+/**
+ * Make calls to `method` (the interface method name, e.g. "SetStat") fail
+ * with the given probability; 0 turns injection off again
+ */
+void setFailure(const std::string& method, double probability);
+
+/**
+ * Number of calls to `method` since start or the last resetCallCounts()
+ */
+uint64_t callCount(const std::string& method);
+void resetCallCounts();
+
+/**
+ * Change a friend and post PersonaStateChange_t, as Steam does when a friend
+ * goes online or starts a game
+ */
+void setFriend(uint32_t index, int32_t personaState, uint32_t gameAppId);
+
+/**
+ * Steam Input: press or release a digital action, or move an analog action,
+ * on controller `controller` (any action name works). Like real controller
+ * data, the game sees the change after its next ISteamInput::RunFrame().
+ */
+void setDigitalAction(uint32_t controller, const std::string& action, bool pressed);
+void setAnalogAction(uint32_t controller, const std::string& action, float x, float y);
+
+} // namespace steammock
+} // namespace gemcore
+
+#endif // GEMCORE_STEAM_API_MOCK_H
@@ -1,128 +1,178 @@
 /**
- * Steam API Runtime Loading for Linux Cross-Compilation
- * Loads libsteam_api.so at runtime using dlopen()
- * This allows cross-compilation from macOS (musl) while still using glibc-based Steam library
+ * Steam API Runtime Loading
+ * Loads libsteam_api (.so / .dylib / steam_api64.dll) on demand instead of
+ * linking it: SteamworksManager::LoadSteamApi() opens the library and resolves
+ * every entry point Gemcore calls into one function table, the first time
+ * Steamworks is initialized. Games with `steamworks.enabled` off never touch
+ * the library, and nothing Steam-related is resolved by the dynamic linker at
+ * startup. This also allows cross-compilation from macOS (musl) while still
+ * using the glibc-based Steam library.
+ *
+ * The exported functions below forward to the table; before a successful load
+ * (or for entry points the library lacks) they return a failure value.
  */
 
-#ifdef __linux__
+#include "gemcore-steamworks.h"
 
-#include <dlfcn.h>
 #include <cstdint>
 #include <cstdlib>  // for getenv
 #include <iostream>
+#include <mutex>
+#include <string>
 
-// Function pointer types
-typedef bool (*SteamAPI_Init_t)();
-typedef void (*SteamAPI_Shutdown_t)();
-typedef void (*SteamAPI_RunCallbacks_t)();
-typedef int (*SteamAPI_GetHSteamUser_t)();
-typedef void* (*SteamInternal_FindOrCreateUserInterface_t)(int, const char*);
-typedef int (*SteamInternal_SteamAPI_Init_t)(const char*, void*);
-typedef void* (*SteamInternal_ContextInit_t)(void*);
-
-// Global library handle
-static void* g_steamLib = nullptr;
-
-// Function pointers
-static SteamAPI_Init_t SteamAPI_Init_ptr = nullptr;
-static SteamAPI_Shutdown_t SteamAPI_Shutdown_ptr = nullptr;
-static SteamAPI_RunCallbacks_t SteamAPI_RunCallbacks_ptr = nullptr;
-static SteamAPI_GetHSteamUser_t SteamAPI_GetHSteamUser_ptr = nullptr;
-static SteamInternal_FindOrCreateUserInterface_t SteamInternal_FindOrCreateUserInterface_ptr = nullptr;
-static SteamInternal_SteamAPI_Init_t SteamInternal_SteamAPI_Init_ptr = nullptr;
-static SteamInternal_ContextInit_t SteamInternal_ContextInit_ptr = nullptr;
-
-// Load Steam library at startup
-__attribute__((constructor))
-static void load_steam_library() {
-    // Try multiple paths
-    const char* paths[] = {
-        "libsteam_api.so",           // LD_LIBRARY_PATH (from /tmp extraction)
-        "./libsteam_api.so",         // Current directory
-        "/tmp/libsteam_api.so"       // Fallback
-    };
-    
-    for (const char* path : paths) {
-        g_steamLib = dlopen(path, RTLD_LAZY | RTLD_GLOBAL);
-        if (g_steamLib) {
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+/**
+ * Every libsteam_api export Gemcore uses:
+ * X(return type, name, parameters, arguments, result while not loaded)
+ */
+#define GEMCORE_STEAM_API_FUNCTIONS(X) \
+    X(int, SteamInternal_SteamAPI_Init, (const char* versions, void* errMsg), (versions, errMsg), 1 /* k_ESteamAPIInitResult_FailedGeneric */) \
+    X(void, SteamAPI_Shutdown, (), (), (void)0) \
+    X(void, SteamAPI_RunCallbacks, (), (), (void)0) \
+    X(int, SteamAPI_GetHSteamUser, (), (), 0) \
+    X(void*, SteamInternal_FindOrCreateUserInterface, (int user, const char* version), (user, version), nullptr) \
+    X(void*, SteamInternal_ContextInit, (void* context), (context), nullptr) \
+    /* Callbacks (STEAM_CALLBACK_MANUAL) and call results (CCallResult) register through these */ \
+    X(void, SteamAPI_RegisterCallback, (void* callback, int id), (callback, id), (void)0) \
+    X(void, SteamAPI_UnregisterCallback, (void* callback), (callback), (void)0) \
+    X(void, SteamAPI_RegisterCallResult, (void* callback, uint64_t call), (callback, call), (void)0) \
+    X(void, SteamAPI_UnregisterCallResult, (void* callback, uint64_t call), (callback, call), (void)0) \
+    /* Flat friends API (CSteamID-free, see GetFriendPersonaName) */ \
+    X(void*, SteamAPI_SteamFriends_v018, (), (), nullptr) \
+    X(int, SteamAPI_ISteamFriends_GetFriendCount, (void* self, int flags), (self, flags), 0) \
+    X(uint64_t, SteamAPI_ISteamFriends_GetFriendByIndex, (void* self, int index, int flags), (self, index, flags), 0) \
+    X(const char*, SteamAPI_ISteamFriends_GetFriendPersonaName, (void* self, uint64_t steamID), (self, steamID), "") \
+    X(int, SteamAPI_ISteamFriends_GetFriendPersonaState, (void* self, uint64_t steamID), (self, steamID), 0) \
+    X(bool, SteamAPI_ISteamFriends_GetFriendGamePlayed, (void* self, uint64_t steamID, void* gameInfo), (self, steamID, gameInfo), false)
+
+struct SteamApiTable {
+    #define GEMCORE_STEAM_API_SLOT(ret, name, params, args, fallback) ret (*name) params = nullptr;
+    GEMCORE_STEAM_API_FUNCTIONS(GEMCORE_STEAM_API_SLOT)
+    #undef GEMCORE_STEAM_API_SLOT
+};
+
+SteamApiTable g_api;
+
+#ifdef _WIN32
+using LibraryHandle = HMODULE;
+
+LibraryHandle openLibrary(const char* path) {
+    return LoadLibraryA(path);
+}
+
+void* findSymbol(LibraryHandle library, const char* name) {
+    return reinterpret_cast<void*>(GetProcAddress(library, name));
+}
+
+std::string lastError() {
+    return "error " + std::to_string(GetLastError());
+}
+
+// The universal launcher puts its extracted DLL on PATH; otherwise next to the exe
+const char* const kLibraryPaths[] = { "steam_api64.dll" };
+#else
+using LibraryHandle = void*;
+
+LibraryHandle openLibrary(const char* path) {
+    return dlopen(path, RTLD_LAZY | RTLD_GLOBAL);
+}
+
+void* findSymbol(LibraryHandle library, const char* name) {
+    return dlsym(library, name);
+}
+
+std::string lastError() {
+    const char* error = dlerror();
+    return error ? error : "unknown error";
+}
+
+#ifdef __APPLE__
+const char* const kLibraryPaths[] = {
+    "@executable_path/libsteam_api.dylib",  // .app/Contents/MacOS
+    "libsteam_api.dylib"
+};
+#else
+const char* const kLibraryPaths[] = {
+    "libsteam_api.so",           // LD_LIBRARY_PATH
+    "./libsteam_api.so",         // Current directory
+    "/tmp/libsteam_api.so"       // Fallback
+};
+#endif
+#endif
+
+bool loadLibrary() {
+    // GEMCORE_STEAM_LIB is set by the universal launcher (cache file or memfd: /proc/self/fd/N)
+    const char* embeddedLib = getenv("GEMCORE_STEAM_LIB");
+    LibraryHandle library = nullptr;
+    std::string tried;
+    std::string error;
+
+    auto tryPath = [&](const char* path) {
+        if (library || !path || !*path) return;
+        library = openLibrary(path);
+        if (library) {
             // Always log (even in release mode) for debugging
             std::cout << " Loaded Steam library from: " << path << std::endl;
-            break;
+        } else {
+            tried += tried.empty() ? path : std::string(", ") + path;
+            error = lastError();
         }
+    };
+    tryPath(embeddedLib);
+    for (const char* path : kLibraryPaths) {
+        tryPath(path);
     }
-    
-    if (!g_steamLib) {
+
+    if (!library) {
         // Always log errors (even in release mode)
         std::cerr << "  Steam library not found. Steamworks disabled." << std::endl;
-        std::cerr << "   Error: " << dlerror() << std::endl;
-        std::cerr << "   Tried paths: libsteam_api.so, ./libsteam_api.so, /tmp/libsteam_api.so" << std::endl;
-        std::cerr << "   LD_LIBRARY_PATH: " << (getenv("LD_LIBRARY_PATH") ? getenv("LD_LIBRARY_PATH") : "(not set)") << std::endl;
-        return;
+        std::cerr << "   Error: " << error << std::endl;
+        std::cerr << "   Tried paths: " << tried << std::endl;
+        return false;
     }
-    
-    // Load all function pointers
-    SteamAPI_Init_ptr = (SteamAPI_Init_t)dlsym(g_steamLib, "SteamAPI_Init");
-    SteamAPI_Shutdown_ptr = (SteamAPI_Shutdown_t)dlsym(g_steamLib, "SteamAPI_Shutdown");
-    SteamAPI_RunCallbacks_ptr = (SteamAPI_RunCallbacks_t)dlsym(g_steamLib, "SteamAPI_RunCallbacks");
-    SteamAPI_GetHSteamUser_ptr = (SteamAPI_GetHSteamUser_t)dlsym(g_steamLib, "SteamAPI_GetHSteamUser");
-    SteamInternal_FindOrCreateUserInterface_ptr = (SteamInternal_FindOrCreateUserInterface_t)dlsym(g_steamLib, "SteamInternal_FindOrCreateUserInterface");
-    SteamInternal_SteamAPI_Init_ptr = (SteamInternal_SteamAPI_Init_t)dlsym(g_steamLib, "SteamInternal_SteamAPI_Init");
-    SteamInternal_ContextInit_ptr = (SteamInternal_ContextInit_t)dlsym(g_steamLib, "SteamInternal_ContextInit");
-    
-    if (SteamAPI_Init_ptr && SteamAPI_Shutdown_ptr && SteamAPI_RunCallbacks_ptr) {
-        // Always log (even in release mode) for debugging
-        std::cout << " Steam API functions loaded successfully!" << std::endl;
-    } else {
+
+    // Resolve the whole table at once; the library stays loaded until exit
+    #define GEMCORE_STEAM_API_RESOLVE(ret, name, params, args, fallback) \
+        g_api.name = reinterpret_cast<ret (*) params>(findSymbol(library, #name));
+    GEMCORE_STEAM_API_FUNCTIONS(GEMCORE_STEAM_API_RESOLVE)
+    #undef GEMCORE_STEAM_API_RESOLVE
+
+    if (!g_api.SteamInternal_SteamAPI_Init || !g_api.SteamAPI_Shutdown || !g_api.SteamAPI_RunCallbacks ||
+        !g_api.SteamInternal_FindOrCreateUserInterface || !g_api.SteamInternal_ContextInit) {
         // Always log errors (even in release mode)
-        std::cerr << "  Failed to load Steam API functions" << std::endl;
+        std::cerr << "  Failed to load Steam API functions (Steam SDK too old?)" << std::endl;
+        return false;
     }
+    return true;
 }
 
-// Wrapper functions that call through function pointers
-extern "C" {
-    bool SteamAPI_Init() {
-        return SteamAPI_Init_ptr ? SteamAPI_Init_ptr() : false;
-    }
-    
-    void SteamAPI_Shutdown() {
-        if (SteamAPI_Shutdown_ptr) SteamAPI_Shutdown_ptr();
-    }
-    
-    void SteamAPI_RunCallbacks() {
-        if (SteamAPI_RunCallbacks_ptr) SteamAPI_RunCallbacks_ptr();
-    }
-    
-    int SteamAPI_GetHSteamUser() {
-        return SteamAPI_GetHSteamUser_ptr ? SteamAPI_GetHSteamUser_ptr() : 0;
-    }
-    
-    void* SteamInternal_FindOrCreateUserInterface(int a, const char* b) {
-        return SteamInternal_FindOrCreateUserInterface_ptr ? SteamInternal_FindOrCreateUserInterface_ptr(a, b) : nullptr;
-    }
-    
-    int SteamInternal_SteamAPI_Init(const char* a, void* b) {
-        return SteamInternal_SteamAPI_Init_ptr ? SteamInternal_SteamAPI_Init_ptr(a, b) : 0;
-    }
-    
-    void* SteamInternal_ContextInit(void* a) {
-        return SteamInternal_ContextInit_ptr ? SteamInternal_ContextInit_ptr(a) : nullptr;
-    }
-    
-    // Additional stubs for Steamworks API functions
-    void* SteamAPI_SteamFriends_v018() {
-        return nullptr;
-    }
-    
-    void* SteamAPI_ISteamFriends_GetFriendByIndex(void* self, int index, int flags) {
-        return nullptr;
-    }
-    
-    const char* SteamAPI_ISteamFriends_GetFriendPersonaName(void* self, void* steamID) {
-        return "";
-    }
-}
+} // namespace
 
-#endif // __linux__
+namespace gemcore {
+namespace steamworks {
 
+bool SteamworksManager::LoadSteamApi() {
+    static std::once_flag once;
+    static bool loaded = false;
+    std::call_once(once, [] { loaded = loadLibrary(); });
+    return loaded;
+}
 
+} // namespace steamworks
+} // namespace gemcore
 
+// Exported entry points that call through the function table
+extern "C" {
+    #define GEMCORE_STEAM_API_FORWARD(ret, name, params, args, fallback) \
+        ret name params { return g_api.name ? g_api.name args : fallback; }
+    GEMCORE_STEAM_API_FUNCTIONS(GEMCORE_STEAM_API_FORWARD)
+    #undef GEMCORE_STEAM_API_FORWARD
+}
@@ -0,0 +1,170 @@
+/**
+ *  Gemcore Asset Bench - load and decode timing for gemcore-assets containers
+ *
+ * Opens each container the way the launcher does (SharedAssetLoader mapping the
+ * file in place) and reports, per container:
+ * - size     bytes on disk vs. decoded bytes, assets stored gzip
+ * - map      mmap + TOC parse, after dropping the file from the page cache
+ *            (posix_fadvise DONTNEED - approximates a cold start)
+ * - first    getAsset() on every path: decrypt + verify + inflate (first request)
+ * - cached   getAsset() on every path again (inflated copies are cached)
+ * - stored   getStoredAsset() + verifyAsset() on every path - what the HTTP
+ *            server does for clients that accept gzip
+ *
+ * Compare a default pack with a --no-compress pack of the same directory to see
+ * what per-asset gzip costs at startup and saves on disk:
+ *   gemcore-pack packed.gz dist && gemcore-pack --no-compress packed.raw dist
+ *   gemcore-asset-bench packed.gz packed.raw
+ *
+ * Exits non-zero if a container fails to load or an asset fails to decode.
+ *
+ * Usage: gemcore-asset-bench [--runs N] <gemcore-assets>...
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "gemcore-asset-loader.h"
+
+using gemcore::assets::SharedAssetLoader;
+namespace http = gemcore::http;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& container, const std::string& metric, double value, const char* unit) {
+    std::cout << std::left << std::setw(24) << container << std::setw(28) << metric
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << value
+              << " " << unit << std::endl;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+struct Timings {
+    std::vector<double> map, first, cached, stored;
+};
+
+/**
+ * One cold load of `path`: map, first pass, cached pass, stored pass
+ */
+bool runOnce(const std::string& path, Timings& timings, uint64_t& storedBytes, uint64_t& rawBytes,
+             size_t& assetCount, size_t& gzipCount) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        std::cerr << " Cannot open " << path << std::endl;
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    // The loader's progress lines would drown the report
+    SharedAssetLoader loader;
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    auto start = Clock::now();
+    bool loaded = loader.loadFromRegion(fd, 0, (uint64_t)st.st_size);
+    timings.map.push_back(elapsedMs(start));
+    std::cout.rdbuf(out);
+    close(fd);
+    if (!loaded) return false;
+
+    const std::vector<std::string> paths = loader.getAllPaths();
+    assetCount = paths.size();
+    storedBytes = (uint64_t)st.st_size;
+    rawBytes = 0;
+    gzipCount = 0;
+
+    start = Clock::now();
+    for (const auto& assetPath : paths) {
+        http::Asset asset = loader.getAsset(assetPath);
+        if (!asset.data) return false;
+        rawBytes += asset.size;
+    }
+    timings.first.push_back(elapsedMs(start));
+
+    start = Clock::now();
+    for (const auto& assetPath : paths) {
+        if (!loader.getAsset(assetPath).data) return false;
+    }
+    timings.cached.push_back(elapsedMs(start));
+
+    start = Clock::now();
+    for (const auto& assetPath : paths) {
+        http::Asset asset = loader.getStoredAsset(assetPath);
+        if (!asset.data || !loader.verifyAsset(assetPath)) return false;
+        if (!asset.contentEncoding.empty()) gzipCount++;
+    }
+    timings.stored.push_back(elapsedMs(start));
+    return true;
+}
+
+bool benchContainer(const std::string& path, int runs) {
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    Timings timings;
+    uint64_t storedBytes = 0;
+    uint64_t rawBytes = 0;
+    size_t assetCount = 0;
+    size_t gzipCount = 0;
+
+    for (int run = 0; run < runs; run++) {
+        if (!runOnce(path, timings, storedBytes, rawBytes, assetCount, gzipCount)) {
+            std::cerr << " " << name << ": failed to load or decode" << std::endl;
+            return false;
+        }
+    }
+
+    const double firstMs = median(timings.first);
+    report(name, "assets", (double)assetCount, "");
+    report(name, "stored gzip", (double)gzipCount, "");
+    report(name, "on disk", storedBytes / 1024.0, "KB");
+    report(name, "decoded", rawBytes / 1024.0, "KB");
+    report(name, "map + TOC (cold)", median(timings.map), "ms");
+    report(name, "first getAsset, all paths", firstMs, "ms");
+    report(name, "first getAsset throughput", firstMs > 0 ? rawBytes / (firstMs / 1000.0) / (1024 * 1024) : 0, "MB/s");
+    report(name, "cached getAsset, all paths", median(timings.cached), "ms");
+    report(name, "stored + verify, all paths", median(timings.stored), "ms");
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int runs = 7;
+    std::vector<std::string> containers;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else {
+            containers.push_back(argv[i]);
+        }
+    }
+    if (containers.empty()) {
+        std::cerr << "Usage: gemcore-asset-bench [--runs N] <gemcore-assets>..." << std::endl;
+        return 1;
+    }
+
+    // Every run maps and decrypts on its own (no segment shared between runs)
+    unsetenv("GEMCORE_SHARED_ASSETS");
+
+    bool ok = true;
+    for (const auto& container : containers) {
+        ok &= benchContainer(container, runs);
+    }
+    return ok ? 0 : 1;
+}
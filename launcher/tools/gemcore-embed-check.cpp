@@ -0,0 +1,380 @@
+/**
+ *  Gemcore Embed Check - launch path of a packed single-file executable (Linux)
+ *
+ * Packs a synthetic executable around the given universal launcher (this tool
+ * as the embedded binary, a dummy asset container and Steam library, a config
+ * record with an App ID), runs it under ptrace and checks:
+ * - the launcher's I/O on its own executable up to the fork: ONE open, ONE
+ *   fstat, at most 2 preads (footer + config section), no read()s - sections
+ *   are copied from the same descriptor, never reopened
+ * - the child sees SteamAppId/SteamGameId from the config section, and the
+ *   GEMCORE_ASSETS_* region of the asset container
+ *
+ * Exits non-zero if a check fails, so CI can run it.
+ *
+ * Usage: gemcore-embed-check <gemcore-universal-launcher-linux-embedded>
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <filesystem>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <elf.h>
+#include <sys/ptrace.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+
+#include "gemcore-embedded-footer.h"
+#include "gemcore-config-record.h"
+
+using gemcore::embedded::Footer;
+using gemcore::embedded::Section;
+
+namespace {
+
+const uint32_t APP_ID = 480;
+const char* REPORT_ENV = "GEMCORE_EMBED_CHECK_REPORT";
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream data;
+    data << in.rdbuf();
+    out = data.str();
+    return true;
+}
+
+uint64_t fnv1a64(const std::string& data) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Config record with the Steam fields, as embed-assets-shared.ts writes it
+ */
+std::string steamRecord() {
+    std::string record(gemcore::config::RECORD_MAGIC, 4);
+    auto put16 = [&record](uint16_t v) { record.append(reinterpret_cast<const char*>(&v), 2); };
+    auto put32 = [&record](uint32_t v) { record.append(reinterpret_cast<const char*>(&v), 4); };
+    put16(gemcore::config::RECORD_VERSION);
+    put16(2);
+    put16(gemcore::config::STEAM_ENABLED);
+    put16(1);
+    record.push_back(1);
+    put16(gemcore::config::STEAM_APP_ID);
+    put16(4);
+    put32(APP_ID);
+    return record;
+}
+
+/**
+ * [launcher][binary][assets][config][steam library][footer], 8-byte aligned
+ * like scripts/pack-linux-single-exe.ts
+ */
+bool packExecutable(const std::string& launcherPath, const std::string& outPath, Footer& footer) {
+    std::string launcher, binary;
+    char self[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (len <= 0 || !readFile(launcherPath, launcher)) return false;
+    self[len] = '\0';
+    if (!readFile(self, binary)) return false;
+
+    const std::string sections[gemcore::embedded::SECTION_COUNT] = {
+        binary,
+        std::string(64 * 1024, 'A'),
+        steamRecord(),
+        std::string(16 * 1024, 'S')
+    };
+
+    std::string out = launcher;
+    std::memset(&footer, 0, sizeof(footer));
+    footer.version = gemcore::embedded::FOOTER_VERSION;
+    footer.footerSize = sizeof(Footer);
+    for (int i = 0; i < gemcore::embedded::SECTION_COUNT; i++) {
+        out.resize((out.size() + 7) & ~size_t(7), '\0');
+        footer.sections[i] = { out.size(), sections[i].size(), fnv1a64(sections[i]) };
+        out += sections[i];
+    }
+    footer.checksum = gemcore::embedded::fnv1a32(reinterpret_cast<const uint8_t*>(&footer), offsetof(Footer, checksum));
+    std::memcpy(footer.magic, gemcore::embedded::FOOTER_MAGIC, sizeof(footer.magic));
+    out.append(reinterpret_cast<const char*>(&footer), sizeof(footer));
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), (std::streamsize)out.size());
+    file.close();
+    return file.good() && chmod(outPath.c_str(), 0755) == 0;
+}
+
+//
+// Syscall tracing
+//
+
+struct Regs {
+    long nr;
+    unsigned long args[6];
+    long ret;
+};
+
+bool getRegs(pid_t pid, Regs& regs) {
+#if defined(__x86_64__)
+    user_regs_struct r;
+    if (ptrace(PTRACE_GETREGS, pid, nullptr, &r) != 0) return false;
+    regs.nr = (long)r.orig_rax;
+    unsigned long args[6] = { r.rdi, r.rsi, r.rdx, r.r10, r.r8, r.r9 };
+    std::memcpy(regs.args, args, sizeof(args));
+    regs.ret = (long)r.rax;
+    return true;
+#elif defined(__aarch64__)
+    user_pt_regs r;
+    iovec io = { &r, sizeof(r) };
+    if (ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &io) != 0) return false;
+    regs.nr = (long)r.regs[8];
+    for (int i = 0; i < 6; i++) regs.args[i] = r.regs[i];
+    regs.ret = (long)r.regs[0];
+    return true;
+#else
+    (void)pid;
+    (void)regs;
+    return false;
+#endif
+}
+
+std::string readString(pid_t pid, unsigned long address) {
+    char buf[PATH_MAX];
+    iovec local = { buf, sizeof(buf) };
+    iovec remote = { reinterpret_cast<void*>(address), sizeof(buf) };
+    ssize_t n = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+    if (n <= 0) return "";
+    return std::string(buf, strnlen(buf, (size_t)n));
+}
+
+std::string fdTarget(pid_t pid, int fd) {
+    char target[PATH_MAX];
+    std::string link = "/proc/" + std::to_string(pid) + "/fd/" + std::to_string(fd);
+    ssize_t len = readlink(link.c_str(), target, sizeof(target) - 1);
+    return len > 0 ? std::string(target, (size_t)len) : "";
+}
+
+/**
+ * The launcher's I/O on its own executable until it forks the game
+ */
+struct LaunchIo {
+    int exeOpens = 0;
+    int fstats = 0;
+    int preads = 0;
+    int reads = 0;
+    int lseeks = 0;
+    int copies = 0;         // copy_file_range / sendfile (kernel-side section copies)
+    uint64_t bytesRead = 0;
+};
+
+bool isForkSyscall(long nr) {
+    if (nr == SYS_clone) return true;
+#ifdef SYS_clone3
+    if (nr == SYS_clone3) return true;
+#endif
+#ifdef SYS_fork
+    if (nr == SYS_fork || nr == SYS_vfork) return true;
+#endif
+    return false;
+}
+
+/**
+ * Run `exePath` traced; counts until the first fork, then lets it finish
+ * Returns the exit status, -1 if tracing failed.
+ */
+int traceLaunch(const std::string& exePath, LaunchIo& io) {
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        ptrace(PTRACE_TRACEME, 0, nullptr, nullptr);
+        raise(SIGSTOP);
+        char* argv[] = { const_cast<char*>(exePath.c_str()), nullptr };
+        execv(exePath.c_str(), argv);
+        _exit(127);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) != pid || !WIFSTOPPED(status)) return -1;
+    ptrace(PTRACE_SETOPTIONS, pid, nullptr, (void*)(long)(PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL));
+
+    bool entering = true;
+    bool execDone = false;
+    std::set<int> exeFds;  // Descriptors of the packed executable in the launcher
+    Regs entry{};
+    int signal = 0;
+    while (true) {
+        if (ptrace(PTRACE_SYSCALL, pid, nullptr, (void*)(long)signal) != 0) return -1;
+        signal = 0;
+        if (waitpid(pid, &status, 0) != pid) return -1;
+        if (WIFEXITED(status)) return WEXITSTATUS(status);
+        if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+        if (WSTOPSIG(status) != (SIGTRAP | 0x80)) {
+            // The exec trap, or a signal for the launcher (delivered on resume)
+            if (WSTOPSIG(status) != SIGTRAP) signal = WSTOPSIG(status);
+            continue;
+        }
+
+        Regs regs;
+        if (!getRegs(pid, regs)) return -1;
+        if (entering) {
+            entry = regs;
+            if (execDone && isForkSyscall(regs.nr)) break;  // The launcher starts the game
+        } else if (!execDone) {
+            execDone = entry.nr == SYS_execve;  // Count from the packed executable's first syscall
+        } else {
+            const long nr = entry.nr;
+            const int fd = (int)entry.args[0];
+            const bool onExe = exeFds.count(fd) != 0;
+            bool opened = nr == SYS_openat;
+#ifdef SYS_open
+            opened |= nr == SYS_open;
+#endif
+            if (opened && regs.ret >= 0) {
+                // Resolve what was opened: catches reopening through /proc/self/exe too
+                if (fdTarget(pid, (int)regs.ret) == exePath) {
+                    io.exeOpens++;
+                    exeFds.insert((int)regs.ret);
+                }
+            } else if (nr == SYS_close) {
+                exeFds.erase(fd);
+            }
+#ifdef SYS_fstat
+            if (nr == SYS_fstat && onExe) io.fstats++;
+#endif
+#ifdef SYS_newfstatat
+            if (nr == SYS_newfstatat && onExe && readString(pid, entry.args[1]).empty()) io.fstats++;
+#endif
+#ifdef SYS_statx
+            if (nr == SYS_statx && onExe && readString(pid, entry.args[1]).empty()) io.fstats++;
+#endif
+            if (nr == SYS_pread64 && onExe) {
+                io.preads++;
+                if (regs.ret > 0) io.bytesRead += (uint64_t)regs.ret;
+            }
+            if ((nr == SYS_read || nr == SYS_readv || nr == SYS_preadv) && onExe) io.reads++;
+            if (nr == SYS_lseek && onExe) io.lseeks++;
+            if (nr == SYS_copy_file_range && onExe) io.copies++;
+            if (nr == SYS_sendfile && exeFds.count((int)entry.args[1])) io.copies++;
+        }
+        entering = !entering;
+    }
+
+    // Untraced from here on: the game runs and the launcher waits for it
+    ptrace(PTRACE_DETACH, pid, nullptr, nullptr);
+    if (waitpid(pid, &status, 0) != pid) return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+bool check(bool ok, const std::string& what) {
+    if (!ok) std::cerr << " " << what << std::endl;
+    return ok;
+}
+
+void report(const std::string& metric, uint64_t value, const char* unit = "") {
+    std::cout << std::left << std::setw(34) << metric << std::right << std::setw(8) << value << " " << unit << std::endl;
+}
+
+/**
+ * Running as the embedded binary: write what the launcher handed over
+ */
+int childMain(const char* reportPath) {
+    std::ofstream out(reportPath);
+    for (const char* name : { "SteamAppId", "SteamGameId", "GEMCORE_ASSETS_SIZE", "GEMCORE_STEAM_LIB" }) {
+        const char* value = getenv(name);
+        out << name << "=" << (value ? value : "") << "\n";
+    }
+    return out.good() ? 0 : 1;
+}
+
+std::string reportValue(const std::string& report, const std::string& name) {
+    size_t pos = report.find(name + "=");
+    if (pos == std::string::npos) return "";
+    pos += name.size() + 1;
+    return report.substr(pos, report.find('\n', pos) - pos);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (const char* reportPath = getenv(REPORT_ENV)) {
+        return childMain(reportPath);
+    }
+    if (argc != 2) {
+        std::cerr << "Usage: gemcore-embed-check <gemcore-universal-launcher-linux-embedded>" << std::endl;
+        return 1;
+    }
+
+    char tmpl[] = "/tmp/gemcore-embed-check-XXXXXX";
+    char* dir = mkdtemp(tmpl);
+    char resolved[PATH_MAX];
+    if (!dir || !realpath(dir, resolved)) {
+        std::cerr << " Cannot create a temp directory" << std::endl;
+        return 1;
+    }
+    const std::string tmp = resolved;
+    const std::string exePath = tmp + "/packed";
+    const std::string reportPath = tmp + "/report";
+
+    Footer footer;
+    std::error_code ec;
+    if (!packExecutable(argv[1], exePath, footer)) {
+        std::cerr << " Failed to pack " << exePath << std::endl;
+        std::filesystem::remove_all(tmp, ec);
+        return 1;
+    }
+
+    // A fresh extraction cache; App ID only from the config section
+    setenv("XDG_CACHE_HOME", (tmp + "/cache").c_str(), 1);
+    setenv(REPORT_ENV, reportPath.c_str(), 1);
+    unsetenv("SteamAppId");
+    unsetenv("SteamGameId");
+
+    LaunchIo io;
+    int exitCode = traceLaunch(exePath, io);
+    std::string result;
+    readFile(reportPath, result);
+
+    report("open of the executable", io.exeOpens);
+    report("fstat", io.fstats);
+    report("pread", io.preads);
+    report("read", io.reads);
+    report("lseek", io.lseeks);
+    report("copy_file_range / sendfile", io.copies);
+    report("bytes read", io.bytesRead, "B");
+
+    bool ok = check(exitCode == 0, "launcher exited with " + std::to_string(exitCode));
+    ok &= check(io.exeOpens == 1, "executable opened " + std::to_string(io.exeOpens) + " times (expected once)");
+    ok &= check(io.fstats == 1, "fstat of the executable " + std::to_string(io.fstats) + " times (expected once)");
+    ok &= check(io.preads <= 2, std::to_string(io.preads) + " preads (expected footer + config section)");
+    ok &= check(io.reads == 0, std::to_string(io.reads) + " read()s of the executable (expected none)");
+    ok &= check(reportValue(result, "SteamAppId") == std::to_string(APP_ID), "child did not get SteamAppId from the config section");
+    ok &= check(reportValue(result, "SteamGameId") == std::to_string(APP_ID), "child did not get SteamGameId");
+    ok &= check(reportValue(result, "GEMCORE_ASSETS_SIZE") == std::to_string(footer.sections[gemcore::embedded::SECTION_ASSETS].size),
+                "child did not get the asset region");
+    ok &= check(!reportValue(result, "GEMCORE_STEAM_LIB").empty(), "child did not get GEMCORE_STEAM_LIB");
+
+    std::filesystem::remove_all(tmp, ec);
+
+    std::cout << (ok ? " Launch path OK" : " Launch path check FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,907 @@
+/**
+ *  Gemcore Pack - Native asset packer
+ *
+ * Writes gemcore-assets containers (GEMCORE3 by default, GEMCORE1/2 on request)
+ * without holding the project in memory:
+ * - Layout (TOC + data offsets) is computed from file sizes up front
+ * - Worker threads stream each file in 1 MB chunks, XOR it with the
+ *   precomputed keystream and pwrite() it at its final offset
+ * - Only compressed text assets are buffered (they are small after gzip)
+ * - GEMCORE3 integrity hashes are computed in the same pass; the TOC is
+ *   written last
+ *
+ * Output is deterministic: entries are sorted by path, gzip headers carry no
+ * timestamp/OS, and the data offsets do not depend on thread scheduling.
+ * The same inputs and key always produce byte-identical containers.
+ *
+ * Byte-identical files are stored once: files whose size occurs more than once
+ * are hashed (XXH64) and compared, and duplicates become TOC aliases that point
+ * at the first copy's blob.
+ *
+ * Incremental mode (--incremental) keeps <output>.manifest with
+ * path -> content hash -> container offset and reuses the key from the
+ * previous run, so unchanged (already encrypted) blobs stay valid:
+ * - Unchanged size + mtime (or, failing that, the same XXH64) -> blob reused
+ * - Changed/new blobs are appended and the TOC is rewritten in place
+ *   (the TOC area is over-allocated for this)
+ * - Once dead blobs outweigh live ones, or the TOC outgrows its area, the
+ *   container is compacted: reused blobs are copied as-is, only changed
+ *   files are read/compressed/encrypted
+ *
+ * Access profile (--profile <file>, recorded with GEMCORE_RECORD_ACCESS): blobs
+ * are laid out in first-access order (the rest by path) and the profiled paths
+ * are stored as PROFILE_PATH, so the loader can read ahead and decrypt that
+ * prefix first. The TOC stays sorted by path. In-place incremental updates
+ * keep reused blobs where they are; the next compaction restores the order.
+ *
+ * Usage: gemcore-pack [options] <output> [<dir>...]
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cinttypes>
+#include <zlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "gemcore-asset-format.h"
+#include "gemcore-config-record.h"
+
+namespace fs = std::filesystem;
+using namespace gemcore::assets;
+
+struct PackEntry {
+    std::string path;            // Path inside the container ('/' separated)
+    std::string source;          // File on disk
+    uint64_t rawSize = 0;
+    uint8_t codec = CODEC_RAW;
+    std::vector<uint8_t> packed; // Compressed payload (only when codec != RAW)
+    uint64_t dataOffset = 0;
+
+    // Incremental mode
+    int64_t mtimeNs = 0;
+    uint64_t hash = 0;           // XXH64 of the raw file
+    uint64_t storedHash = 0;     // XXH64 of the stored payload (GEMCORE3 TOC)
+    bool reused = false;         // Encrypted blob already in the previous container
+    uint64_t oldOffset = 0;
+    uint64_t oldStoredSize = 0;
+
+    // Deduplication
+    bool hashed = false;         // `hash` is valid
+    long alias = -1;             // Index of the entry whose blob this one shares
+    uint64_t aliasStoredSize = 0;
+
+    uint64_t storedSize() const {
+        if (alias >= 0) return aliasStoredSize;
+        if (reused) return oldStoredSize;
+        return codec == CODEC_RAW ? rawSize : packed.size();
+    }
+};
+
+struct ManifestEntry {
+    uint64_t hash = 0;
+    uint64_t storedHash = 0;
+    uint64_t rawSize = 0;
+    int64_t mtimeNs = 0;
+    uint8_t codec = CODEC_RAW;
+    uint64_t offset = 0;
+    uint64_t storedSize = 0;
+};
+
+/**
+ * <output>.manifest - state of the previous incremental run
+ */
+struct Manifest {
+    bool valid = false;
+    uint8_t key[KEY_SIZE];
+    int format = 0;
+    bool compress = true;
+    uint64_t tocCapacity = 0;   // Bytes reserved for the TOC after the header
+    uint64_t fileSize = 0;      // Container size when the manifest was written
+    std::map<std::string, ManifestEntry> entries;
+};
+
+struct Options {
+    std::string output;
+    std::vector<std::string> dirs;
+    std::map<std::string, std::string> files;   // archive path -> source file
+    std::string keyHex;
+    int format = 3;
+    bool compress = true;
+    bool incremental = false;
+    unsigned jobs = 0;
+    std::string profile;                        // Access profile (GEMCORE_RECORD_ACCESS)
+};
+
+static const size_t CHUNK_SIZE = 1024 * 1024;
+
+// Formats that are already compressed (png/jpg/ogg/mp4/woff2/...) are never in here
+static bool isCompressible(const std::string& path) {
+    static const char* extensions[] = {
+        ".html", ".htm", ".js", ".mjs", ".css", ".json", ".map", ".svg", ".xml", ".txt",
+        ".csv", ".wasm", ".ttf", ".otf", ".wav", ".glsl", ".wgsl", ".gltf", ".obj", ".md"
+    };
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    for (const char* e : extensions) {
+        if (ext == e) return true;
+    }
+    return false;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: gemcore-pack [options] <output> [<dir>...]" << std::endl;
+    std::cerr << "  --add <path>=<file>  Add a single file as <path> (repeatable)" << std::endl;
+    std::cerr << "  --key <hex>          32-byte key as 64 hex chars (default: random)" << std::endl;
+    std::cerr << "  --format <1|2|3>     Container format (default: 3, with integrity hashes)" << std::endl;
+    std::cerr << "  --no-compress        Store every asset raw" << std::endl;
+    std::cerr << "  --jobs <n>           Worker threads (default: all cores)" << std::endl;
+    std::cerr << "  --incremental        Reuse unchanged blobs via <output>.manifest (GEMCORE2/3)" << std::endl;
+    std::cerr << "  --profile <file>     Lay out data in recorded access order (GEMCORE2/3)" << std::endl;
+}
+
+static bool parseArgs(int argc, char* argv[], Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--add" && hasValue) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                std::cerr << " Invalid --add (expected <path>=<file>): " << spec << std::endl;
+                return false;
+            }
+            opts.files[spec.substr(0, eq)] = spec.substr(eq + 1);
+        } else if (arg == "--key" && hasValue) {
+            opts.keyHex = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            opts.format = std::atoi(argv[++i]);
+        } else if (arg == "--no-compress") {
+            opts.compress = false;
+        } else if (arg == "--incremental") {
+            opts.incremental = true;
+        } else if (arg == "--jobs" && hasValue) {
+            opts.jobs = (unsigned)std::atoi(argv[++i]);
+        } else if (arg == "--profile" && hasValue) {
+            opts.profile = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << " Unknown option: " << arg << std::endl;
+            return false;
+        } else if (opts.output.empty()) {
+            opts.output = arg;
+        } else {
+            opts.dirs.push_back(arg);
+        }
+    }
+
+    if (opts.output.empty() || opts.format < 1 || opts.format > 3) return false;
+    if (opts.format == 1) opts.compress = false;  // GEMCORE1 has no codec field
+    if (opts.incremental && opts.format == 1) {
+        std::cerr << " --incremental requires --format 2 or 3" << std::endl;
+        return false;
+    }
+    if (!opts.profile.empty() && opts.format == 1) {
+        std::cerr << " --profile requires --format 2 or 3" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read an access profile ("gemcore-access-profile 1", then "<ms>\t<path>" lines)
+ * into first-access order
+ */
+static bool loadAccessProfile(const std::string& file, std::vector<std::string>& order) {
+    std::ifstream in(file);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != "gemcore-access-profile 1") return false;
+
+    std::unordered_map<std::string, bool> seen;
+    while (std::getline(in, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || tab + 1 == line.size()) continue;
+        std::string path = line.substr(tab + 1);
+        if (seen.emplace(path, true).second) order.push_back(std::move(path));
+    }
+    return true;
+}
+
+static bool parseKey(const std::string& hex, uint8_t key[KEY_SIZE]) {
+    if (hex.size() != KEY_SIZE * 2) return false;
+    for (size_t i = 0; i < KEY_SIZE; i++) {
+        unsigned value;
+        if (std::sscanf(hex.c_str() + i * 2, "%2x", &value) != 1) return false;
+        key[i] = (uint8_t)value;
+    }
+    return true;
+}
+
+static std::string toHex(const uint8_t* data, size_t len) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(len * 2);
+    for (size_t i = 0; i < len; i++) {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 15];
+    }
+    return hex;
+}
+
+static int64_t mtimeNs(const struct stat& st) {
+#ifdef __APPLE__
+    return (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    return (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+
+/**
+ * Load <output>.manifest and check that the container still matches it
+ */
+static void loadManifest(const std::string& output, Manifest& manifest) {
+    std::ifstream in(output + ".manifest");
+    std::string line;
+    if (!in || !std::getline(in, line) || line != "gemcore-pack-manifest 2") return;
+
+    bool haveKey = false;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+
+        if (line.find('\t') == std::string::npos) {
+            // Header line: "<name> <value>"
+            size_t sp = line.find(' ');
+            if (sp == std::string::npos) return;
+            std::string name = line.substr(0, sp);
+            std::string value = line.substr(sp + 1);
+            if (name == "key") haveKey = parseKey(value, manifest.key);
+            else if (name == "format") manifest.format = std::atoi(value.c_str());
+            else if (name == "compress") manifest.compress = value == "1";
+            else if (name == "toc-capacity") manifest.tocCapacity = std::strtoull(value.c_str(), nullptr, 10);
+            else if (name == "size") manifest.fileSize = std::strtoull(value.c_str(), nullptr, 10);
+            continue;
+        }
+
+        // Entry line: hash, storedHash, rawSize, mtimeNs, codec, offset, storedSize, path
+        // (path last: may contain tabs)
+        ManifestEntry entry;
+        unsigned codec = 0;
+        int consumed = 0;
+        if (std::sscanf(line.c_str(), "%" SCNx64 "\t%" SCNx64 "\t%" SCNu64 "\t%" SCNd64 "\t%u\t%" SCNu64 "\t%" SCNu64 "\t%n",
+                        &entry.hash, &entry.storedHash, &entry.rawSize, &entry.mtimeNs, &codec,
+                        &entry.offset, &entry.storedSize, &consumed) != 7 || consumed == 0) {
+            return;
+        }
+        entry.codec = (uint8_t)codec;
+        manifest.entries[line.substr((size_t)consumed)] = entry;
+    }
+    if (!haveKey || manifest.tocCapacity == 0) return;
+
+    // The container must be the one this manifest describes
+    int fd = open(output.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    struct stat st;
+    uint8_t header[MAGIC_SIZE + KEY_SIZE];
+    bool match = fstat(fd, &st) == 0 && (uint64_t)st.st_size == manifest.fileSize &&
+                 pread(fd, header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                 memcmp(header, manifest.format == 3 ? MAGIC_V3 : MAGIC_V2, MAGIC_SIZE) == 0 &&
+                 memcmp(header + MAGIC_SIZE, manifest.key, KEY_SIZE) == 0;
+    close(fd);
+    manifest.valid = match;
+}
+
+static bool writeManifest(const std::string& output, const uint8_t key[KEY_SIZE], int format, bool compress,
+                          uint64_t tocCapacity, uint64_t fileSize, const std::vector<PackEntry>& entries) {
+    std::string path = output + ".manifest";
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        out << "gemcore-pack-manifest 2\n";
+        out << "key " << toHex(key, KEY_SIZE) << "\n";
+        out << "format " << format << "\n";
+        out << "compress " << (compress ? 1 : 0) << "\n";
+        out << "toc-capacity " << tocCapacity << "\n";
+        out << "size " << fileSize << "\n";
+
+        char hashes[34];
+        for (const auto& entry : entries) {
+            std::snprintf(hashes, sizeof(hashes), "%016" PRIx64 "\t%016" PRIx64, entry.hash, entry.storedHash);
+            out << hashes << '\t' << entry.rawSize << '\t' << entry.mtimeNs << '\t' << (unsigned)entry.codec << '\t'
+                << entry.dataOffset << '\t' << entry.storedSize() << '\t' << entry.path << '\n';
+        }
+        if (!out.flush()) return false;
+    }
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * XXH64 of a file, streamed (buf is reused scratch space)
+ */
+static bool hashFile(const std::string& path, uint64_t size, std::vector<uint8_t>& buf, uint64_t& hash) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    XXH64 state;
+    buf.resize(CHUNK_SIZE);
+    uint64_t pos = 0;
+    while (pos < size) {
+        ssize_t n = pread(fd, buf.data(), (size_t)std::min<uint64_t>(CHUNK_SIZE, size - pos), (off_t)pos);
+        if (n <= 0) break;
+        state.update(buf.data(), (size_t)n);
+        pos += (uint64_t)n;
+    }
+    close(fd);
+    hash = state.digest();
+    return pos == size;
+}
+
+/**
+ * Deterministic gzip (no timestamp, OS "unknown")
+ */
+static bool gzipBuffer(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    z_stream stream = {};
+    if (deflateInit2(&stream, 9, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+
+    gz_header header = {};
+    header.os = 255;
+    deflateSetHeader(&stream, &header);
+
+    out.resize(deflateBound(&stream, (uLong)in.size()) + 32);
+    stream.next_in = const_cast<Bytef*>(in.data());
+    stream.avail_in = (uInt)in.size();
+    stream.next_out = out.data();
+    stream.avail_out = (uInt)out.size();
+
+    int ret = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ret == Z_STREAM_END;
+}
+
+static bool readWholeFile(const std::string& path, uint64_t size, std::vector<uint8_t>& data) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    data.resize((size_t)size);
+    uint64_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(fd, data.data() + done, (size_t)(size - done), (off_t)done);
+        if (n <= 0) break;
+        done += (uint64_t)n;
+    }
+    close(fd);
+    return done == size;
+}
+
+static bool readAt(int fd, uint8_t* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, (off_t)offset);
+        if (n <= 0) return false;
+        data += n;
+        size -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, (off_t)offset);
+        if (n <= 0) return false;
+        data += n;
+        size -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+/**
+ * Byte-for-byte comparison of two files of the same size (hash matches are verified)
+ */
+static bool sameContents(const std::string& a, const std::string& b, uint64_t size, std::vector<uint8_t>& buf) {
+    int fdA = open(a.c_str(), O_RDONLY | O_CLOEXEC);
+    int fdB = open(b.c_str(), O_RDONLY | O_CLOEXEC);
+    bool same = fdA >= 0 && fdB >= 0;
+
+    buf.resize(CHUNK_SIZE * 2);
+    uint64_t pos = 0;
+    while (same && pos < size) {
+        size_t want = (size_t)std::min<uint64_t>(CHUNK_SIZE, size - pos);
+        same = readAt(fdA, buf.data(), want, pos) && readAt(fdB, buf.data() + CHUNK_SIZE, want, pos) &&
+               memcmp(buf.data(), buf.data() + CHUNK_SIZE, want) == 0;
+        pos += want;
+    }
+    if (fdA >= 0) close(fdA);
+    if (fdB >= 0) close(fdB);
+    return same;
+}
+
+/**
+ * Stream one entry: read (or take the compressed buffer), XOR, pwrite at its offset.
+ * Reused entries are copied verbatim from the previous container (oldFd): the
+ * keystream restarts for every asset, so encrypted blobs can move freely.
+ */
+static bool writeEntry(int outFd, PackEntry& entry, const Keystream& keystream, std::vector<uint8_t>& chunk, int oldFd) {
+    if (entry.reused) {
+        if (entry.oldOffset == entry.dataOffset) return true;  // Updated in place
+
+        chunk.resize(CHUNK_SIZE);
+        uint64_t pos = 0;
+        while (pos < entry.oldStoredSize) {
+            size_t want = (size_t)std::min<uint64_t>(CHUNK_SIZE, entry.oldStoredSize - pos);
+            ssize_t n = pread(oldFd, chunk.data(), want, (off_t)(entry.oldOffset + pos));
+            if (n <= 0 || !writeAll(outFd, chunk.data(), (size_t)n, entry.dataOffset + pos)) return false;
+            pos += (uint64_t)n;
+        }
+        return true;
+    }
+
+    if (entry.codec != CODEC_RAW) {
+        entry.storedHash = XXH64::hash(entry.packed.data(), entry.packed.size());
+        chunk.assign(entry.packed.begin(), entry.packed.end());
+        keystream.apply(chunk.data(), chunk.size());
+        return writeAll(outFd, chunk.data(), chunk.size(), entry.dataOffset);
+    }
+
+    int inFd = open(entry.source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (inFd < 0) return false;
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(inFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    chunk.resize(CHUNK_SIZE);
+    XXH64 hash;
+    uint64_t pos = 0;
+    bool ok = true;
+    while (ok && pos < entry.rawSize) {
+        size_t want = (size_t)std::min<uint64_t>(CHUNK_SIZE, entry.rawSize - pos);
+        ssize_t n = pread(inFd, chunk.data(), want, (off_t)pos);
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        hash.update(chunk.data(), (size_t)n);
+        keystream.apply(chunk.data(), (size_t)n, pos);
+        ok = writeAll(outFd, chunk.data(), (size_t)n, entry.dataOffset + pos);
+        pos += (uint64_t)n;
+    }
+    close(inFd);
+    entry.storedHash = hash.digest();
+    return ok;
+}
+
+template<typename Fn>
+static bool parallelFor(size_t count, unsigned jobs, Fn fn) {
+    std::atomic<size_t> next{0};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> workers;
+
+    for (unsigned t = 0; t < jobs; t++) {
+        workers.emplace_back([&]() {
+            std::vector<uint8_t> scratch;
+            size_t i;
+            while (ok && (i = next++) < count) {
+                if (!fn(i, scratch)) ok = false;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return ok;
+}
+
+static void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; i++) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+int main(int argc, char* argv[]) {
+    auto start = std::chrono::steady_clock::now();
+
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage();
+        return 1;
+    }
+
+    // Incremental: the previous key must be kept, otherwise no blob can be reused
+    Manifest manifest;
+    if (opts.incremental) {
+        loadManifest(opts.output, manifest);
+        if (manifest.valid && (manifest.compress != opts.compress || manifest.format != opts.format)) manifest.valid = false;
+        if (manifest.valid && !opts.keyHex.empty() && opts.keyHex != toHex(manifest.key, KEY_SIZE)) manifest.valid = false;
+    }
+
+    uint8_t key[KEY_SIZE];
+    if (manifest.valid) {
+        std::memcpy(key, manifest.key, KEY_SIZE);
+    } else if (!opts.keyHex.empty()) {
+        if (!parseKey(opts.keyHex, key)) {
+            std::cerr << " Invalid --key (expected 64 hex chars)" << std::endl;
+            return 1;
+        }
+    } else {
+        std::random_device rd;
+        for (size_t i = 0; i < KEY_SIZE; i++) key[i] = (uint8_t)rd();
+    }
+
+    unsigned jobs = opts.jobs ? opts.jobs : std::max(1u, std::thread::hardware_concurrency());
+
+    // PHASE 1: Collect (directories first, --add entries override same paths)
+    std::map<std::string, std::string> sources;
+    for (const auto& dir : opts.dirs) {
+        std::error_code ec;
+        for (auto it = fs::recursive_directory_iterator(dir, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file()) continue;
+            sources[fs::relative(it->path(), dir).generic_string()] = it->path().string();
+        }
+        if (ec) {
+            std::cerr << " Failed to read directory " << dir << ": " << ec.message() << std::endl;
+            return 1;
+        }
+    }
+    for (const auto& kv : opts.files) {
+        sources[kv.first] = kv.second;
+    }
+
+    // Access profile: hot paths in first-access order. The profile entry itself
+    // and the launcher config record are read before any request, so they lead.
+    std::unordered_map<std::string, size_t> hotRank;
+    size_t profileMissing = 0;
+    std::string hotListPath;
+    if (!opts.profile.empty()) {
+        std::vector<std::string> order;
+        if (!loadAccessProfile(opts.profile, order)) {
+            std::cerr << " Invalid access profile: " << opts.profile << std::endl;
+            return 1;
+        }
+
+        std::string hotList = PROFILE_HEADER;
+        hotRank[PROFILE_PATH] = 0;
+        if (sources.count(gemcore::config::RECORD_PATH)) order.insert(order.begin(), gemcore::config::RECORD_PATH);
+        for (const auto& path : order) {
+            if (!sources.count(path)) {
+                profileMissing++;
+                continue;
+            }
+            if (hotRank.count(path)) continue;
+            size_t next = hotRank.size();
+            hotRank[path] = next;
+            hotList += path + "\n";
+        }
+
+        // Packed like any other file (so incremental runs reuse it while it is unchanged)
+        hotListPath = opts.output + ".profile.tmp";
+        std::ofstream out(hotListPath, std::ios::binary | std::ios::trunc);
+        if (!(out << hotList) || !out.flush()) {
+            std::cerr << " Failed to write " << hotListPath << std::endl;
+            return 1;
+        }
+        sources[PROFILE_PATH] = hotListPath;
+    }
+    struct RemoveOnExit {
+        const std::string& path;
+        ~RemoveOnExit() { if (!path.empty()) unlink(path.c_str()); }
+    } removeHotList{ hotListPath };
+
+    // Sorted by path (std::map): deterministic order
+    std::vector<PackEntry> entries;
+    entries.reserve(sources.size());
+    for (const auto& kv : sources) {
+        struct stat st;
+        if (stat(kv.second.c_str(), &st) != 0) {
+            std::cerr << " Failed to stat " << kv.second << std::endl;
+            return 1;
+        }
+        PackEntry entry;
+        entry.path = kv.first;
+        entry.source = kv.second;
+        entry.rawSize = (uint64_t)st.st_size;
+        entry.mtimeNs = mtimeNs(st);
+        entries.push_back(std::move(entry));
+    }
+
+    // PHASE 2: Hash in parallel - every file in incremental mode, otherwise only
+    // files whose size occurs more than once (the only possible duplicates)
+    std::unordered_map<uint64_t, size_t> sizeCount;
+    for (const auto& entry : entries) {
+        sizeCount[entry.rawSize]++;
+    }
+
+    std::atomic<size_t> hashed{0};
+    bool ok = parallelFor(entries.size(), jobs, [&](size_t i, std::vector<uint8_t>& buf) {
+        PackEntry& entry = entries[i];
+        const ManifestEntry* previous = nullptr;
+        if (manifest.valid) {
+            auto it = manifest.entries.find(entry.path);
+            if (it != manifest.entries.end()) previous = &it->second;
+        }
+
+        // Fast path: same size + mtime -> unchanged, no read at all
+        if (previous && previous->rawSize == entry.rawSize && previous->mtimeNs == entry.mtimeNs) {
+            entry.hash = previous->hash;
+            entry.hashed = true;
+            entry.reused = true;
+        } else if (opts.incremental || sizeCount[entry.rawSize] > 1) {
+            if (!hashFile(entry.source, entry.rawSize, buf, entry.hash)) {
+                std::cerr << " Failed to read " << entry.source << std::endl;
+                return false;
+            }
+            entry.hashed = true;
+            hashed++;
+
+            // Touched but identical content
+            entry.reused = previous && previous->rawSize == entry.rawSize && previous->hash == entry.hash;
+        }
+
+        if (entry.reused) {
+            entry.codec = previous->codec;
+            entry.oldOffset = previous->offset;
+            entry.oldStoredSize = previous->storedSize;
+            entry.storedHash = previous->storedHash;
+        }
+        return true;
+    });
+    if (!ok) return 1;
+
+    // PHASE 3: Deduplicate - the first copy (preferring one already in the container)
+    // keeps the blob, the others become aliases. Hash matches are verified byte by byte.
+    size_t aliases = 0;
+    {
+        std::map<std::pair<uint64_t, uint64_t>, size_t> primaries;  // (hash, size) -> entry
+        std::vector<uint8_t> buf;
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < entries.size(); i++) {
+                PackEntry& entry = entries[i];
+                if (!entry.hashed || entry.reused != (pass == 0)) continue;
+
+                auto [it, inserted] = primaries.emplace(std::make_pair(entry.hash, entry.rawSize), i);
+                if (inserted) continue;
+
+                const PackEntry& primary = entries[it->second];
+                bool alreadyShared = entry.reused && primary.reused && entry.oldOffset == primary.oldOffset;
+                if (alreadyShared || sameContents(primary.source, entry.source, entry.rawSize, buf)) {
+                    entry.alias = (long)it->second;
+                    aliases++;
+                }
+            }
+        }
+    }
+
+    // PHASE 4: Compress text assets in parallel (kept only if >= 10% smaller)
+    if (opts.compress) {
+        ok = parallelFor(entries.size(), jobs, [&entries](size_t i, std::vector<uint8_t>& raw) {
+            PackEntry& entry = entries[i];
+            if (entry.reused || entry.alias >= 0 || entry.rawSize < 512 || !isCompressible(entry.path)) return true;
+
+            if (!readWholeFile(entry.source, entry.rawSize, raw)) {
+                std::cerr << " Failed to read " << entry.source << std::endl;
+                return false;
+            }
+            std::vector<uint8_t> gz;
+            if (gzipBuffer(raw, gz) && gz.size() < entry.rawSize * 9 / 10) {
+                entry.codec = CODEC_GZIP;
+                entry.packed = std::move(gz);
+            }
+            return true;
+        });
+        if (!ok) return 1;
+    }
+
+    const size_t headerSize = opts.format == 3 ? HEADER_V3_SIZE : HEADER_SIZE;
+    const size_t fieldsSize = opts.format == 3 ? TOC_FIELDS_V3_SIZE : TOC_FIELDS_SIZE;
+    uint64_t tocSize = 0;
+    uint64_t liveSize = 0;
+    uint64_t savedSize = 0;
+    size_t changed = 0;
+    for (auto& entry : entries) {
+        if (entry.alias >= 0) {
+            const PackEntry& primary = entries[(size_t)entry.alias];
+            entry.codec = primary.codec;
+            entry.aliasStoredSize = primary.storedSize();
+            savedSize += entry.aliasStoredSize;
+        } else {
+            liveSize += entry.storedSize();
+        }
+        if (!entry.reused) changed++;
+        tocSize += 4 + entry.path.size() + fieldsSize;
+    }
+
+    // PHASE 5: Layout - header + TOC, then data at known offsets
+    std::vector<std::pair<uint64_t, std::vector<uint8_t>>> inlineHeaders;  // GEMCORE1 only
+
+    // In place: append changed blobs, keep reused ones where they are.
+    // Compact once the TOC no longer fits or dead blobs outweigh live ones.
+    bool inPlace = false;
+    uint64_t tocCapacity = tocSize;
+    uint64_t offset = headerSize;
+    if (manifest.valid && tocSize <= manifest.tocCapacity) {
+        uint64_t end = manifest.fileSize;
+        for (const auto& entry : entries) {
+            if (!entry.reused && entry.alias < 0) end += entry.storedSize();
+        }
+        uint64_t garbage = end - (headerSize + manifest.tocCapacity) - liveSize;
+        inPlace = garbage <= liveSize;
+    }
+    if (inPlace) {
+        tocCapacity = manifest.tocCapacity;
+        offset = manifest.fileSize;
+    } else if (opts.incremental) {
+        tocCapacity = tocSize + tocSize / 4 + 4096;  // Room for new/renamed files
+    }
+
+    if (opts.format >= 2) {
+        // Blob order: profiled blobs by their first access (through any alias),
+        // then the rest by path
+        std::vector<size_t> rank(entries.size(), SIZE_MAX);
+        for (size_t i = 0; i < entries.size(); i++) {
+            auto it = hotRank.find(entries[i].path);
+            if (it == hotRank.end()) continue;
+            size_t blob = entries[i].alias >= 0 ? (size_t)entries[i].alias : i;
+            rank[blob] = std::min(rank[blob], it->second);
+        }
+        std::vector<size_t> layout;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].alias < 0) layout.push_back(i);
+        }
+        std::stable_sort(layout.begin(), layout.end(), [&rank](size_t a, size_t b) { return rank[a] < rank[b]; });
+
+        if (!inPlace) offset += tocCapacity;
+        for (size_t i : layout) {
+            PackEntry& entry = entries[i];
+            if (inPlace && entry.reused) {
+                entry.dataOffset = entry.oldOffset;
+            } else {
+                entry.dataOffset = offset;
+                offset += entry.storedSize();
+            }
+        }
+        for (auto& entry : entries) {
+            if (entry.alias >= 0) entry.dataOffset = entries[(size_t)entry.alias].dataOffset;
+        }
+    } else {
+        // GEMCORE1 stores data inline: no aliases
+        for (auto& entry : entries) {
+            entry.alias = -1;
+            std::vector<uint8_t> fields;
+            putU32(fields, (uint32_t)entry.path.size());
+            fields.insert(fields.end(), entry.path.begin(), entry.path.end());
+            putU64(fields, entry.rawSize);
+            inlineHeaders.emplace_back(offset, std::move(fields));
+            offset += inlineHeaders.back().second.size();
+            entry.dataOffset = offset;
+            offset += entry.rawSize;
+        }
+        aliases = 0;
+        savedSize = 0;
+    }
+    const uint64_t totalSize = offset;
+
+    // PHASE 6: Parallel streaming write into a temp file (or the container itself when
+    // updating in place), then rename
+    int oldFd = -1;
+    if (manifest.valid) {
+        oldFd = open(opts.output.c_str(), inPlace ? O_RDWR | O_CLOEXEC : O_RDONLY | O_CLOEXEC);
+        if (oldFd < 0) {
+            std::cerr << " Failed to open " << opts.output << ": " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+    }
+
+    std::string manifestPath = opts.output + ".manifest";
+    std::string tmpPath = opts.output + ".tmp";
+    int outFd;
+    if (inPlace) {
+        // An interrupted update must not leave a manifest that claims otherwise
+        unlink(manifestPath.c_str());
+        outFd = oldFd;
+    } else {
+        outFd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+    if (outFd < 0 || ftruncate(outFd, (off_t)totalSize) != 0) {
+        std::cerr << " Failed to create " << tmpPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    const Keystream keystream(key);
+    ok = parallelFor(entries.size(), jobs, [&](size_t i, std::vector<uint8_t>& chunk) {
+        if (entries[i].alias >= 0) return true;
+        if (!writeEntry(outFd, entries[i], keystream, chunk, oldFd)) {
+            std::cerr << " Failed to pack " << entries[i].source << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    // PHASE 7: Header + TOC last (they carry the hashes computed while writing);
+    // an in-place update only becomes visible once its data is there
+    std::vector<uint8_t> toc;
+    for (auto& entry : entries) {
+        if (entry.alias >= 0) entry.storedHash = entries[(size_t)entry.alias].storedHash;
+        if (opts.format < 2) continue;
+
+        putU32(toc, (uint32_t)entry.path.size());
+        toc.insert(toc.end(), entry.path.begin(), entry.path.end());
+        toc.push_back(entry.codec);
+        putU64(toc, entry.dataOffset);
+        putU64(toc, entry.storedSize());
+        putU64(toc, entry.rawSize);
+        if (opts.format == 3) putU64(toc, entry.storedHash);
+    }
+
+    const char* magic = opts.format == 3 ? MAGIC_V3 : opts.format == 2 ? MAGIC_V2 : MAGIC_V1;
+    std::vector<uint8_t> header(magic, magic + MAGIC_SIZE);
+    header.insert(header.end(), key, key + KEY_SIZE);
+    putU32(header, (uint32_t)entries.size());
+    if (opts.format == 3) putU64(header, XXH64::hash(toc.data(), toc.size()));
+    header.insert(header.end(), toc.begin(), toc.end());
+    if (opts.format >= 2) header.resize(headerSize + tocCapacity, 0);
+
+    ok = ok && writeAll(outFd, header.data(), header.size(), 0);
+    for (const auto& h : inlineHeaders) {
+        ok = ok && writeAll(outFd, h.second.data(), h.second.size(), h.first);
+    }
+
+    if (oldFd >= 0 && oldFd != outFd) close(oldFd);
+    ok = close(outFd) == 0 && ok;
+    if (!ok || (!inPlace && rename(tmpPath.c_str(), opts.output.c_str()) != 0)) {
+        std::cerr << " Failed to write " << opts.output << std::endl;
+        if (!inPlace) unlink(tmpPath.c_str());
+        return 1;
+    }
+
+    if (opts.incremental) {
+        if (!writeManifest(opts.output, key, opts.format, opts.compress, tocCapacity, totalSize, entries)) {
+            std::cerr << "  Failed to write " << manifestPath << " (next run repacks everything)" << std::endl;
+        }
+    } else {
+        unlink(manifestPath.c_str());  // Stale after a full, re-keyed pack
+    }
+
+    // Summary
+    uint64_t rawTotal = 0;
+    size_t compressed = 0;
+    for (const auto& entry : entries) {
+        rawTotal += entry.rawSize;
+        if (entry.codec != CODEC_RAW) compressed++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << " Packed " << entries.size() << " assets (" << compressed << " compressed) into "
+              << opts.output << " (GEMCORE" << opts.format << ")" << std::endl;
+    if (aliases > 0) {
+        std::cout << "   " << aliases << " duplicates stored once (" << savedSize << " bytes saved)" << std::endl;
+    }
+    if (!opts.profile.empty()) {
+        std::cout << "   " << (hotRank.size() - 1) << " assets laid out in access order";
+        if (profileMissing > 0) std::cout << " (" << profileMissing << " profiled paths not in the container)";
+        std::cout << std::endl;
+    }
+    if (opts.incremental) {
+        std::cout << "   " << changed << " changed, " << (entries.size() - changed) << " reused, "
+                  << hashed.load() << " hashed - " << (inPlace ? "updated in place" : manifest.valid ? "compacted" : "full pack")
+                  << std::endl;
+    }
+    std::cout << "   " << rawTotal << " bytes -> " << totalSize << " bytes in " << seconds << "s ("
+              << (seconds > 0 ? rawTotal / seconds / (1024 * 1024) : 0) << " MB/s, " << jobs << " threads)" << std::endl;
+    return 0;
+}
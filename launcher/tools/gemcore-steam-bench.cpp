@@ -0,0 +1,582 @@
+/**
+ *  Gemcore Steam Bench - Steam integration benchmarks against the mock
+ *
+ * Runs the real SteamworksManager and JS bindings against the in-process Steam
+ * mock (steamworks/steam-api-mock.cpp), so stats write-behind, batched calls,
+ * the friends snapshot and the Steam Cloud worker can be measured and checked
+ * without a Steam client:
+ * - stats    1000 SetStatInt + StoreStats per frame; StoreStats reaching Steam
+ * - batch    one 50-call steamBatch vs. the same calls one by one
+ * - marshal  binding argument decoding / result encoding per call shape,
+ *            gemcore-bind-json.h vs. a JSON DOM (nlohmann)
+ * - friends  cold and cached friends snapshots, invalidation by persona change
+ * - cloud    async writes and reads through the Steam I/O worker
+ * - input    button press to /__gemcore/input/ long-poll reply (Steam Input poller),
+ *            init failure reported by the route and retried by ConfigureInput
+ * - leaderboard  cold, cached and concurrent page downloads, friends paging, uploads
+ *
+ * Mock latency and failure injection come from the GEMCORE_STEAM_MOCK_*
+ * variables (see steam-api-mock.h), e.g.
+ *   GEMCORE_STEAM_MOCK_LATENCY_US=20 GEMCORE_STEAM_MOCK_ASYNC_MS=30 \
+ *   GEMCORE_STEAM_MOCK_FAIL=FileWriteAsync:0.1 gemcore-steam-bench cloud
+ *
+ * Exits non-zero if a scenario's result is wrong (lost writes, stale
+ * snapshots, ...), so CI can run it as a smoke test.
+ *
+ * Usage: gemcore-steam-bench [all|stats|batch|marshal|friends|cloud|input|leaderboard]...
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <filesystem>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <nlohmann/json.hpp>
+
+#include "gemcore-steamworks-bindings.h"
+#include "steam-api-mock.h"
+
+using gemcore::steamworks::SteamworksManager;
+using nlohmann::json;
+namespace mock = gemcore::steammock;
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+// Heap allocations made by this process (the marshal scenario counts them per call)
+static std::atomic<uint64_t> allocations{0};
+
+// Out of line, so GCC does not pair the free() with operator new (-Wmismatched-new-delete)
+__attribute__((noinline)) static void release(void* p) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    release(p);
+}
+
+namespace {
+
+double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void report(const char* scenario, const std::string& metric, double value, const char* unit) {
+    std::cout << std::left << std::setw(12) << scenario << std::setw(34) << metric
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << value
+              << " " << unit << std::endl;
+}
+
+bool check(bool ok, const char* scenario, const std::string& what) {
+    if (!ok) std::cerr << " " << scenario << ": " << what << std::endl;
+    return ok;
+}
+
+/**
+ * Wait until `count` async completions have arrived
+ */
+class Completions {
+public:
+    void add(bool ok) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        (ok ? succeeded : failed)++;
+        cv_.notify_all();
+    }
+
+    bool wait(int count, std::chrono::seconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&] { return succeeded + failed >= count; });
+    }
+
+    int succeeded = 0;
+    int failed = 0;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+bool benchStats() {
+    const uint32_t delayMs = 50;
+    SteamworksManager::SetStoreStatsDelay(delayMs);
+    mock::resetCallCounts();
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < 1000; frame++) {
+        SteamworksManager::SetStatInt("frames", frame + 1);
+        SteamworksManager::StoreStats();
+    }
+    double us = elapsedUs(start);
+    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs * 3));
+
+    report("stats", "1000x SetStatInt+StoreStats", us, "us");
+    report("stats", "StoreStats reaching Steam", static_cast<double>(mock::callCount("StoreStats")), "calls");
+    report("stats", "SetStat reaching Steam", static_cast<double>(mock::callCount("SetStat")), "calls");
+
+    int32_t value = 0;
+    bool ok = check(SteamworksManager::GetStatInt("frames", value) && value == 1000, "stats", "mirror lost the last value");
+    ok &= check(mock::callCount("StoreStats") <= 2, "stats", "StoreStats was not coalesced");
+    return ok;
+}
+
+bool benchBatch() {
+    using gemcore::steamworks::detail::findSteamOp;
+    using gemcore::steamworks::detail::runSteamOp;
+    using gemcore::steamworks::detail::runSteamBatch;
+
+    // A typical menu screen: identity, 40 achievements, a few stats and flags
+    json calls = json::array();
+    calls.push_back({"steamGetPersonaName", json::array()});
+    calls.push_back({"steamGetAppID", json::array()});
+    for (int i = 0; i < 40; i++) {
+        calls.push_back({"steamGetAchievement", {"ACH_" + std::to_string(i)}});
+    }
+    for (int i = 0; i < 6; i++) {
+        calls.push_back({"steamGetStatInt", {"stat_" + std::to_string(i)}});
+    }
+    calls.push_back({"steamIsOverlayEnabled", json::array()});
+    calls.push_back({"steamGetCurrentGameLanguage", json::array()});
+
+    // webview hands every bound function its arguments as one JSON array
+    json batchArgs = json::array();
+    batchArgs.push_back(calls);
+    std::string request = batchArgs.dump();
+    std::vector<std::pair<const gemcore::steamworks::detail::SteamOp*, std::string>> single;
+    for (const auto& call : calls) {
+        single.emplace_back(findSteamOp(call[0].get<std::string>()), call[1].dump());
+    }
+    const int rounds = 200;
+
+    auto start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (const auto& call : single) {
+            std::string response = runSteamOp(*call.first, call.second);
+        }
+    }
+    double sequentialUs = elapsedUs(start) / rounds;
+
+    std::string response;
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        response = runSteamBatch(request);
+    }
+    double batchUs = elapsedUs(start) / rounds;
+
+    report("batch", "50 calls one by one (native)", sequentialUs, "us");
+    report("batch", "50 calls as one steamBatch", batchUs, "us");
+
+    json results = json::parse(response, nullptr, false);
+    return check(results.is_array() && results.size() == calls.size(), "batch", "wrong number of results");
+}
+
+/**
+ * One call shape: a binding, its JSON arguments, and the same call the way the
+ * bindings made it before gemcore-bind-json.h (parse, get<>, json(result).dump())
+ */
+struct MarshalShape {
+    const char* label;
+    const char* op;
+    std::string request;
+    std::string (*viaDom)(const std::string& request);
+};
+
+bool benchMarshal() {
+    using gemcore::steamworks::detail::findSteamOp;
+    using gemcore::steamworks::detail::runSteamOp;
+    using gemcore::steamworks::FriendInfo;
+
+    const MarshalShape shapes[] = {
+        {"() -> string", "steamGetPersonaName", "[]", [](const std::string& req) {
+            json args = json::parse(req);
+            return json(SteamworksManager::GetPersonaName()).dump();
+        }},
+        {"(string) -> bool", "steamGetAchievement", "[\"ACH_WIN_ONE_GAME\"]", [](const std::string& req) {
+            json args = json::parse(req);
+            bool achieved = false;
+            bool success = SteamworksManager::GetAchievement(args.at(0).get<std::string>(), achieved);
+            return json(success && achieved).dump();
+        }},
+        {"(string, int) -> bool", "steamSetStatInt", "[\"stat_kills\",42]", [](const std::string& req) {
+            json args = json::parse(req);
+            return json(SteamworksManager::SetStatInt(args.at(0).get<std::string>(), args.at(1).get<int32_t>())).dump();
+        }},
+        {"(uint32) -> bool", "steamIsDlcInstalled", "[1234]", [](const std::string& req) {
+            json args = json::parse(req);
+            return json(SteamworksManager::IsDlcInstalled(args.at(0).get<uint32_t>())).dump();
+        }},
+        {"() -> friends list", "steamGetFriends", "[]", [](const std::string& req) {
+            json args = json::parse(req);
+            auto friends = SteamworksManager::GetFriendsSnapshot();
+            json list = json::array();
+            for (const FriendInfo& f : *friends) {
+                list.push_back(json::array({std::to_string(f.steamId), f.name, f.personaState, f.gameAppId}));
+            }
+            return list.dump();
+        }},
+    };
+    const int rounds = 100000;
+
+    bool ok = true;
+    for (const MarshalShape& shape : shapes) {
+        const auto* op = findSteamOp(shape.op);
+        if (!check(op != nullptr, "marshal", std::string("no binding ") + shape.op)) return false;
+
+        std::string dom = shape.viaDom(shape.request);
+        std::string fast = runSteamOp(*op, shape.request);
+        ok &= check(json::parse(dom) == json::parse(fast), "marshal", std::string(shape.op) + " answers differently");
+
+        uint64_t before = allocations.load();
+        auto start = Clock::now();
+        for (int i = 0; i < rounds; i++) dom = shape.viaDom(shape.request);
+        double domNs = elapsedUs(start) * 1000.0 / rounds;
+        double domAllocs = static_cast<double>(allocations.load() - before) / rounds;
+
+        before = allocations.load();
+        start = Clock::now();
+        for (int i = 0; i < rounds; i++) fast = runSteamOp(*op, shape.request);
+        double fastNs = elapsedUs(start) * 1000.0 / rounds;
+        double fastAllocs = static_cast<double>(allocations.load() - before) / rounds;
+
+        report("marshal", std::string(shape.label) + ", DOM", domNs, "ns");
+        report("marshal", std::string(shape.label) + ", fast path", fastNs, "ns");
+        report("marshal", std::string(shape.label) + ", DOM", domAllocs, "allocs");
+        report("marshal", std::string(shape.label) + ", fast path", fastAllocs, "allocs");
+    }
+
+    // Escapes, surrogate pairs and invalid UTF-8 come out as a JSON DOM has them
+    std::string tricky = json::array({"tab\t \"quoted\" \\ caf\u00e9 \U0001F600 \x01", 2147483647, -7, 3.0}).dump();
+    gemcore::bindjson::ArgReader in(tricky);
+    std::string text;
+    int32_t big = 0, negative = 0, truncated = 0;
+    ok &= check(in.read(text) && in.read(big) && in.read(negative) && in.read(truncated) && in.atEnd(),
+                "marshal", "could not read the argument round trip");
+    std::string encoded;
+    gemcore::bindjson::Writer out(encoded);
+    out.beginArray();
+    out.value(text);
+    out.value(big);
+    out.value(negative);
+    out.value(truncated);
+    out.value(std::string_view("bad \xC3\x28 utf-8"));
+    out.endArray();
+    json expected = json::parse(tricky);
+    expected[3] = 3;
+    expected.push_back("bad \xEF\xBF\xBD( utf-8");
+    ok &= check(json::parse(encoded, nullptr, false) == expected, "marshal", "round trip changed the values: " + encoded);
+    return ok;
+}
+
+bool benchFriends() {
+    mock::Settings settings = mock::settings();
+    mock::resetCallCounts();
+
+    auto start = Clock::now();
+    auto snapshot = SteamworksManager::GetFriendsSnapshot();
+    double coldUs = elapsedUs(start);
+    uint64_t coldCalls = mock::callCount("GetFriendPersonaName");
+
+    start = Clock::now();
+    const int rounds = 1000;
+    for (int i = 0; i < rounds; i++) {
+        snapshot = SteamworksManager::GetFriendsSnapshot();
+    }
+    double warmUs = elapsedUs(start) / rounds;
+
+    report("friends", std::to_string(settings.friendCount) + " friends, cold snapshot", coldUs, "us");
+    report("friends", "cached snapshot", warmUs, "us");
+    report("friends", "name lookups for 1001 snapshots", static_cast<double>(mock::callCount("GetFriendPersonaName")), "calls");
+
+    bool ok = check(snapshot->size() == settings.friendCount, "friends", "snapshot size differs from the mock");
+    ok &= check(coldCalls == mock::callCount("GetFriendPersonaName"), "friends", "cached snapshot went to Steam");
+    if (settings.friendCount == 0) return ok;
+
+    // A persona change must invalidate the snapshot once its callback is run
+    mock::setFriend(0, 1 /* k_EPersonaStateOnline */, 4000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(settings.asyncLatencyMs));
+    SteamworksManager::RunCallbacks();
+    snapshot = SteamworksManager::GetFriendsSnapshot();
+    ok &= check(!snapshot->empty() && snapshot->front().gameAppId == 4000, "friends", "snapshot not refreshed after a persona change");
+    return ok;
+}
+
+bool benchCloud() {
+    const int files = 64;
+    std::vector<uint8_t> data(64 * 1024);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 31);
+
+    SteamworksManager::StartCallbackPump();
+
+    Completions writes;
+    auto start = Clock::now();
+    for (int i = 0; i < files; i++) {
+        SteamworksManager::FileWriteAsync("bench/save-" + std::to_string(i) + ".dat", data,
+                                          [&writes](bool ok) { writes.add(ok); });
+    }
+    bool ok = check(writes.wait(files, std::chrono::seconds(30)), "cloud", "writes timed out");
+    double writeUs = elapsedUs(start);
+
+    Completions reads;
+    std::atomic<int> intact{0};
+    start = Clock::now();
+    for (int i = 0; i < files; i++) {
+        SteamworksManager::FileReadAsync("bench/save-" + std::to_string(i) + ".dat",
+                                         [&](bool readOk, std::vector<uint8_t> bytes) {
+            if (readOk && bytes == data) intact++;
+            reads.add(readOk);
+        });
+    }
+    ok &= check(reads.wait(files, std::chrono::seconds(30)), "cloud", "reads timed out");
+    double readUs = elapsedUs(start);
+
+    SteamworksManager::StopCallbackPump();
+
+    report("cloud", std::to_string(files) + "x 64 KB FileWriteAsync", writeUs / 1000.0, "ms");
+    report("cloud", "  failed writes", writes.failed, "");
+    report("cloud", std::to_string(files) + "x 64 KB FileReadAsync", readUs / 1000.0, "ms");
+    report("cloud", "  failed reads", reads.failed, "");
+
+    // Injected failures may drop writes and reads, but what was read must be intact
+    ok &= check(intact == reads.succeeded, "cloud", "read data differs from the written data");
+    ok &= check(reads.succeeded <= writes.succeeded, "cloud", "read more files than were written");
+    return ok;
+}
+
+/**
+ * One request against the server over a socketpair, as the webview would send
+ * it; the reply is read by waitInputReply()
+ */
+int sendInputPoll(gemcore::http::HTTPServer& server, uint32_t sequence) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return -1;
+    std::string request = "GET /__gemcore/input/" + std::to_string(sequence) + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    if (write(fds[0], request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    server.handleRequest(fds[1]);  // Parks the request or answers it, then owns fds[1]
+    return fds[0];
+}
+
+// Body of the reply, empty unless it is a 200; `status` gets the status code
+std::vector<uint8_t> waitInputReply(int fd, int* status = nullptr) {
+    std::string reply;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) reply.append(buf, n);
+    close(fd);
+    if (status) *status = reply.size() > 12 ? std::atoi(reply.c_str() + 9) : 0;
+    size_t body = reply.find("\r\n\r\n");
+    if (reply.compare(0, 12, "HTTP/1.1 200") != 0 || body == std::string::npos) return {};
+    return std::vector<uint8_t>(reply.begin() + body + 4, reply.end());
+}
+
+uint32_t readU32(const std::vector<uint8_t>& bytes, size_t offset) {
+    return bytes[offset] | bytes[offset + 1] << 8 | bytes[offset + 2] << 16 | static_cast<uint32_t>(bytes[offset + 3]) << 24;
+}
+
+bool benchInput() {
+    using gemcore::steamworks::InputLayout;
+    const uint32_t rateHz = 250;
+    const int presses = 200;
+    
+    gemcore::http::HTTPServer server;
+    gemcore::steamworks::registerInputRoutes(server);
+    
+    // Init failure reaches the route as a 500, and configuring again restarts the poller
+    mock::setFailure("InputInit", 1.0);
+    SteamworksManager::ConfigureInput("ingame", {"jump"}, {}, rateHz);
+    int status = 0;
+    for (int attempt = 0; attempt < 100 && status != 500; attempt++) {
+        int fd = sendInputPoll(server, 0);
+        if (fd >= 0) waitInputReply(fd, &status);
+        if (status != 500) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    mock::setFailure("InputInit", 0);
+    if (!check(status == 500 && SteamworksManager::InputFailed(), "input", "init failure not reported by the input route")) {
+        return false;
+    }
+    
+    if (!check(SteamworksManager::ConfigureInput("ingame", {"jump", "fire"}, {"move"}, rateHz), "input", "ConfigureInput failed")) {
+        return false;
+    }
+    
+    // First state: answered as soon as the poller has sampled once
+    std::vector<uint8_t> state;
+    for (int attempt = 0; attempt < 100 && state.size() != InputLayout::SIZE; attempt++) {
+        int fd = sendInputPoll(server, 0);
+        state = fd < 0 ? std::vector<uint8_t>() : waitInputReply(fd);
+        if (state.size() != InputLayout::SIZE) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool ok = check(state.size() == InputLayout::SIZE, "input", "no input state from the poller");
+    
+    // Press and release "jump" at random points of the poll period; each
+    // sample is the time from the mock's button change to the reply arriving
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> pause(0, 2 * 1000000 / rateHz);
+    std::vector<double> latencies;
+    bool pressed = false;
+    for (int i = 0; ok && i < presses; i++) {
+        int fd = sendInputPoll(server, readU32(state, 0));
+        std::this_thread::sleep_for(std::chrono::microseconds(pause(random)));
+        pressed = !pressed;
+        auto start = Clock::now();
+        gemcore::steammock::setDigitalAction(0, "jump", pressed);
+        state = waitInputReply(fd);
+        latencies.push_back(elapsedUs(start));
+        
+        ok &= check(state.size() == InputLayout::SIZE, "input", "long-poll failed");
+        ok &= check(!ok || ((readU32(state, InputLayout::HEADER_SIZE) & 1) != 0) == pressed, "input", "reply does not show the press");
+    }
+    SteamworksManager::StopInput();
+    gemcore::steamworks::detail::wakeInputWaiters();
+    SteamworksManager::SetInputChangedHandler(nullptr);
+    if (!ok) return false;
+    
+    std::sort(latencies.begin(), latencies.end());
+    report("input", std::to_string(rateHz) + " Hz poller, press -> reply p50", latencies[latencies.size() / 2] / 1000.0, "ms");
+    report("input", "press -> reply p99", latencies[latencies.size() * 99 / 100] / 1000.0, "ms");
+    report("input", "press -> reply max", latencies.back() / 1000.0, "ms");
+    return ok;
+}
+
+using PagePtr = std::shared_ptr<const gemcore::steamworks::LeaderboardPage>;
+
+PagePtr downloadPage(const std::string& name, gemcore::steamworks::LeaderboardRequest request, int32_t start, int32_t end) {
+    auto result = std::make_shared<std::promise<PagePtr>>();
+    SteamworksManager::DownloadLeaderboardEntries(name, request, start, end, 0, [result](PagePtr page) {
+        result->set_value(std::move(page));
+    });
+    return result->get_future().get();
+}
+
+bool benchLeaderboard() {
+    using gemcore::steamworks::LeaderboardRequest;
+    using gemcore::steamworks::LeaderboardUpload;
+    const std::string board = "bench_leaderboard";
+    mock::Settings settings = mock::settings();
+    SteamworksManager::SetLeaderboardCacheTtl(10000);
+    SteamworksManager::StartCallbackPump();
+    mock::resetCallCounts();
+    
+    // A scoreboard screen: top 10, twice (re-render), then pages 2 and 3
+    auto start = Clock::now();
+    PagePtr top = downloadPage(board, LeaderboardRequest::Global, 1, 10);
+    double coldUs = elapsedUs(start);
+    
+    const int rounds = 1000;
+    start = Clock::now();
+    for (int i = 0; i < rounds; i++) downloadPage(board, LeaderboardRequest::Global, 1, 10);
+    double cachedUs = elapsedUs(start) / rounds;
+    uint64_t downloads = mock::callCount("DownloadLeaderboardEntries");
+    
+    // Twenty widgets asking for the same uncached page at once
+    std::vector<std::future<PagePtr>> concurrent;
+    for (int i = 0; i < 20; i++) {
+        concurrent.push_back(std::async(std::launch::async, [&] { return downloadPage(board, LeaderboardRequest::Global, 11, 20); }));
+    }
+    bool ok = true;
+    for (auto& page : concurrent) ok &= check(page.get()->entries.size() == 10, "leaderboard", "concurrent page incomplete");
+    uint64_t concurrentDownloads = mock::callCount("DownloadLeaderboardEntries") - downloads;
+    
+    // Friends list: one download, paged natively
+    uint64_t beforeFriends = mock::callCount("DownloadLeaderboardEntries");
+    PagePtr friends1 = downloadPage(board, LeaderboardRequest::Friends, 1, 5);
+    PagePtr friends2 = downloadPage(board, LeaderboardRequest::Friends, 6, 10);
+    uint64_t friendsDownloads = mock::callCount("DownloadLeaderboardEntries") - beforeFriends;
+    
+    // A new best score drops the cached pages
+    auto uploaded = std::make_shared<std::promise<LeaderboardUpload>>();
+    SteamworksManager::UploadLeaderboardScore(board, 1 << 30, true, {42}, [uploaded](const LeaderboardUpload& upload) {
+        uploaded->set_value(upload);
+    });
+    LeaderboardUpload upload = uploaded->get_future().get();
+    PagePtr after = downloadPage(board, LeaderboardRequest::Global, 1, 10);
+    PagePtr around = downloadPage(board, LeaderboardRequest::AroundUser, -2, 2);
+    PagePtr hundred = downloadPage(board, LeaderboardRequest::Global, 1, 100);
+    SteamworksManager::StopCallbackPump();
+    
+    auto encodeStart = Clock::now();
+    std::string encoded;
+    for (int i = 0; i < rounds; i++) encoded = gemcore::steamworks::detail::leaderboardPageJson(*hundred, false);
+    double encodeUs = elapsedUs(encodeStart) / rounds;
+    
+    report("leaderboard", "cold top-10 page (find + download)", coldUs / 1000.0, "ms");
+    report("leaderboard", "cached top-10 page", cachedUs, "us");
+    report("leaderboard", "downloads for 1001 top-10 pages", static_cast<double>(downloads), "calls");
+    report("leaderboard", "downloads for 20 concurrent pages", static_cast<double>(concurrentDownloads), "calls");
+    report("leaderboard", "downloads for 2 friends pages", static_cast<double>(friendsDownloads), "calls");
+    report("leaderboard", "100-entry page to JSON", encodeUs, "us");
+    
+    ok &= check(top->ok && top->entries.size() == 10 && top->totalEntries == static_cast<int32_t>(settings.leaderboardEntries),
+                "leaderboard", "wrong top page");
+    ok &= check(downloads == 1, "leaderboard", "cached page went to Steam");
+    ok &= check(concurrentDownloads == 1, "leaderboard", "concurrent requests were not shared");
+    ok &= check(friendsDownloads == 1 && friends1->ok && friends2->ok, "leaderboard", "friends pages were downloaded twice");
+    ok &= check(upload.ok && upload.changed && upload.globalRankNew == 1, "leaderboard", "upload did not take rank 1");
+    ok &= check(after->ok && !after->entries.empty() && after->entries[0].score == (1 << 30), "leaderboard", "stale page after upload");
+    ok &= check(around->ok && around->entries.size() == 3, "leaderboard", "around-user page wrong");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> scenarios;
+    for (int i = 1; i < argc; i++) scenarios.push_back(argv[i]);
+    if (scenarios.empty() || scenarios[0] == "all") scenarios = {"stats", "batch", "marshal", "friends", "cloud", "input", "leaderboard"};
+
+    // Keep the mock cloud out of the working directory unless asked for
+    fs::path cloudDir = fs::temp_directory_path() / ("gemcore-steam-bench-" + std::to_string(getpid()));
+    bool ownCloudDir = !getenv("GEMCORE_STEAM_MOCK_CLOUD_DIR");
+    if (ownCloudDir) setenv("GEMCORE_STEAM_MOCK_CLOUD_DIR", cloudDir.c_str(), 1);
+
+    if (!SteamworksManager::Init()) {
+        std::cerr << " Steam mock failed to initialize" << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    for (const auto& scenario : scenarios) {
+        if (scenario == "stats") ok &= benchStats();
+        else if (scenario == "batch") ok &= benchBatch();
+        else if (scenario == "marshal") ok &= benchMarshal();
+        else if (scenario == "friends") ok &= benchFriends();
+        else if (scenario == "cloud") ok &= benchCloud();
+        else if (scenario == "input") ok &= benchInput();
+        else if (scenario == "leaderboard") ok &= benchLeaderboard();
+        else {
+            std::cerr << "Usage: gemcore-steam-bench [all|stats|batch|marshal|friends|cloud|input|leaderboard]..." << std::endl;
+            ok = false;
+        }
+    }
+
+    SteamworksManager::Shutdown();
+    if (ownCloudDir) {
+        std::error_code ec;
+        fs::remove_all(cloudDir, ec);
+    }
+    return ok ? 0 : 1;
+}
@@ -1,33 +1,51 @@
 /**
  *  Gemcore Universal Launcher (Linux) - WITH EMBEDDED RESOURCES
- * Extracts embedded binaries/assets to /tmp and launches correct architecture
+ * Loads the embedded launcher binary into a memfd and starts it with fexecve().
+ * Assets are NOT extracted: the child maps them in place from this executable
+ * through an inherited file descriptor (GEMCORE_ASSETS_FD/OFFSET/SIZE).
+ * Files that must exist on disk (libsteam_api.so, or the binary when memfd is
+ * unavailable) go to a persistent content-addressed cache that is reused
+ * across launches: $XDG_CACHE_HOME/gemcore/<content-hash>/
  */
 
 #include <iostream>
 #include <string>
-#include <fstream>
 #include <cstdint>
 #include <cstring>
+#include <chrono>
+#include <vector>
+#include <algorithm>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/utsname.h>
 #include <sys/wait.h>
+#include <sys/syscall.h>
+#include <sys/sendfile.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <dirent.h>
 #include <limits.h>
 #include <dlfcn.h>
 #include <errno.h>
-#include <cstring>
+#include "gemcore-embedded-footer.h"
+#include "gemcore-config-record.h"
 
-struct EmbeddedData {
-    uint64_t x64Offset;
-    uint64_t x64Size;
-    uint64_t assetsOffset;
-    uint64_t assetsSize;
-    uint64_t configOffset;
-    uint64_t configSize;
-    uint64_t steamSoOffset;
-    uint64_t steamSoSize;
-};
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+extern char** environ;
+
+using gemcore::embedded::Footer;
+using gemcore::embedded::Section;
+
+// Bytes written to disk during this launch (reported in debug builds)
+static uint64_t g_bytesWritten = 0;
 
 std::string getExecutablePath() {
     char path[PATH_MAX];
@@ -39,265 +57,537 @@ std::string getExecutablePath() {
     return "";
 }
 
-std::string getTempDir() {
-    // Create unique dir for this app
-    std::string uniqueDir = std::string("/tmp/gemcore_") + std::to_string(getpid());
-    mkdir(uniqueDir.c_str(), 0755);
-    return uniqueDir;
+/**
+ * memfd_create() via syscall (works with older glibc and musl)
+ */
+int createMemfd(const char* name, unsigned int flags) {
+#ifdef SYS_memfd_create
+    return (int)syscall(SYS_memfd_create, name, flags);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
 }
 
-std::string getCPUArchitecture() {
-    struct utsname buffer;
-    if (uname(&buffer) == 0) {
-        std::string machine(buffer.machine);
+/**
+ * Copy a section of the executable into dstFd inside the kernel
+ * (copy_file_range, falling back to sendfile) - no userspace buffers.
+ */
+bool copyRange(int srcFd, uint64_t offset, uint64_t size, int dstFd) {
+    off_t inOff = (off_t)offset;
+    off_t outOff = 0;
+    uint64_t remaining = size;
+    bool useSendfile = false;
+    
+    while (remaining > 0) {
+        ssize_t n = -1;
+#ifdef SYS_copy_file_range
+        if (!useSendfile) {
+            n = syscall(SYS_copy_file_range, srcFd, &inOff, dstFd, &outOff, (size_t)remaining, 0u);
+            if (n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                // Cross-filesystem copies are not supported on every kernel
+                useSendfile = true;
+                continue;
+            }
+        } else
+#endif
+        {
+            // sendfile() writes at the current file position of dstFd
+            if (lseek(dstFd, outOff, SEEK_SET) < 0) return false;
+            n = sendfile(dstFd, srcFd, &inOff, (size_t)remaining);
+            if (n > 0) outOff += n;
+        }
         
-        if (machine == "x86_64" || machine == "amd64") {
-            return "x64";
-        } else if (machine == "aarch64" || machine == "arm64") {
-            return "arm64";
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
         }
+        remaining -= (uint64_t)n;
     }
-    return "x64"; // Default to x64
+    return true;
 }
 
-bool readEmbeddedData(const std::string& exePath, EmbeddedData& data) {
-    std::ifstream file(exePath, std::ios::binary);
-    if (!file) return false;
+/**
+ * Load a section of the executable into a sealed memfd
+ * Returns the memfd or -1 (caller falls back to the extraction cache).
+ */
+int loadIntoMemfd(int srcFd, uint64_t offset, uint64_t size, const char* name, bool cloexec) {
+    int memFd = createMemfd(name, MFD_ALLOW_SEALING | (cloexec ? MFD_CLOEXEC : 0));
+    if (memFd < 0) return -1;
     
-    // Find magic signature "GEMCORE_EMBEDDED" from the end
-    file.seekg(-8192, std::ios::end); // Search last 8KB
-    char buffer[8192];
-    file.read(buffer, 8192);
+    if (ftruncate(memFd, (off_t)size) != 0 || !copyRange(srcFd, offset, size, memFd)) {
+        close(memFd);
+        return -1;
+    }
     
-    const char* magic = "GEMCORE_EMBEDDED";
-    size_t magicLen = 16; // Including null terminator
+#ifdef F_ADD_SEALS
+    // Content is final: seal it so nobody can modify the image we exec
+    fcntl(memFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
     
-    // Find magic
-    bool found = false;
-    int64_t magicPos = -1;
-    for (int i = 0; i < 8192 - 16; i++) {
-        if (memcmp(buffer + i, magic, magicLen) == 0) {
-            found = true;
-            magicPos = file.tellg();
-            magicPos = magicPos - 8192 + i + magicLen;
-            break;
-        }
+    return memFd;
+}
+
+// 
+//  Persistent extraction cache
+// 
+
+// Default size bound for $XDG_CACHE_HOME/gemcore (override: GEMCORE_CACHE_MAX_MB)
+static const uint64_t DEFAULT_CACHE_LIMIT = 256ULL * 1024 * 1024;
+
+/**
+ * Cache root: $XDG_CACHE_HOME/gemcore, ~/.cache/gemcore or /tmp/gemcore-cache-<uid>
+ */
+std::string getCacheRoot() {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (xdg && *xdg) return std::string(xdg) + "/gemcore";
+    if (home && *home) return std::string(home) + "/.cache/gemcore";
+    return "/tmp/gemcore-cache-" + std::to_string(getuid());
+}
+
+/**
+ * mkdir -p
+ */
+bool makeDirs(const std::string& path) {
+    size_t pos = 0;
+    while ((pos = path.find('/', pos + 1)) != std::string::npos) {
+        mkdir(path.substr(0, pos).c_str(), 0700);
     }
+    return mkdir(path.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+/**
+ * A directory only this user can have filled: not a symlink, owned by us,
+ * mode 0700. makeDirs() accepts existing directories, and under /tmp another
+ * user could have created the tree first and planted files in it.
+ */
+bool isPrivateDir(const std::string& path) {
+    struct stat st;
+    return lstat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode) &&
+           st.st_uid == getuid() && (st.st_mode & 0777) == 0700;
+}
+
+std::string toHex(uint64_t value) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)value);
+    return hex;
+}
+
+/**
+ * A cache entry in use: holds a shared flock on <entry>/.lock until the
+ * launcher exits, so garbage collection in other instances skips it.
+ */
+struct CacheEntry {
+    std::string dir;
+    std::string path;
+    int lockFd = -1;
+    bool hit = false;
+};
+
+/**
+ * <entry>/.<name>.complete, created only after the file's data has been
+ * fsync()ed and renamed into place
+ */
+std::string completionMarker(const CacheEntry& entry, const char* name) {
+    return entry.dir + "/." + name + ".complete";
+}
+
+bool isComplete(const CacheEntry& entry, const char* name, uint64_t size) {
+    struct stat st;
+    return stat(completionMarker(entry, name).c_str(), &st) == 0 &&
+           stat(entry.path.c_str(), &st) == 0 && (uint64_t)st.st_size == size;
+}
+
+/**
+ * Persist a populated entry: data first, then the rename, then the marker
+ * A crash at any point leaves no marker, so the next launch repopulates
+ * instead of exec'ing a torn file of the right size.
+ */
+bool commitEntry(const CacheEntry& entry, const char* name, int tmpFd, const std::string& tmpPath) {
+    if (fsync(tmpFd) != 0 || rename(tmpPath.c_str(), entry.path.c_str()) != 0) return false;
     
-    if (!found) return false;
-    
-    // Read header
-    file.seekg(magicPos, std::ios::beg);
-    file.read((char*)&data.x64Offset, 8);
-    file.read((char*)&data.x64Size, 8);
-    file.read((char*)&data.assetsOffset, 8);
-    file.read((char*)&data.assetsSize, 8);
-    file.read((char*)&data.configOffset, 8);
-    file.read((char*)&data.configSize, 8);
-    file.read((char*)&data.steamSoOffset, 8);
-    file.read((char*)&data.steamSoSize, 8);
+    int markerFd = open(completionMarker(entry, name).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (markerFd < 0) return false;
+    bool ok = fsync(markerFd) == 0;
+    close(markerFd);
     
-    return true;
+    // Make the rename and the marker durable as well
+    int dirFd = open(entry.dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+    return ok;
 }
 
-bool extractFile(const std::string& exePath, uint64_t offset, uint64_t size, const std::string& outPath) {
-    std::ifstream in(exePath, std::ios::binary);
-    if (!in) return false;
+/**
+ * Make a section of the executable available as a real file in the cache
+ * Populated atomically (temp file + fsync + rename, then a completion marker)
+ * under an exclusive lock; a warm launch only stats the file and its marker.
+ */
+bool acquireCached(int exeFd, const Section& section, const char* name,
+                   mode_t mode, CacheEntry& entry) {
+    const uint64_t offset = section.offset;
+    const uint64_t size = section.size;
     
-    std::ofstream out(outPath, std::ios::binary);
-    if (!out) return false;
+    // The packer stores a content hash per section in the footer
+    std::string root = getCacheRoot();
+    entry.dir = root + "/" + toHex(section.hash);
+    entry.path = entry.dir + "/" + name;
+    
+    // Retry once if garbage collection removed the entry under us
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!makeDirs(entry.dir)) return false;
+        if (!isPrivateDir(root) || !isPrivateDir(entry.dir)) {
+            std::cerr << "  Extraction cache " << root << " is not a private directory, not using it" << std::endl;
+            return false;
+        }
+        
+        std::string lockPath = entry.dir + "/.lock";
+        entry.lockFd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (entry.lockFd < 0) return false;
+        
+        flock(entry.lockFd, LOCK_SH);
+        struct stat lockSt;
+        if (fstat(entry.lockFd, &lockSt) != 0 || lockSt.st_nlink == 0) {
+            close(entry.lockFd);
+            entry.lockFd = -1;
+            continue;
+        }
+        
+        entry.hit = isComplete(entry, name, size);
+        if (!entry.hit) {
+            // Populate: exclusive lock, re-check (another instance may have won)
+            flock(entry.lockFd, LOCK_EX);
+            if (!isComplete(entry, name, size)) {
+                // A file without marker may be torn: drop the marker of the old one first
+                unlink(completionMarker(entry, name).c_str());
+                std::string tmpPath = entry.dir + "/." + name + ".tmp." + std::to_string(getpid());
+                int outFd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+                bool ok = outFd >= 0 && copyRange(exeFd, offset, size, outFd) &&
+                          commitEntry(entry, name, outFd, tmpPath);
+                if (outFd >= 0) close(outFd);
+                
+                if (!ok) {
+                    unlink(tmpPath.c_str());
+                    close(entry.lockFd);
+                    entry.lockFd = -1;
+                    return false;
+                }
+                g_bytesWritten += size;
+            }
+            // Downgrade: keep the entry pinned while the game runs
+            flock(entry.lockFd, LOCK_SH);
+        }
+        
+        // LRU timestamp for garbage collection
+        futimens(entry.lockFd, nullptr);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Size-bounded garbage collection, least recently used entries first
+ * Entries pinned by a running instance (shared flock) are never removed.
+ */
+void collectCacheGarbage() {
+    uint64_t limit = DEFAULT_CACHE_LIMIT;
+    if (const char* maxMb = getenv("GEMCORE_CACHE_MAX_MB")) {
+        limit = strtoull(maxMb, nullptr, 10) * 1024 * 1024;
+    }
     
-    in.seekg(offset, std::ios::beg);
+    std::string root = getCacheRoot();
+    DIR* dir = opendir(root.c_str());
+    if (!dir) return;
     
-    const size_t BUFFER_SIZE = 1024 * 1024; // 1MB buffer
-    char* buffer = new char[BUFFER_SIZE];
+    struct Entry { std::string dir; uint64_t bytes; time_t lastUse; };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
     
-    uint64_t remaining = size;
-    while (remaining > 0) {
-        size_t toRead = (remaining < BUFFER_SIZE) ? (size_t)remaining : BUFFER_SIZE;
-        in.read(buffer, toRead);
-        out.write(buffer, toRead);
-        remaining -= toRead;
+    while (struct dirent* de = readdir(dir)) {
+        if (de->d_name[0] == '.') continue;
+        Entry e{ root + "/" + de->d_name, 0, 0 };
+        
+        DIR* sub = opendir(e.dir.c_str());
+        if (!sub) continue;
+        while (struct dirent* f = readdir(sub)) {
+            if (strcmp(f->d_name, ".") == 0 || strcmp(f->d_name, "..") == 0) continue;
+            struct stat st;
+            std::string fp = e.dir + "/" + f->d_name;
+            if (stat(fp.c_str(), &st) != 0) continue;
+            e.bytes += (uint64_t)st.st_size;
+            if (strcmp(f->d_name, ".lock") == 0) e.lastUse = st.st_mtime;
+        }
+        closedir(sub);
+        
+        total += e.bytes;
+        entries.push_back(std::move(e));
     }
+    closedir(dir);
     
-    delete[] buffer;
+    if (total <= limit) return;
     
-    // Make executable
-    chmod(outPath.c_str(), 0755);
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
     
+    for (const auto& e : entries) {
+        if (total <= limit) break;
+        
+        std::string lockPath = e.dir + "/.lock";
+        int lockFd = open(lockPath.c_str(), O_RDWR | O_CLOEXEC);
+        if (lockFd < 0) continue;
+        if (flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+            close(lockFd);  // In use by a running instance
+            continue;
+        }
+        
+        DIR* sub = opendir(e.dir.c_str());
+        if (sub) {
+            while (struct dirent* f = readdir(sub)) {
+                if (strcmp(f->d_name, ".") == 0 || strcmp(f->d_name, "..") == 0) continue;
+                unlink((e.dir + "/" + f->d_name).c_str());
+            }
+            closedir(sub);
+        }
+        rmdir(e.dir.c_str());
+        close(lockFd);
+        
+        total -= e.bytes;
+        #ifndef NDEBUG
+        std::cout << " Cache GC: removed " << e.dir << " (" << e.bytes << " bytes)" << std::endl;
+        #endif
+    }
+}
+
+std::string getCPUArchitecture() {
+    struct utsname buffer;
+    if (uname(&buffer) == 0) {
+        std::string machine(buffer.machine);
+        
+        if (machine == "x86_64" || machine == "amd64") {
+            return "x64";
+        } else if (machine == "aarch64" || machine == "arm64") {
+            return "arm64";
+        }
+    }
+    return "x64"; // Default to x64
+}
+
+/**
+ * Read the fixed-size footer with a single pread at the end of the file
+ */
+bool readFooter(int fd, Footer& footer) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(Footer)) return false;
+    
+    ssize_t n = pread(fd, &footer, sizeof(Footer), st.st_size - (off_t)sizeof(Footer));
+    if (n != (ssize_t)sizeof(Footer)) return false;
+    
+    return gemcore::embedded::validateFooter(footer, (uint64_t)st.st_size);
+}
+
+/**
+ * Read a small embedded section (e.g. the config) into memory
+ */
+bool readSection(int fd, uint64_t offset, uint64_t size, std::string& out) {
+    out.resize(size);
+    uint64_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(fd, &out[done], size - done, offset + done);
+        if (n <= 0) return false;
+        done += n;
+    }
     return true;
 }
 
+/**
+ * Steam App ID from the embedded launcher config record (empty if none)
+ */
+std::string findSteamAppId(const std::string& configContent) {
+    gemcore::config::Record record;
+    if (!record.parse(reinterpret_cast<const unsigned char*>(configContent.data()), configContent.size())) {
+        return "";
+    }
+    for (gemcore::config::Field field; record.next(field);) {
+        if (field.id == gemcore::config::STEAM_APP_ID && field.u32() != 0) return std::to_string(field.u32());
+    }
+    return "";
+}
+
 int main(int argc, char* argv[]) {
+    auto launchStart = std::chrono::steady_clock::now();
     std::string exePath = getExecutablePath();
     std::string arch = getCPUArchitecture();
-    std::string tempDir = getTempDir();
     
     #ifndef NDEBUG
     std::cout << " Gemcore Universal Launcher" << std::endl;
     std::cout << "   Executable: " << exePath << std::endl;
     std::cout << "   Architecture: " << arch << std::endl;
-    std::cout << "   Temp Dir: " << tempDir << std::endl;
     #endif
     
-    // Read embedded data
-    EmbeddedData data;
-    if (!readEmbeddedData(exePath, data)) {
+    // One descriptor for the footer and every section. Opened WITHOUT
+    // O_CLOEXEC so it survives exec (the child maps the assets from it)
+    int exeFd = open(exePath.c_str(), O_RDONLY);
+    if (exeFd < 0) {
+        std::cerr << " Failed to open executable: " << strerror(errno) << std::endl;
+        return 1;
+    }
+    
+    Footer footer;
+    if (!readFooter(exeFd, footer)) {
         std::cerr << " Failed to read embedded data from: " << exePath << std::endl;
         std::cerr << "   Make sure this is a valid Gemcore executable!" << std::endl;
         return 1;
     }
     
+    const Section& binary = footer.sections[gemcore::embedded::SECTION_BINARY];
+    const Section& assets = footer.sections[gemcore::embedded::SECTION_ASSETS];
+    const Section& config = footer.sections[gemcore::embedded::SECTION_CONFIG];
+    const Section& steamLib = footer.sections[gemcore::embedded::SECTION_STEAM_LIB];
+    
     #ifndef NDEBUG
-    std::cout << "   Binary: " << data.x64Size << " bytes" << std::endl;
-    std::cout << "   Assets: " << data.assetsSize << " bytes" << std::endl;
-    std::cout << "   Steam Library: " << data.steamSoSize << " bytes" << std::endl;
+    std::cout << "   Binary: " << binary.size << " bytes" << std::endl;
+    std::cout << "   Assets: " << assets.size << " bytes" << std::endl;
+    std::cout << "   Steam Library: " << steamLib.size << " bytes" << std::endl;
     #endif
     
-    // Extract files
-    // Note: x64Offset/x64Size actually contains the architecture-specific binary
+    //  Load the launcher binary into a memfd (works on noexec /tmp, no disk I/O)
+    // Note: the binary section contains the architecture-specific binary
     // (could be x64 or ARM64 depending on which was packed)
-    std::string binaryPath = tempDir + "/gemcore-binary";
-    std::string assetsPath = tempDir + "/gemcore-assets";
-    std::string configPath = tempDir + "/gemcore.config.json";
+    int binaryFd = -1;
+    std::string binaryPath;
     
-    if (data.x64Size > 0) {
-        if (!extractFile(exePath, data.x64Offset, data.x64Size, binaryPath)) {
+    if (binary.size == 0) {
+        std::cerr << " No launcher binary embedded!" << std::endl;
+        return 1;
+    }
+    
+    // Cache entries stay pinned (shared lock) until the child exits
+    CacheEntry binaryEntry;
+    CacheEntry steamEntry;
+    bool cachePopulated = false;
+    
+    binaryFd = loadIntoMemfd(exeFd, binary.offset, binary.size, "gemcore-binary", true);
+    if (binaryFd < 0) {
+        // Fallback: extraction cache (old kernels / memfd blocked by seccomp)
+        if (!acquireCached(exeFd, binary, "gemcore-binary", 0755, binaryEntry)) {
             std::cerr << " Failed to extract binary!" << std::endl;
             return 1;
         }
+        binaryPath = binaryEntry.path;
+        cachePopulated |= !binaryEntry.hit;
     }
     
-    if (data.assetsSize > 0) {
-        if (!extractFile(exePath, data.assetsOffset, data.assetsSize, assetsPath)) {
-            std::cerr << " Failed to extract assets!" << std::endl;
-            return 1;
-        }
+    //  Assets stay inside this executable: hand the region to the child.
+    if (assets.size > 0) {
+        setenv("GEMCORE_ASSETS_FD", std::to_string(exeFd).c_str(), 1);
+        setenv("GEMCORE_ASSETS_OFFSET", std::to_string(assets.offset).c_str(), 1);
+        setenv("GEMCORE_ASSETS_SIZE", std::to_string(assets.size).c_str(), 1);
         #ifndef NDEBUG
-        std::cout << " Extracted assets to: " << assetsPath << std::endl;
+        std::cout << " Assets mapped in place (offset " << assets.offset << ")" << std::endl;
         #endif
     } else {
         std::cerr << "  No assets embedded in executable!" << std::endl;
         std::cerr << "   App may not work correctly without assets." << std::endl;
     }
     
-    if (data.configSize > 0) {
-        if (!extractFile(exePath, data.configOffset, data.configSize, configPath)) {
-            std::cerr << " Failed to extract config!" << std::endl;
+    std::string configContent;
+    if (config.size > 0) {
+        if (!readSection(exeFd, config.offset, config.size, configContent)) {
+            std::cerr << " Failed to read config!" << std::endl;
             return 1;
         }
     }
     
-    // Extract Steam .so if embedded
-    if (data.steamSoSize > 0) {
-        std::string steamSoPath = tempDir + "/libsteam_api.so";
-        if (!extractFile(exePath, data.steamSoOffset, data.steamSoSize, steamSoPath)) {
-            std::cerr << "  Failed to extract Steam library (Steamworks may not work)" << std::endl;
-            // Don't fail - app can run without Steam
+    //  Steam library: a real file from the extraction cache (the overlay and
+    // crash handler resolve it by path), memfd only if the cache is unusable.
+    // The child dlopen()s GEMCORE_STEAM_LIB.
+    std::string steamSoPath;
+    if (steamLib.size > 0) {
+        if (acquireCached(exeFd, steamLib, "libsteam_api.so", 0755, steamEntry)) {
+            steamSoPath = steamEntry.path;
+            cachePopulated |= !steamEntry.hit;
         } else {
-            std::cout << " Extracted Steam library to: " << steamSoPath << std::endl;
-            
-            // Set LD_LIBRARY_PATH so the launcher can find libsteam_api.so
-            std::string ldPath = tempDir;
-            const char* existingLdPath = getenv("LD_LIBRARY_PATH");
-            if (existingLdPath && strlen(existingLdPath) > 0) {
-                ldPath += ":" + std::string(existingLdPath);
+            int steamFd = loadIntoMemfd(exeFd, steamLib.offset, steamLib.size, "libsteam_api.so", false);
+            if (steamFd >= 0) {
+                steamSoPath = "/proc/self/fd/" + std::to_string(steamFd);
+            } else {
+                std::cerr << "  Failed to extract Steam library (Steamworks may not work)" << std::endl;
+                // Don't fail - app can run without Steam
             }
-            setenv("LD_LIBRARY_PATH", ldPath.c_str(), 1);
-            
-            std::cout << " Set LD_LIBRARY_PATH=" << ldPath << std::endl;
+        }
+        
+        if (!steamSoPath.empty()) {
+            setenv("GEMCORE_STEAM_LIB", steamSoPath.c_str(), 1);
+            #ifndef NDEBUG
+            std::cout << " Steam library: " << steamSoPath << std::endl;
+            #endif
             
-            // CRITICAL FIX: Create steam_appid.txt in the temp directory
-            // The launcher needs this file to initialize Steamworks
-            // We extract it from the embedded config (gemcore.config.json)
-            if (data.configSize > 0) {
-                // Try to read appId from config
-                std::ifstream configFile(configPath);
-                if (configFile.is_open()) {
-                    std::string configContent((std::istreambuf_iterator<char>(configFile)),
-                                             std::istreambuf_iterator<char>());
-                    
-                    // Simple JSON parsing - look for "appId": <number>
-                    size_t appIdPos = configContent.find("\"appId\"");
-                    if (appIdPos != std::string::npos) {
-                        size_t colonPos = configContent.find(":", appIdPos);
-                        if (colonPos != std::string::npos) {
-                            size_t numStart = colonPos + 1;
-                            // Skip whitespace
-                            while (numStart < configContent.size() && 
-                                   (configContent[numStart] == ' ' || configContent[numStart] == '\t')) {
-                                numStart++;
-                            }
-                            
-                            // Read number
-                            std::string appIdStr;
-                            while (numStart < configContent.size() && 
-                                   isdigit(configContent[numStart])) {
-                                appIdStr += configContent[numStart++];
-                            }
-                            
-                            if (!appIdStr.empty()) {
-                                // Write steam_appid.txt to temp dir
-                                std::string steamAppIdPath = tempDir + "/steam_appid.txt";
-                                std::ofstream steamAppId(steamAppIdPath);
-                                if (steamAppId.is_open()) {
-                                    steamAppId << appIdStr;
-                                    steamAppId.close();
-                                    std::cout << " Created steam_appid.txt with App ID: " << appIdStr << std::endl;
-                                }
-                            }
-                        }
-                    }
-                }
+            // Steam reads the App ID from the environment before steam_appid.txt,
+            // so nothing has to be written next to the binary.
+            // Keep the value Steam itself set when launched from the client.
+            std::string appIdStr = findSteamAppId(configContent);
+            if (!appIdStr.empty() && !getenv("SteamAppId")) {
+                setenv("SteamAppId", appIdStr.c_str(), 1);
+                setenv("SteamGameId", appIdStr.c_str(), 1);
+                #ifndef NDEBUG
+                std::cout << " SteamAppId=" << appIdStr << std::endl;
+                #endif
             }
         }
     }
     
-    // Launch the extracted binary (it's already architecture-specific)
-    // The binary was extracted to binaryPath above
-    
-    // Build arguments
+    // Build arguments (argv[0] stays the user-visible executable)
     char** args = new char*[argc + 1];
-    args[0] = const_cast<char*>(binaryPath.c_str());
+    args[0] = argv[0];
     for (int i = 1; i < argc; i++) {
         args[i] = argv[i];
     }
     args[argc] = nullptr;
     
+    #ifndef NDEBUG
+    auto launchPrep = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - launchStart);
+    std::cout << " Launch prep: " << launchPrep.count() << "us, "
+              << g_bytesWritten << " bytes written to disk ("
+              << (cachePopulated ? "cold" : "warm") << " cache)" << std::endl;
+    #endif
+    
     // Fork and exec
     pid_t pid = fork();
     if (pid == 0) {
         // Child process
         #ifndef NDEBUG
-        std::cout << " Launching " << arch << " binary: " << binaryPath << std::endl;
+        std::cout << " Launching " << arch << " binary"
+                  << (binaryFd >= 0 ? " (memfd)" : ": " + binaryPath) << std::endl;
         #endif
         
-        // CRITICAL FIX: Change working directory to temp dir
-        // This ensures steam_appid.txt and libsteam_api.so are found
-        if (chdir(tempDir.c_str()) != 0) {
-            std::cerr << "  Failed to change to temp directory: " << strerror(errno) << std::endl;
+        if (binaryFd >= 0) {
+            fexecve(binaryFd, args, environ);
+        } else {
+            execv(binaryPath.c_str(), args);
         }
         
-        execv(binaryPath.c_str(), args);
-        
         // If we get here, exec failed
-        std::cerr << " Failed to launch " << arch << " binary: " << binaryPath << std::endl;
+        std::cerr << " Failed to launch " << arch << " binary" << std::endl;
         std::cerr << "   Error: " << strerror(errno) << std::endl;
-        return 1;
+        _exit(1);
     } else if (pid > 0) {
-        // Parent process - wait for child
+        // Parent process - keep the cache bounded while the game starts up
+        // (only after a cold launch added bytes; our own entries are pinned)
+        if (cachePopulated) {
+            collectCacheGarbage();
+        }
+        
+        // Wait for child
         int status;
         waitpid(pid, &status, 0);
         
-        // Cleanup temp files
-        unlink(binaryPath.c_str());
-        unlink(assetsPath.c_str());
-        unlink(configPath.c_str());
-        
-        std::string steamSoPath = tempDir + "/libsteam_api.so";
-        unlink(steamSoPath.c_str());
-        
-        rmdir(tempDir.c_str());
+        close(exeFd);
+        if (binaryEntry.lockFd >= 0) close(binaryEntry.lockFd);
+        if (steamEntry.lockFd >= 0) close(steamEntry.lockFd);
         
         delete[] args;
         
@@ -308,6 +598,3 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 }
-
-
-
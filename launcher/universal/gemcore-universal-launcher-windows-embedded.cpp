@@ -5,21 +5,14 @@
 
 #include <iostream>
 #include <string>
-#include <fstream>
 #include <cstdint>
 #include <windows.h>
 #include <shlobj.h>
+#include "gemcore-embedded-footer.h"
+#include "gemcore-config-record.h"
 
-struct EmbeddedData {
-    uint64_t x64Offset;
-    uint64_t x64Size;
-    uint64_t assetsOffset;
-    uint64_t assetsSize;
-    uint64_t configOffset;
-    uint64_t configSize;
-    uint64_t steamDllOffset;
-    uint64_t steamDllSize;
-};
+using gemcore::embedded::Footer;
+using gemcore::embedded::Section;
 
 std::string getExecutablePath() {
     char path[MAX_PATH];
@@ -54,68 +47,85 @@ std::string getCPUArchitecture() {
     }
 }
 
-bool readEmbeddedData(const std::string& exePath, EmbeddedData& data) {
-    std::ifstream file(exePath, std::ios::binary);
-    if (!file) return false;
-    
-    // Find magic signature "GEMCORE_EMBEDDED" from the end
-    file.seekg(-8192, std::ios::end); // Search last 8KB
-    char buffer[8192];
-    file.read(buffer, 8192);
-    
-    const char* magic = "GEMCORE_EMBEDDED";
-    size_t magicLen = 16; // Including null terminator
-    
-    // Find magic
-    bool found = false;
-    int64_t magicPos = -1;
-    for (int i = 0; i < 8192 - 16; i++) {
-        if (memcmp(buffer + i, magic, magicLen) == 0) {
-            found = true;
-            magicPos = file.tellg();
-            magicPos = magicPos - 8192 + i + magicLen;
-            break;
-        }
-    }
-    
-    if (!found) return false;
-    
-    // Read header
-    file.seekg(magicPos, std::ios::beg);
-    file.read((char*)&data.x64Offset, 8);
-    file.read((char*)&data.x64Size, 8);
-    file.read((char*)&data.assetsOffset, 8);
-    file.read((char*)&data.assetsSize, 8);
-    file.read((char*)&data.configOffset, 8);
-    file.read((char*)&data.configSize, 8);
-    file.read((char*)&data.steamDllOffset, 8);
-    file.read((char*)&data.steamDllSize, 8);
-    
-    return true;
+/**
+ * Positional read on the shared handle (no seek, no reopen)
+ */
+bool readAt(HANDLE file, uint64_t offset, void* buffer, DWORD size) {
+    OVERLAPPED ov = {};
+    ov.Offset = (DWORD)(offset & 0xFFFFFFFFu);
+    ov.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD read = 0;
+    return ReadFile(file, buffer, size, &read, &ov) && read == size;
 }
 
-bool extractFile(const std::string& exePath, uint64_t offset, uint64_t size, const std::string& outPath) {
-    std::ifstream in(exePath, std::ios::binary);
-    if (!in) return false;
+/**
+ * Read the fixed-size footer with a single read at the end of the file
+ */
+bool readFooter(HANDLE file, Footer& footer) {
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (uint64_t)fileSize.QuadPart < sizeof(Footer)) return false;
     
-    std::ofstream out(outPath, std::ios::binary);
-    if (!out) return false;
+    if (!readAt(file, (uint64_t)fileSize.QuadPart - sizeof(Footer), &footer, sizeof(Footer))) return false;
     
-    in.seekg(offset, std::ios::beg);
+    return gemcore::embedded::validateFooter(footer, (uint64_t)fileSize.QuadPart);
+}
+
+/**
+ * Steam App ID from the embedded launcher config record (0 if none)
+ */
+uint32_t readSteamAppId(HANDLE file, const Section& config) {
+    if (config.size == 0 || config.size > 64 * 1024) return 0;
+    std::string record((size_t)config.size, '\0');
+    if (!readAt(file, config.offset, &record[0], (DWORD)config.size)) return 0;
+    
+    gemcore::config::Record parsed;
+    if (!parsed.parse(reinterpret_cast<const unsigned char*>(record.data()), record.size())) return 0;
+    for (gemcore::config::Field field; parsed.next(field);) {
+        if (field.id == gemcore::config::STEAM_APP_ID) return field.u32();
+    }
+    return 0;
+}
+
+/**
+ * Closes the executable's handle on every return path
+ */
+struct FileHandle {
+    HANDLE handle;
+    
+    explicit FileHandle(HANDLE h) : handle(h) {}
+    ~FileHandle() { close(); }
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+    
+    void close() {
+        if (handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+        }
+    }
+};
+
+bool extractFile(HANDLE exeFile, const Section& section, const std::string& outPath) {
+    HANDLE out = CreateFileA(outPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (out == INVALID_HANDLE_VALUE) return false;
     
-    const size_t BUFFER_SIZE = 1024 * 1024; // 1MB buffer
+    const DWORD BUFFER_SIZE = 1024 * 1024; // 1MB buffer
     char* buffer = new char[BUFFER_SIZE];
     
-    uint64_t remaining = size;
-    while (remaining > 0) {
-        size_t toRead = (remaining < BUFFER_SIZE) ? (size_t)remaining : BUFFER_SIZE;
-        in.read(buffer, toRead);
-        out.write(buffer, toRead);
-        remaining -= toRead;
+    bool ok = true;
+    uint64_t done = 0;
+    while (ok && done < section.size) {
+        DWORD toRead = (section.size - done < BUFFER_SIZE) ? (DWORD)(section.size - done) : BUFFER_SIZE;
+        DWORD written = 0;
+        ok = readAt(exeFile, section.offset + done, buffer, toRead) &&
+             WriteFile(out, buffer, toRead, &written, NULL) && written == toRead;
+        done += toRead;
     }
     
     delete[] buffer;
-    return true;
+    CloseHandle(out);
+    return ok;
 }
 
 int main(int argc, char* argv[]) {
@@ -123,43 +133,57 @@ int main(int argc, char* argv[]) {
     std::string arch = getCPUArchitecture();
     std::string tempDir = getTempDir();
     
-    // Read embedded data
-    EmbeddedData data;
-    if (!readEmbeddedData(exePath, data)) {
+    // One handle for the footer and every section
+    FileHandle exe(CreateFileA(exePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL));
+    HANDLE exeFile = exe.handle;
+    if (exeFile == INVALID_HANDLE_VALUE) {
+        std::cerr << " Failed to open executable!" << std::endl;
+        return 1;
+    }
+    
+    Footer footer;
+    if (!readFooter(exeFile, footer)) {
         std::cerr << " Failed to read embedded data!" << std::endl;
         return 1;
     }
     
+    const Section& binary = footer.sections[gemcore::embedded::SECTION_BINARY];
+    const Section& assets = footer.sections[gemcore::embedded::SECTION_ASSETS];
+    const Section& config = footer.sections[gemcore::embedded::SECTION_CONFIG];
+    const Section& steamDll = footer.sections[gemcore::embedded::SECTION_STEAM_LIB];
+    
     // Extract files
     std::string x64Path = tempDir + "\\gemcore-x64.exe";
     std::string assetsPath = tempDir + "\\gemcore-assets";
-    std::string configPath = tempDir + "\\gemcore.config.json";
     std::string steamDllPath = tempDir + "\\steam_api64.dll";
     
-    if (data.x64Size > 0) {
-        if (!extractFile(exePath, data.x64Offset, data.x64Size, x64Path)) {
+    if (binary.size > 0) {
+        if (!extractFile(exeFile, binary, x64Path)) {
             std::cerr << " Failed to extract x64 binary!" << std::endl;
             return 1;
         }
     }
     
-    if (data.assetsSize > 0) {
-        if (!extractFile(exePath, data.assetsOffset, data.assetsSize, assetsPath)) {
+    if (assets.size > 0) {
+        if (!extractFile(exeFile, assets, assetsPath)) {
             std::cerr << " Failed to extract assets!" << std::endl;
             return 1;
         }
     }
     
-    if (data.configSize > 0) {
-        if (!extractFile(exePath, data.configOffset, data.configSize, configPath)) {
-            std::cerr << " Failed to extract config!" << std::endl;
-            return 1;
-        }
+    // Steam reads the App ID from the environment before steam_appid.txt;
+    // keep the value Steam itself set when launched from the client
+    uint32_t appId = readSteamAppId(exeFile, config);
+    if (appId != 0 && GetEnvironmentVariableA("SteamAppId", NULL, 0) == 0) {
+        std::string appIdStr = std::to_string(appId);
+        SetEnvironmentVariableA("SteamAppId", appIdStr.c_str());
+        SetEnvironmentVariableA("SteamGameId", appIdStr.c_str());
     }
     
     // Extract Steam DLL if embedded (MUST be in same directory as EXE!)
-    if (data.steamDllSize > 0) {
-        if (!extractFile(exePath, data.steamDllOffset, data.steamDllSize, steamDllPath)) {
+    if (steamDll.size > 0) {
+        if (!extractFile(exeFile, steamDll, steamDllPath)) {
             // Don't fail - app can run without Steam
         } else {
             // CRITICAL: Add TEMP directory to PATH environment variable
@@ -176,6 +200,9 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Not needed while the child runs
+    exe.close();
+    
     // Launch architecture-specific binary
     std::string binaryPath = tempDir + "\\gemcore-" + arch + ".exe";
     
@@ -222,6 +249,7 @@ int main(int argc, char* argv[]) {
         std::cerr << " Failed to launch " << arch << " binary" << std::endl;
         std::cerr << "Error code: " << GetLastError() << std::endl;
         delete[] widePath;
+        delete[] wideTempDir;
         return 1;
     }
     
@@ -239,7 +267,6 @@ int main(int argc, char* argv[]) {
     // Cleanup temp files (optional, Windows will cleanup temp dir eventually)
     DeleteFileA(x64Path.c_str());
     DeleteFileA(assetsPath.c_str());
-    DeleteFileA(configPath.c_str());
     RemoveDirectoryA(tempDir.c_str());
     
     return exitCode;
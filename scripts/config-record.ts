@@ -0,0 +1,105 @@
+//  Gemcore Config Record
+// Compiles gemcore.config.json into the binary record the launchers read
+// without a JSON parser (packed as the raw asset `.gemcore-config.bin`).
+// Layout must match launcher/shared/gemcore-config-record.h (little-endian):
+//   "GCFG", u16 version, u16 fieldCount,
+//   fieldCount x { u16 id, u16 size, payload }
+// Payloads: strings UTF-8, integers u32/i32, flags u8.
+
+export const CONFIG_RECORD_PATH = '.gemcore-config.bin';
+// Written next to the asset container; the single-exe packers embed it as the
+// footer's config section for the universal launcher (SteamAppId)
+export const LAUNCHER_RECORD_SUFFIX = '.launcher-config';
+const RECORD_MAGIC = 'GCFG';
+const RECORD_VERSION = 1;
+
+type FieldType = 'string' | 'int' | 'uint' | 'flag';
+
+// Field ids: never reuse or renumber (keep in sync with the C++ FieldId enum)
+const FIELDS: { id: number; type: FieldType; get: (config: any) => unknown; name: string }[] = [
+  { id: 1, type: 'string', name: 'window.title', get: (c) => c.window?.title },
+  { id: 2, type: 'int', name: 'window.width', get: (c) => c.window?.width },
+  { id: 3, type: 'int', name: 'window.height', get: (c) => c.window?.height },
+  // startFullscreen wins over fullscreen (same as the old runtime parser)
+  { id: 4, type: 'flag', name: 'window.fullscreen', get: (c) => c.window?.startFullscreen ?? c.window?.fullscreen },
+  { id: 5, type: 'flag', name: 'window.resizable', get: (c) => c.window?.resizable },
+  { id: 6, type: 'flag', name: 'window.alwaysOnTop', get: (c) => c.window?.alwaysOnTop },
+  { id: 7, type: 'flag', name: 'window.frameless', get: (c) => c.window?.frameless },
+  { id: 8, type: 'int', name: 'window.minWidth', get: (c) => c.window?.minWidth },
+  { id: 9, type: 'int', name: 'window.minHeight', get: (c) => c.window?.minHeight },
+
+  { id: 32, type: 'string', name: 'app.name', get: (c) => c.app?.name },
+  { id: 33, type: 'string', name: 'app.version', get: (c) => c.app?.version },
+  // Legacy root "entrypoint" wins over app.entrypoint
+  { id: 34, type: 'string', name: 'app.entrypoint', get: (c) => c.entrypoint ?? c.app?.entrypoint },
+  { id: 35, type: 'string', name: 'app.icon', get: (c) => c.app?.icon },
+  { id: 36, type: 'string', name: 'app.iconPng', get: (c) => c.app?.iconPng },
+  { id: 37, type: 'flag', name: 'app.debug', get: (c) => c.app?.debug },
+  { id: 38, type: 'flag', name: 'app.splash', get: (c) => c.app?.splash },
+
+  { id: 64, type: 'flag', name: 'steamworks.enabled', get: (c) => c.steamworks?.enabled },
+  { id: 65, type: 'uint', name: 'steamworks.appId', get: (c) => c.steamworks?.appId },
+  { id: 66, type: 'uint', name: 'steamworks.storeStatsDelayMs', get: (c) => c.steamworks?.storeStatsDelayMs },
+  { id: 67, type: 'uint', name: 'steamworks.leaderboardCacheMs', get: (c) => c.steamworks?.leaderboardCacheMs },
+];
+
+function encodeValue(type: FieldType, value: unknown): Buffer | null {
+  switch (type) {
+    case 'string':
+      return typeof value === 'string' ? Buffer.from(value, 'utf8') : null;
+    case 'flag':
+      return typeof value === 'boolean' ? Buffer.from([value ? 1 : 0]) : null;
+    case 'int':
+    case 'uint': {
+      // Fractions are truncated like nlohmann's get<int>() did
+      if (typeof value !== 'number' || !Number.isFinite(value)) return null;
+      const n = Math.trunc(value);
+      const [min, max] = type === 'int' ? [-0x80000000, 0x7fffffff] : [0, 0xffffffff];
+      if (n < min || n > max) return null;
+      const buf = Buffer.alloc(4);
+      if (type === 'int') buf.writeInt32LE(n, 0);
+      else buf.writeUInt32LE(n, 0);
+      return buf;
+    }
+  }
+}
+
+/**
+ * Build the record; fields with the wrong type are skipped with a warning
+ * (the launcher keeps its default for them)
+ */
+export function buildConfigRecord(config: any): Buffer {
+  const fields: Buffer[] = [];
+
+  for (const field of FIELDS) {
+    const value = field.get(config ?? {});
+    if (value === undefined || value === null) continue;
+
+    const payload = encodeValue(field.type, value);
+    if (!payload || payload.length > 0xffff) {
+      console.warn(`  Config: ignoring ${field.name} (expected ${field.type}, got ${JSON.stringify(value)})`);
+      continue;
+    }
+
+    const head = Buffer.alloc(4);
+    head.writeUInt16LE(field.id, 0);
+    head.writeUInt16LE(payload.length, 2);
+    fields.push(head, payload);
+  }
+
+  const header = Buffer.alloc(8);
+  header.write(RECORD_MAGIC, 0, 'latin1');
+  header.writeUInt16LE(RECORD_VERSION, 4);
+  header.writeUInt16LE(fields.length / 2, 6);
+  return Buffer.concat([header, ...fields]);
+}
+
+/**
+ * Record for the universal launcher: Steam fields only. It is stored
+ * unencrypted in the executable, so the rest of the config stays in the
+ * (encrypted) asset container.
+ */
+export function buildLauncherRecord(config: any): Buffer {
+  const steamworks = config?.steamworks;
+  return buildConfigRecord({ steamworks: { enabled: steamworks?.enabled, appId: steamworks?.appId } });
+}
@@ -3,20 +3,30 @@
 // Creates a single "gemcore-assets" file that can be shared across architectures
 //  With XOR Encryption for asset protection
 
-import { readdirSync, statSync, readFileSync, writeFileSync, existsSync } from 'fs';
+import { readdirSync, statSync, readFileSync, writeFileSync, existsSync, mkdtempSync, rmSync } from 'fs';
 import { join } from 'path';
+import { tmpdir } from 'os';
 import { createHash, randomBytes } from 'crypto';
+import { gzipSync } from 'zlib';
+import { buildConfigRecord, buildLauncherRecord, CONFIG_RECORD_PATH, LAUNCHER_RECORD_SUFFIX } from './config-record';
 
 const projectDir = process.argv[2];
 const outputPath = process.argv[3];
+const compress = !process.argv.includes('--no-compress');
+// Incremental: keep <output>.manifest and the key, repack only changed files (native packer)
+const incremental = process.argv.includes('--incremental') || process.env.GEMCORE_INCREMENTAL_ASSETS === '1';
 
 if (!projectDir || !outputPath) {
-  console.error('Usage: bun embed-assets-shared.ts <project_dir> <output_path>');
+  console.error('Usage: bun embed-assets-shared.ts <project_dir> <output_path> [--no-compress] [--incremental]');
   process.exit(1);
 }
 
 const srcDir = join(projectDir, 'src');
 
+// Access profile recorded with GEMCORE_RECORD_ACCESS=1 (native packer lays the container out in that order)
+const profilePath = process.env.GEMCORE_ACCESS_PROFILE || join(projectDir, 'gemcore-access-profile.txt');
+const hasProfile = existsSync(profilePath);
+
 console.log(' Gemcore Shared Assets Builder');
 console.log('');
 console.log(` Source: ${srcDir}`);
@@ -49,9 +59,16 @@ function xorEncrypt(data: Buffer, key: Buffer): Buffer {
   return encrypted;
 }
 
-// Collect all files
-function collectFiles(dir: string, baseDir: string = dir): Array<{ path: string; data: Buffer }> {
-  const files: Array<{ path: string; data: Buffer }> = [];
+// A file to pack: read from `source` (lazily) or generated in memory (`data`)
+interface PackFile {
+  path: string;
+  source?: string;
+  data?: Buffer;
+}
+
+// Collect all files (paths only - contents are read while packing)
+function collectFiles(dir: string, baseDir: string = dir): PackFile[] {
+  const files: PackFile[] = [];
   
   for (const entry of readdirSync(dir)) {
     const fullPath = join(dir, entry);
@@ -61,26 +78,24 @@ function collectFiles(dir: string, baseDir: string = dir): Array<{ path: string;
       files.push(...collectFiles(fullPath, baseDir));
     } else {
       const relativePath = fullPath.substring(baseDir.length + 1);
-      const data = readFileSync(fullPath);
-      files.push({ path: relativePath, data });
+      files.push({ path: relativePath, source: fullPath });
     }
   }
   
   return files;
 }
 
-const files = collectFiles(srcDir);
+const srcFiles = collectFiles(srcDir);
+const files: PackFile[] = [];
 
 //  Add WebGPU helper script (universal, framework-agnostic)
 const webgpuHelperPath = join(import.meta.dir, '..', 'launcher', 'assets', 'gemcore-webgpu-helper.js');
-const webgpuHelper = readFileSync(webgpuHelperPath);
-files.push({ path: 'gemcore-webgpu-helper.js', data: webgpuHelper });
+files.push({ path: 'gemcore-webgpu-helper.js', source: webgpuHelperPath });
 
 //  Add Steamworks wrapper script (if Steamworks is enabled)
 const steamworksWrapperPath = join(import.meta.dir, '..', 'launcher', 'steamworks', 'gemcore-steamworks-wrapper.js');
 if (existsSync(steamworksWrapperPath)) {
-  const steamworksWrapper = readFileSync(steamworksWrapperPath);
-  files.push({ path: 'gemcore-steamworks-wrapper.js', data: steamworksWrapper });
+  files.push({ path: 'gemcore-steamworks-wrapper.js', source: steamworksWrapperPath });
 }
 
 //  Embed gemcore.config.json (encrypted, not accessible to user)
@@ -90,7 +105,7 @@ let config: any = null;
 
 if (existsSync(configJsonPath)) {
   const configData = readFileSync(configJsonPath);
-  files.push({ path: '.gemcore-config.json', data: configData });
+  files.push({ path: '.gemcore-config.json', source: configJsonPath });
   config = JSON.parse(configData.toString());
   console.log(' Config embedded (JSON)');
 } else if (existsSync(configJsPath)) {
@@ -102,12 +117,26 @@ if (existsSync(configJsonPath)) {
   console.log(' Config embedded (from JS)');
 }
 
+//  Precompiled binary config: what the launchers actually read (no JSON parsing at startup)
+if (config) {
+  const record = buildConfigRecord(config);
+  files.push({ path: CONFIG_RECORD_PATH, data: record });
+  console.log(` Config record compiled (${record.length} bytes)`);
+}
+
+//  Steam fields for the universal launcher (pack-*-single-exe.ts embed this file)
+const launcherRecordPath = outputPath + LAUNCHER_RECORD_SUFFIX;
+if (config) {
+  writeFileSync(launcherRecordPath, buildLauncherRecord(config));
+} else {
+  rmSync(launcherRecordPath, { force: true });
+}
+
 //  Add splash.html from framework assets if splash is enabled
 if (config?.app?.splash === true) {
   const splashPath = join(import.meta.dir, '..', 'assets', 'splash.html');
   if (existsSync(splashPath)) {
-    const splashData = readFileSync(splashPath);
-    files.push({ path: 'splash.html', data: splashData });
+    files.push({ path: 'splash.html', source: splashPath });
     console.log(' Splash screen embedded (from framework assets)');
   } else {
     console.warn('  splash.html not found in framework assets!');
@@ -126,9 +155,8 @@ if (iconPath) {
   }
   
   if (existsSync(iconFullPath)) {
-    const iconData = readFileSync(iconFullPath);
     // Always embed as 'icon.png' for consistency across platforms
-    files.push({ path: 'icon.png', data: iconData });
+    files.push({ path: 'icon.png', source: iconFullPath });
     console.log(` Icon embedded: ${iconPath}  icon.png`);
   } else {
     console.warn(`  Icon not found: ${iconPath}`);
@@ -137,69 +165,192 @@ if (iconPath) {
   console.warn('  No icon specified in config');
 }
 
-console.log(` Collected ${files.length} files (+ WebGPU helper + config + icon)`);
+console.log(` Collected ${srcFiles.length} files (+ WebGPU helper + config + icon)`);
 console.log('');
 
-// Build binary format:
-// [8 bytes: Magic header "GEMCORE1\0"]
+//  Native packer (launcher/tools/gemcore-pack.cpp): streaming, parallel, SIMD XOR.
+// Set GEMCORE_PACK to its path, or build the gemcore-pack target in launcher/build.
+function findPackTool(): string | null {
+  const candidates = [
+    process.env.GEMCORE_PACK,
+    join(import.meta.dir, '..', 'launcher', 'build', 'gemcore-pack'),
+  ];
+  return candidates.find((candidate) => candidate && existsSync(candidate)) || null;
+}
+
+const packTool = process.platform === 'win32' ? null : findPackTool();
+if (packTool) {
+  console.log(` Using native packer: ${packTool}`);
+  
+  // Generated files (e.g. config converted from JS) go through a temp dir
+  const tempDir = mkdtempSync(join(tmpdir(), 'gemcore-pack-'));
+  // Incremental runs keep the key stored in the manifest (a new key invalidates every blob)
+  const args = incremental
+    ? [packTool, '--incremental', outputPath, srcDir]
+    : [packTool, '--key', encryptionKey.toString('hex'), outputPath, srcDir];
+  if (!compress) args.push('--no-compress');
+  if (incremental) console.log(` Incremental: reusing unchanged assets via ${outputPath}.manifest`);
+  if (hasProfile) {
+    args.push('--profile', profilePath);
+    console.log(` Access profile: ${profilePath}`);
+  }
+  
+  files.forEach((file, i) => {
+    let source = file.source;
+    if (!source) {
+      source = join(tempDir, `${i}`);
+      writeFileSync(source, file.data!);
+    }
+    args.push('--add', `${file.path}=${source}`);
+  });
+  
+  const result = Bun.spawnSync(args, { stdout: 'inherit', stderr: 'inherit' });
+  rmSync(tempDir, { recursive: true, force: true });
+  
+  if (result.exitCode !== 0) {
+    console.error(' gemcore-pack failed');
+    process.exit(1);
+  }
+  
+  console.log('');
+  console.log(' Shared assets file created!');
+  console.log(' All assets encrypted with XOR + multi-key rotation');
+  console.log('');
+  process.exit(0);
+}
+
+// Fallback: pack in JS (reads every file into memory, GEMCORE2: no integrity hashes)
+if (incremental) {
+  console.warn('  Incremental packing needs the native gemcore-pack tool, doing a full pack');
+}
+if (hasProfile) {
+  console.warn('  Access-ordered layout needs the native gemcore-pack tool, ignoring the profile');
+}
+const loaded = [...srcFiles, ...files].map((file) => ({
+  path: file.path,
+  data: file.data ?? readFileSync(file.source!),
+}));
+
+//  Per-asset compression (codec chosen by file type)
+// Already-compressed formats (png/jpg/ogg/mp4/woff2/...) are stored raw.
+const CODEC_RAW = 0;
+const CODEC_GZIP = 1;
+const COMPRESSIBLE = new Set([
+  '.html', '.htm', '.js', '.mjs', '.css', '.json', '.map', '.svg', '.xml', '.txt',
+  '.csv', '.wasm', '.ttf', '.otf', '.wav', '.glsl', '.wgsl', '.gltf', '.obj', '.md'
+]);
+
+function chooseCodec(path: string, data: Buffer): { codec: number; stored: Buffer } {
+  const dot = path.lastIndexOf('.');
+  const ext = dot >= 0 ? path.substring(dot).toLowerCase() : '';
+  if (compress && data.length >= 512 && COMPRESSIBLE.has(ext)) {
+    const gz = gzipSync(data, { level: 9 });
+    // Keep it only if it saves at least 10%
+    if (gz.length < data.length * 0.9) {
+      return { codec: CODEC_GZIP, stored: gz };
+    }
+  }
+  return { codec: CODEC_RAW, stored: data };
+}
+
+// Build binary format (GEMCORE2):
+// [9 bytes: Magic header "GEMCORE2\0"]
 // [32 bytes: Encryption key]
 // [uint32: file count]
-// For each file:
+// TOC, for each file:
 //   [uint32: filename length]
 //   [bytes: filename]
-//   [uint64: file size]
-//   [bytes: ENCRYPTED file data] 
+//   [uint8: codec (0 = raw, 1 = gzip)]
+//   [uint64: data offset from start of file]
+//   [uint64: stored size]
+//   [uint64: uncompressed size]
+// Data: ENCRYPTED (stored) file data at the offsets above
 //
 
 const buffers: Buffer[] = [];
 
 // Magic header (identifies encrypted gemcore-assets)
-const magicHeader = Buffer.from('GEMCORE1\0', 'utf8');
+const magicHeader = Buffer.from('GEMCORE2\0', 'utf8');
 buffers.push(magicHeader);
 
 // Encryption key (needed for decryption)
 buffers.push(encryptionKey);
 
-let totalSize = magicHeader.length + encryptionKey.length;
-
 // File count
 const fileCountBuf = Buffer.alloc(4);
-fileCountBuf.writeUInt32LE(files.length, 0);
+fileCountBuf.writeUInt32LE(loaded.length, 0);
 buffers.push(fileCountBuf);
-totalSize += 4;
-
-for (const file of files) {
-  // Filename length
-  const nameBuf = Buffer.from(file.path, 'utf8');
-  const nameLenBuf = Buffer.alloc(4);
-  nameLenBuf.writeUInt32LE(nameBuf.length, 0);
-  buffers.push(nameLenBuf);
-  totalSize += 4;
+
+//  Byte-identical files are stored once: duplicates become aliases (same offset)
+const firstCopy = new Map<string, Buffer>();
+const stored = loaded.map((file) => {
+  const digest = createHash('sha256').update(file.data).digest('hex');
+  const original = firstCopy.get(digest);
+  const alias = original !== undefined && original.equals(file.data) ? original : null;
+  if (!alias) firstCopy.set(digest, file.data);
+  return {
+    ...file,
+    nameBuf: Buffer.from(file.path, 'utf8'),
+    digest,
+    alias: alias !== null,
+    ...(alias ? { codec: CODEC_RAW, stored: file.data } : chooseCodec(file.path, file.data)),
+  };
+});
+
+// Data starts right after the TOC
+let dataOffset = magicHeader.length + encryptionKey.length + 4;
+for (const file of stored) {
+  dataOffset += 4 + file.nameBuf.length + 1 + 8 + 8 + 8;
+}
+
+let rawTotal = 0;
+let savedTotal = 0;
+const blobs = new Map<string, { offset: number; codec: number; size: number }>();
+for (const file of stored) {
+  let blob = file.alias ? blobs.get(file.digest)! : undefined;
+  if (!blob) {
+    blob = { offset: dataOffset, codec: file.codec, size: file.stored.length };
+    blobs.set(file.digest, blob);
+    dataOffset += file.stored.length;
+  } else {
+    savedTotal += blob.size;
+  }
   
-  // Filename
-  buffers.push(nameBuf);
-  totalSize += nameBuf.length;
+  const entry = Buffer.alloc(4 + file.nameBuf.length + 1 + 8 + 8 + 8);
+  let pos = entry.writeUInt32LE(file.nameBuf.length, 0);
+  pos += file.nameBuf.copy(entry, pos);
+  pos = entry.writeUInt8(blob.codec, pos);
+  pos = entry.writeBigUInt64LE(BigInt(blob.offset), pos);
+  pos = entry.writeBigUInt64LE(BigInt(blob.size), pos);
+  entry.writeBigUInt64LE(BigInt(file.data.length), pos);
+  buffers.push(entry);
   
-  // File size (uint64 - use BigInt)
-  const sizeBuf = Buffer.alloc(8);
-  sizeBuf.writeBigUInt64LE(BigInt(file.data.length), 0);
-  buffers.push(sizeBuf);
-  totalSize += 8;
+  rawTotal += file.data.length;
+}
+
+for (const file of stored) {
+  if (file.alias) {
+    console.log(`   ${file.path.padEnd(40)} (duplicate, stored once)`);
+    continue;
+  }
   
   //  Encrypt file data before storing!
-  const encryptedData = xorEncrypt(file.data, encryptionKey);
-  buffers.push(encryptedData);
-  totalSize += encryptedData.length;
+  buffers.push(xorEncrypt(file.stored, encryptionKey));
   
-  console.log(`   ${file.path.padEnd(40)} ${(file.data.length / 1024).toFixed(1)} KB `);
+  const codecNote = file.codec === CODEC_GZIP ? ` -> ${(file.stored.length / 1024).toFixed(1)} KB gzip` : '';
+  console.log(`   ${file.path.padEnd(40)} ${(file.data.length / 1024).toFixed(1)} KB${codecNote}`);
 }
 
+const totalSize = dataOffset;
 const finalBuffer = Buffer.concat(buffers);
 writeFileSync(outputPath, finalBuffer);
 
 console.log('');
 console.log(' Shared assets file created!');
-console.log(` Total size: ${(totalSize / 1024 / 1024).toFixed(2)} MB`);
+console.log(` Total size: ${(totalSize / 1024 / 1024).toFixed(2)} MB (uncompressed assets: ${(rawTotal / 1024 / 1024).toFixed(2)} MB)`);
+if (savedTotal > 0) {
+  console.log(` Deduplicated: ${(savedTotal / 1024 / 1024).toFixed(2)} MB saved`);
+}
 console.log(' All assets encrypted with XOR + multi-key rotation');
 console.log(` Encryption key embedded in file (32 bytes)`);
 console.log('');
@@ -0,0 +1,74 @@
+//  Gemcore Embedded Footer
+// Fixed-size footer appended to single-file executables (read by the universal
+// launchers with ONE read at fileSize - FOOTER_SIZE).
+// Layout must match launcher/shared/gemcore-embedded-footer.h (little-endian):
+//   0   u32 version
+//   4   u32 footerSize (128)
+//   8   4 x { u64 offset, u64 size, u64 fnv1a64 }  binary, assets, config, steam lib
+//   104 u32 flags (reserved)
+//   108 u32 checksum (FNV-1a 32 of bytes 0..107)
+//   112 "GEMCORE_EMBEDDED" (16 bytes)
+
+export const FOOTER_VERSION = 2;
+export const FOOTER_SIZE = 128;
+const FOOTER_MAGIC = 'GEMCORE_EMBEDDED';
+
+export interface EmbeddedSection {
+  offset: bigint;
+  size: bigint;
+  hash: bigint;
+}
+
+export const emptySection = (): EmbeddedSection => ({ offset: 0n, size: 0n, hash: 0n });
+
+// FNV-1a 64 on two 32-bit halves (BigInt per byte is far too slow for 100 MB)
+export function fnv1a64(data: Uint8Array): bigint {
+  let hi = 0xcbf29ce4;
+  let lo = 0x84222325;
+  for (let i = 0; i < data.length; i++) {
+    lo = (lo ^ data[i]) >>> 0;
+    // h * 0x100000001b3 = h * 0x1b3 + (h << 40)
+    const low = lo * 0x1b3;
+    const carry = Math.floor(low / 0x100000000);
+    hi = (Math.imul(hi, 0x1b3) + carry + (lo << 8)) >>> 0;
+    lo = low >>> 0;
+  }
+  return (BigInt(hi) << 32n) | BigInt(lo);
+}
+
+export function sectionOf(data: Uint8Array, offset: bigint): EmbeddedSection {
+  return data.length > 0
+    ? { offset, size: BigInt(data.length), hash: fnv1a64(data) }
+    : emptySection();
+}
+
+function fnv1a32(data: Uint8Array): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < data.length; i++) {
+    hash = Math.imul(hash ^ data[i], 0x01000193) >>> 0;
+  }
+  return hash;
+}
+
+export function buildFooter(
+  binary: EmbeddedSection,
+  assets: EmbeddedSection,
+  config: EmbeddedSection,
+  steamLib: EmbeddedSection
+): Buffer {
+  const footer = Buffer.alloc(FOOTER_SIZE);
+  footer.writeUInt32LE(FOOTER_VERSION, 0);
+  footer.writeUInt32LE(FOOTER_SIZE, 4);
+
+  [binary, assets, config, steamLib].forEach((section, i) => {
+    const base = 8 + i * 24;
+    footer.writeBigUInt64LE(section.offset, base);
+    footer.writeBigUInt64LE(section.size, base + 8);
+    footer.writeBigUInt64LE(section.hash, base + 16);
+  });
+
+  footer.writeUInt32LE(0, 104);
+  footer.writeUInt32LE(fnv1a32(footer.subarray(0, 108)), 108);
+  footer.write(FOOTER_MAGIC, 112, 'latin1');
+  return footer;
+}
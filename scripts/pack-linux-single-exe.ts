@@ -4,18 +4,9 @@
  * Embeds launcher + assets + config + Steam .so into a single executable
  */
 
-import { readFileSync, writeFileSync } from 'fs';
-
-interface PackedData {
-  x64Offset: bigint;
-  x64Size: bigint;
-  assetsOffset: bigint;
-  assetsSize: bigint;
-  configOffset: bigint;
-  configSize: bigint;
-  steamSoOffset: bigint;
-  steamSoSize: bigint;
-}
+import { readFileSync, writeFileSync, existsSync } from 'fs';
+import { buildFooter, sectionOf, FOOTER_SIZE } from './embedded-footer';
+import { LAUNCHER_RECORD_SUFFIX } from './config-record';
 
 async function packSingleExecutable(
   universalLauncher: string,
@@ -56,8 +47,16 @@ async function packSingleExecutable(
     }
   }
   
-  // Config is embedded in assets, so we don't need it separately
-  const config = Buffer.alloc(0);
+  // Steam fields for the universal launcher (SteamAppId), written next to the
+  // assets by embed-assets-shared.ts; the full config stays in the assets
+  let config = Buffer.alloc(0);
+  const configPath = assetsPath + LAUNCHER_RECORD_SUFFIX;
+  if (assets.length > 0 && existsSync(configPath)) {
+    config = readFileSync(configPath);
+    console.log(` Launcher config: ${config.length} bytes`);
+  } else if (assets.length > 0) {
+    console.warn(`  ${configPath} not found: the launcher will not set SteamAppId`);
+  }
   
   // Read Steam .so if provided (skip if empty string)
   let steamSo = Buffer.alloc(0);
@@ -85,92 +84,55 @@ async function packSingleExecutable(
   
   currentOffset = align(currentOffset);
   
-  const data: PackedData = {
-    x64Offset: currentOffset,
-    x64Size: BigInt(x64.length),
-    assetsOffset: 0n,
-    assetsSize: 0n,
-    configOffset: 0n,
-    configSize: 0n,
-    steamSoOffset: 0n,
-    steamSoSize: 0n
-  };
-  
+  const binarySection = sectionOf(x64, currentOffset);
   currentOffset += BigInt(x64.length);
   currentOffset = align(currentOffset);
   
   // Add assets if present
+  const assetsSection = sectionOf(assets, currentOffset);
   if (assets.length > 0) {
-    data.assetsOffset = currentOffset;
-    data.assetsSize = BigInt(assets.length);
     currentOffset += BigInt(assets.length);
     currentOffset = align(currentOffset);
   }
   
+  // Add launcher config if present
+  const configSection = sectionOf(config, currentOffset);
+  if (config.length > 0) {
+    currentOffset += BigInt(config.length);
+    currentOffset = align(currentOffset);
+  }
+  
   // Add Steam .so if present
+  const steamSection = sectionOf(steamSo, currentOffset);
   if (steamSo.length > 0) {
-    data.steamSoOffset = currentOffset;
-    data.steamSoSize = BigInt(steamSo.length);
     currentOffset += BigInt(steamSo.length);
     currentOffset = align(currentOffset);
   }
   
-  // Create header (64 bytes total)
-  // Magic: "GEMCORE_EMBEDDED\0" (16 bytes)
-  // x64Offset: 8 bytes
-  // x64Size: 8 bytes
-  // assetsOffset: 8 bytes
-  // assetsSize: 8 bytes
-  // configOffset: 8 bytes
-  // configSize: 8 bytes
-  // steamSoOffset: 8 bytes
-  // steamSoSize: 8 bytes
-  const header = Buffer.alloc(64);
-  header.write('GEMCORE_EMBEDDED', 0, 'utf-8');
-  header.writeBigUInt64LE(data.x64Offset, 16);
-  header.writeBigUInt64LE(data.x64Size, 24);
-  header.writeBigUInt64LE(data.assetsOffset, 32);
-  header.writeBigUInt64LE(data.assetsSize, 40);
-  header.writeBigUInt64LE(data.configOffset, 48);
-  header.writeBigUInt64LE(data.configSize, 56);
-  header.writeBigUInt64LE(data.steamSoOffset, 64 - 16);
-  header.writeBigUInt64LE(data.steamSoSize, 64 - 8);
-  
-  // Calculate padding
-  const padding1 = Buffer.alloc(Number(data.x64Offset - BigInt(launcher.length)));
-  const padding2 = assets.length > 0
-    ? Buffer.alloc(Number(data.assetsOffset - (data.x64Offset + data.x64Size)))
-    : Buffer.alloc(0);
-  const padding3 = steamSo.length > 0 
-    ? Buffer.alloc(Number(data.steamSoOffset - (data.assetsOffset + data.assetsSize)))
-    : Buffer.alloc(0);
-  
-  // Concatenate all parts
-  const output = Buffer.concat([
-    launcher,
-    padding1,
-    x64,
-    padding2,
-    assets,
-    padding3,
-    steamSo,
-    header
-  ]);
+  // Fixed-size footer at the very end (see embedded-footer.ts)
+  const footer = buildFooter(binarySection, assetsSection, configSection, steamSection);
+  
+  // Concatenate all parts, zero-padded up to each section's aligned offset
+  const parts: Buffer[] = [launcher];
+  let written = BigInt(launcher.length);
+  const sections: [typeof binarySection, Buffer][] = [
+    [binarySection, x64], [assetsSection, assets], [configSection, config], [steamSection, steamSo]
+  ];
+  for (const [section, data] of sections) {
+    if (data.length === 0) continue;
+    parts.push(Buffer.alloc(Number(section.offset - written)), data);
+    written = section.offset + section.size;
+  }
+  parts.push(footer);
+  const output = Buffer.concat(parts);
+  const binaryEnd = binarySection.offset + binarySection.size;
+  const assetsEnd = assetsSection.offset + assetsSection.size;
   
   // Write output
   writeFileSync(outputPath, output, { mode: 0o755 });
   
-  //  Strip debug symbols to reduce size
-  console.log(' Stripping debug symbols...');
-  try {
-    Bun.spawnSync(['strip', '--strip-all', outputPath], {
-      stdout: 'pipe',
-      stderr: 'pipe',
-    });
-    console.log(' Debug symbols stripped');
-  } catch (e) {
-    console.warn('  Failed to strip (strip command not found)');
-  }
+  // No strip here: strip rewrites the ELF and drops the appended sections.
+  // The footer must stay the last bytes of the file (launcher is stripped above).
   
   const finalStats = await Bun.file(outputPath).stat();
   
@@ -181,14 +143,17 @@ async function packSingleExecutable(
   console.log('');
   console.log(' Structure:');
   console.log(`    Universal Launcher: 0 - ${launcher.length}`);
-  console.log(`    x64 Binary: ${data.x64Offset} - ${data.x64Offset + data.x64Size}`);
+  console.log(`    x64 Binary: ${binarySection.offset} - ${binaryEnd}`);
   if (assets.length > 0) {
-    console.log(`    Assets: ${data.assetsOffset} - ${data.assetsOffset + data.assetsSize}`);
+    console.log(`    Assets: ${assetsSection.offset} - ${assetsEnd}`);
+  }
+  if (config.length > 0) {
+    console.log(`    Launcher Config: ${configSection.offset} - ${configSection.offset + configSection.size}`);
   }
   if (steamSo.length > 0) {
-    console.log(`    Steam Library: ${data.steamSoOffset} - ${data.steamSoOffset + data.steamSoSize}`);
+    console.log(`    Steam Library: ${steamSection.offset} - ${steamSection.offset + steamSection.size}`);
   }
-  console.log(`    Header: ${output.length - 64} - ${output.length}`);
+  console.log(`    Footer: ${output.length - FOOTER_SIZE} - ${output.length}`);
   console.log('');
 }
 
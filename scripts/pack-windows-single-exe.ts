@@ -1,19 +1,10 @@
 #!/usr/bin/env bun
 // Pack Windows Universal Binary into SINGLE EXE
 
-import { readFileSync, writeFileSync, statSync } from 'fs';
+import { readFileSync, writeFileSync, statSync, existsSync } from 'fs';
 import { join, dirname } from 'path';
-
-interface PackedData {
-  x64Offset: bigint;
-  x64Size: bigint;
-  assetsOffset: bigint;
-  assetsSize: bigint;
-  configOffset: bigint;
-  configSize: bigint;
-  steamDllOffset: bigint;
-  steamDllSize: bigint;
-}
+import { buildFooter, emptySection, sectionOf, FOOTER_SIZE } from './embedded-footer';
+import { LAUNCHER_RECORD_SUFFIX } from './config-record';
 
 function packSingleEXE(
   launcherPath: string,
@@ -37,6 +28,16 @@ function packSingleEXE(
   const assets = readFileSync(assetsPath);
   console.log(` Assets: ${(assets.length / 1024 / 1024).toFixed(1)}MB`);
   
+  // Steam fields for the universal launcher (SteamAppId), written next to the
+  // assets by embed-assets-shared.ts; the full config stays in the assets
+  let config: Buffer | null = null;
+  if (existsSync(assetsPath + LAUNCHER_RECORD_SUFFIX)) {
+    config = readFileSync(assetsPath + LAUNCHER_RECORD_SUFFIX);
+    console.log(` Launcher config: ${config.length} bytes`);
+  } else {
+    console.warn(`  ${assetsPath}${LAUNCHER_RECORD_SUFFIX} not found: the launcher will not set SteamAppId`);
+  }
+  
   // Read Steam DLL if provided
   let steamDll: Buffer | null = null;
   if (steamDllPath) {
@@ -69,6 +70,18 @@ function packSingleEXE(
     currentOffset += 8n - (currentOffset % 8n);
   }
 
+  // Launcher config offset/size
+  const configOffset = config ? currentOffset : 0n;
+  const configSize = config ? BigInt(config.length) : 0n;
+  if (config) {
+    currentOffset += configSize;
+    
+    // Align to 8 bytes
+    if (currentOffset % 8n !== 0n) {
+      currentOffset += 8n - (currentOffset % 8n);
+    }
+  }
+
   // Steam DLL offset/size
   const steamDllOffset = steamDll ? currentOffset : 0n;
   const steamDllSize = steamDll ? BigInt(steamDll.length) : 0n;
@@ -81,33 +94,34 @@ function packSingleEXE(
     }
   }
 
-  // Create header
-  const magic = Buffer.from('GEMCORE_EMBEDDED\0', 'utf8');
-  const header = Buffer.alloc(64); // Increased from 48 to 64 for Steam DLL
-  
-  header.writeBigUInt64LE(x64Offset, 0);
-  header.writeBigUInt64LE(x64Size, 8);
-  header.writeBigUInt64LE(assetsOffset, 16);
-  header.writeBigUInt64LE(assetsSize, 24);
-  header.writeBigUInt64LE(0n, 32); // configOffset
-  header.writeBigUInt64LE(0n, 40); // configSize
-  header.writeBigUInt64LE(steamDllOffset, 48);
-  header.writeBigUInt64LE(steamDllSize, 56);
+  // Fixed-size footer at the very end (see embedded-footer.ts)
+  const footer = buildFooter(
+    sectionOf(x64Binary, x64Offset),
+    sectionOf(assets, assetsOffset),
+    config ? sectionOf(config, configOffset) : emptySection(),
+    steamDll ? sectionOf(steamDll, steamDllOffset) : emptySection()
+  );
 
   console.log('');
   console.log(' Structure:');
   console.log(`   Launcher:   0 - ${launcher.length} (${(launcher.length / 1024).toFixed(1)}KB)`);
   console.log(`   x64 Binary: ${x64Offset} - ${x64Offset + x64Size} (${(Number(x64Size) / 1024 / 1024).toFixed(1)}MB)`);
   console.log(`   Assets:     ${assetsOffset} - ${assetsOffset + assetsSize} (${(Number(assetsSize) / 1024 / 1024).toFixed(1)}MB)`);
+  if (config) {
+    console.log(`   Config:     ${configOffset} - ${configOffset + configSize} (${configSize} bytes)`);
+  }
   if (steamDll) {
     console.log(`   Steam DLL:  ${steamDllOffset} - ${steamDllOffset + steamDllSize} (${(Number(steamDllSize) / 1024).toFixed(1)}KB)`);
   }
-  console.log(`   Header:     ${currentOffset} (64 bytes)`);
+  console.log(`   Footer:     ${currentOffset} (${FOOTER_SIZE} bytes)`);
 
   // Calculate padding
+  const assetsEnd = assetsOffset + assetsSize;
+  const configEnd = configOffset + configSize;
   const padding1 = Number(assetsOffset - x64Offset - x64Size);
-  const padding2 = steamDll ? Number(steamDllOffset - assetsOffset - assetsSize) : Number(currentOffset - assetsOffset - assetsSize);
-  const padding3 = steamDll ? Number(currentOffset - steamDllOffset - steamDllSize) : 0;
+  const padding2 = Number((config ? configOffset : steamDll ? steamDllOffset : currentOffset) - assetsEnd);
+  const padding3 = config ? Number((steamDll ? steamDllOffset : currentOffset) - configEnd) : 0;
+  const padding4 = steamDll ? Number(currentOffset - steamDllOffset - steamDllSize) : 0;
 
   // Write output
   const parts = [
@@ -118,13 +132,17 @@ function packSingleEXE(
     Buffer.alloc(padding2), // Padding after assets
   ];
   
+  if (config) {
+    parts.push(config);
+    parts.push(Buffer.alloc(padding3)); // Padding after config
+  }
+  
   if (steamDll) {
     parts.push(steamDll);
-    parts.push(Buffer.alloc(padding3)); // Padding after Steam DLL
+    parts.push(Buffer.alloc(padding4)); // Padding after Steam DLL
   }
   
-  parts.push(magic);
-  parts.push(header);
+  parts.push(footer);
   
   const output = Buffer.concat(parts);
 